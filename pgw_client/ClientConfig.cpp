@@ -27,6 +27,7 @@ bool ClientConfig::loadConfig() {
         parseJsonValue("log_file", content, _config.log_file);
         parseJsonValue("log_level", content, _config.log_level);
         parseJsonUint32("receive_timeout_ms", content, _config.receive_timeout_ms);
+        parseJsonUint32("pipeline_window", content, _config.pipeline_window);
 
         _isValid = validateConfig();
         
@@ -128,6 +129,7 @@ void ClientConfig::setDefaults() {
     _config.log_file = "client.log";
     _config.log_level = "INFO";
     _config.receive_timeout_ms = 5000;
+    _config.pipeline_window = 64;
 }
 
 bool ClientConfig::validateConfig() {
@@ -159,5 +161,11 @@ bool ClientConfig::validateConfig() {
         return false;
     }
     
+    // Проверяем окно конвейера
+    if (_config.pipeline_window == 0) {
+        _lastError = "Pipeline window cannot be 0";
+        return false;
+    }
+    
     return true;
 } 
\ No newline at end of file
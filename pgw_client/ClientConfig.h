@@ -12,6 +12,7 @@ struct ClientConfiguration {
     std::string log_file = "client.log";         // Путь к файлу логов
     std::string log_level = "INFO";              // Уровень логирования
     uint32_t receive_timeout_ms = 5000;          // Таймаут ожидания ответа в миллисекундах
+    uint32_t pipeline_window = 64;               // Максимум запросов без ответа при конвейерной отправке
 };
 
 /**
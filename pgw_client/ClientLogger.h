@@ -50,6 +50,17 @@ public:
      */
     void setLogLevel(ClientLogLevel level);
     
+    /**
+     * @brief Проверяет, будет ли записано сообщение указанного уровня
+     *
+     * Позволяет не формировать строку сообщения, если уровень отключен.
+     * @param level Уровень логирования
+     * @return true если сообщение будет записано
+     */
+    [[nodiscard]] bool isEnabled(ClientLogLevel level) const noexcept {
+        return _isHealthy && _logger && level >= _logLevel;
+    }
+    
     /**
      * @brief Логирует сообщение с уровнем DEBUG
      * @param message Сообщение для логирования
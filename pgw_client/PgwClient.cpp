@@ -8,11 +8,15 @@
 #include <iostream>
 #include <poll.h>
 #include <algorithm>
+#include <cerrno>
+#include <deque>
+#include <unordered_map>
 
-PgwClient::PgwClient(const std::string& configPath)
+PgwClient::PgwClient(const std::string& configPath, uint32_t initialSequence)
     : _config(std::make_unique<ClientConfig>(configPath)),
       _logger(std::make_unique<ClientLogger>()),
-      _socket(-1) {
+      _socket(-1),
+      _nextSequence(initialSequence & SEQUENCE_MASK) {
 }
 
 PgwClient::~PgwClient() {
@@ -81,6 +85,170 @@ std::pair<bool, std::string> PgwClient::sendRequest(const std::string& imsi) {
     return {true, response};
 }
 
+std::vector<PipelinedResponse> PgwClient::sendPipelined(const std::vector<std::string>& imsis, size_t window,
+                                                        std::chrono::milliseconds timeout) {
+    using Clock = std::chrono::steady_clock;
+    
+    std::vector<PipelinedResponse> results(imsis.size());
+    if (_socket < 0) {
+        _logger->error("Socket not initialized");
+        for (auto& result : results) {
+            result.response = "Socket not initialized";
+        }
+        return results;
+    }
+    
+    // Номер запроса занимает 24 бита, окно не может быть больше пространства номеров
+    window = std::clamp<size_t>(window, 1, SEQUENCE_MASK);
+    _logger->info("Sending " + std::to_string(imsis.size()) + " pipelined request(s), window " +
+                  std::to_string(window) + ", timeout " + std::to_string(timeout.count()) + "ms");
+    
+    struct InFlight {
+        size_t index;               // Номер запроса в imsis
+        Clock::time_point sentAt;   // Время отправки
+    };
+    std::unordered_map<uint32_t, InFlight> inFlight;
+    inFlight.reserve(window);
+    
+    // Таймаут у всех запросов одинаковый, поэтому сроки ответов упорядочены по времени отправки
+    std::deque<std::pair<Clock::time_point, uint32_t>> deadlines;
+    
+    size_t next = 0;
+    size_t answered = 0;
+    size_t timedOut = 0;
+    char buffer[MAX_RESPONSE_SIZE];
+    
+    while (next < imsis.size() || !inFlight.empty()) {
+        // Дозаполняем окно новыми запросами
+        while (next < imsis.size() && inFlight.size() < window) {
+            size_t index = next++;
+            uint32_t sequence = _nextSequence;
+            _nextSequence = (_nextSequence + 1) & SEQUENCE_MASK;
+            
+            auto [encodeSuccess, packet] = encodeImsiToBcd(imsis[index], sequence);
+            if (!encodeSuccess) {
+                results[index].response = "Invalid IMSI format";
+                continue;
+            }
+            if (!sendUdpPacket(packet)) {
+                results[index].response = "Failed to send UDP packet";
+                continue;
+            }
+            
+            auto sentAt = Clock::now();
+            inFlight[sequence] = {index, sentAt};
+            deadlines.emplace_back(sentAt + timeout, sequence);
+        }
+        
+        // Завершаем запросы, не дождавшиеся ответа
+        auto now = Clock::now();
+        while (!deadlines.empty() && deadlines.front().first <= now) {
+            auto it = inFlight.find(deadlines.front().second);
+            if (it != inFlight.end()) {
+                results[it->second.index].response = "Timeout";
+                inFlight.erase(it);
+                ++timedOut;
+            }
+            deadlines.pop_front();
+        }
+        if (inFlight.empty()) {
+            continue;
+        }
+        
+        // Ждем ответов не дольше срока самого раннего запроса
+        auto wait = std::chrono::ceil<std::chrono::milliseconds>(deadlines.front().first - now);
+        struct pollfd fds[1];
+        fds[0].fd = _socket;
+        fds[0].events = POLLIN;
+        
+        int pollResult = poll(fds, 1, static_cast<int>(wait.count()));
+        if (pollResult < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            _logger->error("Poll error: " + std::string(strerror(errno)));
+            for (const auto& [sequence, request] : inFlight) {
+                results[request.index].response = "Poll error";
+            }
+            for (; next < imsis.size(); ++next) {
+                results[next].response = "Poll error";
+            }
+            inFlight.clear();
+            break;
+        }
+        if (pollResult == 0) {
+            continue;
+        }
+        
+        // Вычитываем все пришедшие ответы и сопоставляем их с запросами по номеру
+        while (true) {
+            ssize_t bytesRead = recv(_socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+            if (bytesRead < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // EAGAIN - очередь сокета пуста, прочие ошибки разбираются следующим poll
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    _logger->warn("Failed to receive response: " + std::string(strerror(errno)));
+                }
+                break;
+            }
+            
+            if (bytesRead < static_cast<ssize_t>(HEADER_SIZE) ||
+                static_cast<uint8_t>(buffer[0]) != HEADER_VERSION_CORRELATED) {
+                if (_logger->isEnabled(ClientLogLevel::DEBUG)) {
+                    _logger->debug("Ignoring response without request number");
+                }
+                continue;
+            }
+            
+            uint32_t sequence = (static_cast<uint32_t>(static_cast<uint8_t>(buffer[1])) << 16) |
+                                (static_cast<uint32_t>(static_cast<uint8_t>(buffer[2])) << 8) |
+                                static_cast<uint32_t>(static_cast<uint8_t>(buffer[3]));
+            auto it = inFlight.find(sequence);
+            if (it == inFlight.end()) {
+                if (_logger->isEnabled(ClientLogLevel::DEBUG)) {
+                    _logger->debug("Ignoring late response for request #" + std::to_string(sequence));
+                }
+                continue;
+            }
+            
+            auto& result = results[it->second.index];
+            result.success = true;
+            result.response = decodeResponsePayload(buffer + HEADER_SIZE, bytesRead - HEADER_SIZE);
+            result.latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - it->second.sentAt);
+            inFlight.erase(it);
+            ++answered;
+        }
+    }
+    
+    _logger->info("Pipelined requests completed: " + std::to_string(answered) + " answered, " +
+                  std::to_string(timedOut) + " timed out, " +
+                  std::to_string(imsis.size() - answered - timedOut) + " failed");
+    return results;
+}
+
+std::vector<PipelinedResponse> PgwClient::sendPipelined(const std::vector<std::string>& imsis) {
+    const auto& config = _config->getConfig();
+    return sendPipelined(imsis, config.pipeline_window, std::chrono::milliseconds(config.receive_timeout_ms));
+}
+
+std::string PgwClient::decodeResponsePayload(const char* payload, size_t length) {
+    // Имена кодов бинарного режима сервера (совпадают с действиями в CDR)
+    static constexpr const char* CODE_NAMES[] = {
+        "created", "refreshed", "rejected_blacklist", "rejected_rate_limit", "error", "invalid_request"
+    };
+    
+    if (length == 1) {
+        auto code = static_cast<uint8_t>(payload[0]);
+        if (code < std::size(CODE_NAMES)) {
+            return CODE_NAMES[code];
+        }
+        return "unknown_code_" + std::to_string(code);
+    }
+    return {payload, length};
+}
+
 bool PgwClient::setupUdpSocket() {
     // Закрываем сокет, если он уже был открыт
     closeSocket();
@@ -103,7 +271,8 @@ void PgwClient::closeSocket() {
     }
 }
 
-std::pair<bool, std::string> PgwClient::encodeImsiToBcd(const std::string& imsi) {
+std::pair<bool, std::string> PgwClient::encodeImsiToBcd(const std::string& imsi,
+                                                        std::optional<uint32_t> sequence) {
     // Проверяем, что IMSI имеет правильный формат (15 цифр)
     if (imsi.length() != 15 || !std::all_of(imsi.begin(), imsi.end(), ::isdigit)) {
         return {false, ""};
@@ -113,11 +282,12 @@ std::pair<bool, std::string> PgwClient::encodeImsiToBcd(const std::string& imsi)
     // BCD формат: каждый байт содержит две цифры (кроме последнего, если количество цифр нечетное)
     std::string bcdImsi;
     
-    // Добавляем заголовок пакета (4 байта)
-    bcdImsi.push_back(0x01);
-    bcdImsi.push_back(0x00);
-    bcdImsi.push_back(0x00);
-    bcdImsi.push_back(0x00);
+    // Добавляем заголовок пакета (4 байта): версия и номер запроса (big-endian, только в версии 2)
+    uint32_t number = sequence.value_or(0) & SEQUENCE_MASK;
+    bcdImsi.push_back(static_cast<char>(sequence ? HEADER_VERSION_CORRELATED : HEADER_VERSION));
+    bcdImsi.push_back(static_cast<char>(number >> 16));
+    bcdImsi.push_back(static_cast<char>(number >> 8));
+    bcdImsi.push_back(static_cast<char>(number));
     
     // Резервируем память для данных IMSI
     bcdImsi.reserve(4 + (imsi.length() + 1) / 2);
@@ -139,14 +309,16 @@ std::pair<bool, std::string> PgwClient::encodeImsiToBcd(const std::string& imsi)
         bcdImsi.push_back(static_cast<char>(byte));
     }
     
-    // Выводим отладочную информацию
-    std::string hexDump;
-    for (unsigned char c : bcdImsi) {
-        char hex[8];
-        snprintf(hex, sizeof(hex), "%02x ", c);
-        hexDump += hex;
+    // Выводим отладочную информацию (дамп строится только при включенном DEBUG)
+    if (_logger->isEnabled(ClientLogLevel::DEBUG)) {
+        std::string hexDump;
+        for (unsigned char c : bcdImsi) {
+            char hex[8];
+            snprintf(hex, sizeof(hex), "%02x ", c);
+            hexDump += hex;
+        }
+        _logger->debug("BCD encoded IMSI: " + hexDump);
     }
-    _logger->debug("BCD encoded IMSI: " + hexDump);
     
     return {true, bcdImsi};
 }
@@ -184,8 +356,10 @@ bool PgwClient::sendUdpPacket(const std::string& bcdImsi) {
                       std::to_string(bcdImsi.length()));
     }
     
-    _logger->debug("Sent " + std::to_string(bytesSent) + " bytes to " + 
-                   config.server_ip + ":" + std::to_string(config.server_port));
+    if (_logger->isEnabled(ClientLogLevel::DEBUG)) {
+        _logger->debug("Sent " + std::to_string(bytesSent) + " bytes to " + 
+                       config.server_ip + ":" + std::to_string(config.server_port));
+    }
     
     return true;
 }
@@ -228,12 +402,14 @@ std::pair<bool, std::string> PgwClient::receiveResponse() {
         return {false, ""};
     }
     
-    // Преобразуем IP адрес в строку для логирования
-    char serverIp[INET_ADDRSTRLEN];
-    inet_ntop(AF_INET, &(serverAddr.sin_addr), serverIp, INET_ADDRSTRLEN);
-    
-    _logger->debug("Received " + std::to_string(bytesRead) + " bytes from " + 
-                   std::string(serverIp) + ":" + std::to_string(ntohs(serverAddr.sin_port)));
+    if (_logger->isEnabled(ClientLogLevel::DEBUG)) {
+        // Преобразуем IP адрес в строку для логирования
+        char serverIp[INET_ADDRSTRLEN];
+        inet_ntop(AF_INET, &(serverAddr.sin_addr), serverIp, INET_ADDRSTRLEN);
+        
+        _logger->debug("Received " + std::to_string(bytesRead) + " bytes from " + 
+                       std::string(serverIp) + ":" + std::to_string(ntohs(serverAddr.sin_port)));
+    }
     
     return {true, std::string(buffer, bytesRead)};
 } 
\ No newline at end of file
@@ -5,8 +5,19 @@
 #include <string>
 #include <memory>
 #include <utility>
+#include <vector>
+#include <chrono>
+#include <optional>
+#include <cstdint>
 
-class FloodWorker;
+/**
+ * @brief Результат запроса, отправленного конвейером
+ */
+struct PipelinedResponse {
+    bool success = false;                   // Получен ли ответ сервера
+    std::string response;                   // Ответ сервера или причина ошибки
+    std::chrono::microseconds latency{0};   // Время от отправки запроса до ответа
+};
 
 /**
  * @brief Основной класс клиента для взаимодействия с PGW сервером
@@ -16,8 +27,9 @@ public:
     /**
      * @brief Создает клиент с указанным путем к конфигурации
      * @param configPath Путь к файлу конфигурации
+     * @param initialSequence Номер первого запроса конвейера (берутся младшие 24 бита)
      */
-    explicit PgwClient(const std::string& configPath = "client_config.json");
+    explicit PgwClient(const std::string& configPath = "client_config.json", uint32_t initialSequence = 0);
     
     /**
      * @brief Деструктор, закрывает сокет
@@ -42,11 +54,35 @@ public:
      * @return Пара (успех операции, ответ сервера)
      */
     std::pair<bool, std::string> sendRequest(const std::string& imsi);
+    
+    /**
+     * @brief Отправляет запросы конвейером через один сокет
+     *
+     * В полете одновременно держится до window запросов. Каждый запрос получает
+     * номер в заголовке версии 2, сервер повторяет заголовок в ответе, и ответы
+     * сопоставляются с запросами по номеру в любом порядке. Запрос без ответа
+     * за timeout завершается ошибкой "Timeout", опоздавший ответ отбрасывается.
+     * @param imsis IMSI абонентов (15 цифр)
+     * @param window Максимальное количество запросов без ответа
+     * @param timeout Таймаут ответа на каждый запрос
+     * @return Результаты в порядке imsis
+     */
+    std::vector<PipelinedResponse> sendPipelined(const std::vector<std::string>& imsis, size_t window,
+                                                 std::chrono::milliseconds timeout);
+    
+    /**
+     * @brief Отправляет запросы конвейером с окном и таймаутом из конфигурации
+     * @param imsis IMSI абонентов (15 цифр)
+     * @return Результаты в порядке imsis
+     */
+    std::vector<PipelinedResponse> sendPipelined(const std::vector<std::string>& imsis);
 
-private:
-
-    friend class FloodWorker;
+    static constexpr uint8_t HEADER_VERSION = 0x01;             // Версия заголовка без номера запроса
+    static constexpr uint8_t HEADER_VERSION_CORRELATED = 0x02;  // Версия заголовка с номером запроса в байтах 1-3
+    static constexpr size_t HEADER_SIZE = 4;                    // Размер заголовка запроса
+    static constexpr uint32_t SEQUENCE_MASK = 0xFFFFFF;         // Номер запроса занимает 24 бита
 
+private:
     /**
      * @brief Настраивает UDP сокет
      * @return true если сокет успешно создан, иначе false
@@ -61,9 +97,11 @@ private:
     /**
      * @brief Кодирует IMSI в BCD формат
      * @param imsi IMSI абонента (15 цифр)
+     * @param sequence Номер запроса (если задан, используется заголовок версии 2)
      * @return Пара (успех кодирования, закодированная строка)
      */
-    std::pair<bool, std::string> encodeImsiToBcd(const std::string& imsi);
+    std::pair<bool, std::string> encodeImsiToBcd(const std::string& imsi,
+                                                 std::optional<uint32_t> sequence = std::nullopt);
     
     /**
      * @brief Отправляет UDP пакет с закодированным IMSI
@@ -77,10 +115,19 @@ private:
      * @return Пара (успех получения, ответ)
      */
     std::pair<bool, std::string> receiveResponse();
+    
+    /**
+     * @brief Преобразует тело ответа с заголовком версии 2 в строку
+     * @param payload Данные после заголовка
+     * @param length Длина данных
+     * @return Текст ответа (однобайтовый код бинарного режима - в виде имени)
+     */
+    static std::string decodeResponsePayload(const char* payload, size_t length);
 
     std::unique_ptr<ClientConfig> _config;       // Конфигурация клиента
     std::unique_ptr<ClientLogger> _logger;       // Логгер
     int _socket = -1;                            // UDP сокет
+    uint32_t _nextSequence = 0;                  // Номер следующего запроса конвейера
 
     static constexpr size_t MAX_RESPONSE_SIZE = 256;  // Максимальный размер ответа
 };
\ No newline at end of file
@@ -2,31 +2,35 @@
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <vector>
 
 /**
  * @brief Выводит справку по использованию программы
  * @param programName Имя программы
  */
 void printUsage(const std::string& programName) {
-    std::cout << "Usage: " << programName << " <IMSI>" << std::endl;
+    std::cout << "Usage: " << programName << " <IMSI> [IMSI...]" << std::endl;
     std::cout << "  IMSI must be a 15-digit number" << std::endl;
+    std::cout << "  Several IMSI are sent pipelined over one socket" << std::endl;
     std::cout << "Example: " << programName << " 123456789012345" << std::endl;
 }
 
 int main(int argc, char* argv[]) {
-    if (argc != 2) {
+    if (argc < 2) {
         std::cerr << "Error: Invalid number of arguments" << std::endl;
         printUsage(argv[0]);
         return 1;
     }
 
-    std::string imsi = argv[1];
+    std::vector<std::string> imsis(argv + 1, argv + argc);
 
-    // Проверяем, что IMSI состоит только из цифр и имеет длину 15
-    if (imsi.length() != 15 || !std::all_of(imsi.begin(), imsi.end(), ::isdigit)) {
-        std::cerr << "Error: IMSI must be a 15-digit number" << std::endl;
-        printUsage(argv[0]);
-        return 1;
+    // Проверяем, что каждый IMSI состоит только из цифр и имеет длину 15
+    for (const auto& imsi : imsis) {
+        if (imsi.length() != 15 || !std::all_of(imsi.begin(), imsi.end(), ::isdigit)) {
+            std::cerr << "Error: IMSI must be a 15-digit number" << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
     }
     
     try {
@@ -36,18 +40,36 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-        std::cout << "Sending request for IMSI: " << imsi << std::endl;
-        auto [success, response] = client.sendRequest(imsi);
+        if (imsis.size() == 1) {
+            std::cout << "Sending request for IMSI: " << imsis[0] << std::endl;
+            auto [success, response] = client.sendRequest(imsis[0]);
 
-        if (success) {
-            std::cout << "Response: " << response << std::endl;
-            return 0;
-        } else {
-            std::cerr << "Error: " << response << std::endl;
-            return 1;
+            if (success) {
+                std::cout << "Response: " << response << std::endl;
+                return 0;
+            } else {
+                std::cerr << "Error: " << response << std::endl;
+                return 1;
+            }
         }
+
+        // Несколько IMSI отправляются конвейером с сопоставлением ответов по номеру запроса
+        std::cout << "Sending " << imsis.size() << " pipelined requests" << std::endl;
+        auto results = client.sendPipelined(imsis);
+
+        int exitCode = 0;
+        for (size_t i = 0; i < imsis.size(); ++i) {
+            if (results[i].success) {
+                std::cout << imsis[i] << ": " << results[i].response
+                          << " (" << results[i].latency.count() << " us)" << std::endl;
+            } else {
+                std::cerr << imsis[i] << ": Error: " << results[i].response << std::endl;
+                exitCode = 1;
+            }
+        }
+        return exitCode;
     } catch (const std::exception& e) {
         std::cerr << "Fatal error: " << e.what() << std::endl;
         return 1;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include "../PgwClient.h"
+
+/**
+ * @brief Запрос, принятый тестовым UDP-ответчиком
+ */
+struct ReceivedRequest {
+    uint32_t sequence = 0;          // Номер запроса из заголовка версии 2
+    std::string imsi;               // Декодированный IMSI
+    struct sockaddr_in from{};      // Адрес клиента
+};
+
+class PgwClientTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Ответчик на loopback с портом, выбранным ядром
+        responderSocket = socket(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_GE(responderSocket, 0);
+
+        struct sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        ASSERT_EQ(bind(responderSocket, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)), 0);
+
+        socklen_t addrLen = sizeof(addr);
+        ASSERT_EQ(getsockname(responderSocket, reinterpret_cast<struct sockaddr*>(&addr), &addrLen), 0);
+        responderPort = ntohs(addr.sin_port);
+
+        configPath = "test_client_config_" + std::to_string(responderPort) + ".json";
+        std::ofstream config(configPath);
+        config << "{\n"
+               << "  \"server_ip\": \"127.0.0.1\",\n"
+               << "  \"server_port\": " << responderPort << ",\n"
+               << "  \"log_file\": \"\",\n"
+               << "  \"log_level\": \"ERROR\",\n"
+               << "  \"receive_timeout_ms\": 300,\n"
+               << "  \"pipeline_window\": 8\n"
+               << "}\n";
+    }
+
+    void TearDown() override {
+        if (responderSocket >= 0) {
+            close(responderSocket);
+        }
+        std::remove(configPath.c_str());
+    }
+
+    /**
+     * @brief Принимает запрос конвейера и декодирует его заголовок и IMSI
+     * @param request Принятый запрос
+     * @return true если запрос получен за 2 секунды
+     */
+    bool receiveRequest(ReceivedRequest& request) const {
+        struct pollfd fds[1];
+        fds[0].fd = responderSocket;
+        fds[0].events = POLLIN;
+        if (poll(fds, 1, 2000) <= 0) {
+            return false;
+        }
+
+        uint8_t buffer[64];
+        socklen_t fromLen = sizeof(request.from);
+        ssize_t bytesRead = recvfrom(responderSocket, buffer, sizeof(buffer), 0,
+                                     reinterpret_cast<struct sockaddr*>(&request.from), &fromLen);
+        if (bytesRead < static_cast<ssize_t>(PgwClient::HEADER_SIZE) ||
+            buffer[0] != PgwClient::HEADER_VERSION_CORRELATED) {
+            return false;
+        }
+
+        request.sequence = (static_cast<uint32_t>(buffer[1]) << 16) |
+                           (static_cast<uint32_t>(buffer[2]) << 8) |
+                           static_cast<uint32_t>(buffer[3]);
+        request.imsi.clear();
+        for (ssize_t i = PgwClient::HEADER_SIZE; i < bytesRead; ++i) {
+            request.imsi.push_back(static_cast<char>('0' + (buffer[i] & 0x0F)));
+            if ((buffer[i] >> 4) != 0x0F) {
+                request.imsi.push_back(static_cast<char>('0' + (buffer[i] >> 4)));
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Отправляет ответ с заголовком версии 2
+     * @param to Адрес клиента
+     * @param sequence Номер запроса
+     * @param payload Текст ответа
+     */
+    void reply(const struct sockaddr_in& to, uint32_t sequence, const std::string& payload) const {
+        std::string packet;
+        packet.push_back(static_cast<char>(PgwClient::HEADER_VERSION_CORRELATED));
+        packet.push_back(static_cast<char>(sequence >> 16));
+        packet.push_back(static_cast<char>(sequence >> 8));
+        packet.push_back(static_cast<char>(sequence));
+        packet += payload;
+        sendto(responderSocket, packet.data(), packet.size(), 0,
+               reinterpret_cast<const struct sockaddr*>(&to), sizeof(to));
+    }
+
+    int responderSocket = -1;
+    uint16_t responderPort = 0;
+    std::string configPath;
+};
+
+// Этот тест проверяет сопоставление ответов не по порядку, таймаут потерянного запроса
+// и отбрасывание ответов с устаревшим или повторным номером
+TEST_F(PgwClientTest, PipelinedMatchesOutOfOrderResponses) {
+    const std::vector<std::string> imsis = {
+        "001010000000001", "001010000000002", "001010000000003", "001010000000004"
+    };
+    const size_t droppedIndex = 1;
+
+    std::vector<ReceivedRequest> requests;
+    std::thread responder([&]() {
+        // Окно вмещает все запросы: ответчик дожидается их всех, затем отвечает
+        for (size_t i = 0; i < imsis.size(); ++i) {
+            ReceivedRequest request;
+            if (!receiveRequest(request)) {
+                return;
+            }
+            requests.push_back(request);
+        }
+        const auto& client = requests.front().from;
+
+        // Ответ без номера и ответ на номер, которого нет в полете, игнорируются
+        sendto(responderSocket, "created", 7, 0, reinterpret_cast<const struct sockaddr*>(&client), sizeof(client));
+        reply(client, (requests.back().sequence + 100) & PgwClient::SEQUENCE_MASK, "stale");
+
+        // Ответы в обратном порядке, один запрос остается без ответа
+        for (size_t i = requests.size(); i-- > 0;) {
+            if (i != droppedIndex) {
+                reply(client, requests[i].sequence, requests[i].imsi);
+            }
+        }
+
+        // Повторный ответ на уже сопоставленный запрос не меняет результат
+        reply(client, requests.back().sequence, "duplicate");
+    });
+
+    PgwClient client(configPath);
+    ASSERT_TRUE(client.initialize());
+    auto results = client.sendPipelined(imsis, 8, std::chrono::milliseconds(300));
+    responder.join();
+
+    ASSERT_EQ(requests.size(), imsis.size());
+    ASSERT_EQ(results.size(), imsis.size());
+    for (size_t i = 0; i < imsis.size(); ++i) {
+        EXPECT_EQ(requests[i].imsi, imsis[i]);
+        if (i == droppedIndex) {
+            EXPECT_FALSE(results[i].success);
+            EXPECT_EQ(results[i].response, "Timeout");
+        } else {
+            EXPECT_TRUE(results[i].success) << "request " << i;
+            EXPECT_EQ(results[i].response, imsis[i]) << "request " << i;
+        }
+    }
+}
+
+// Этот тест проверяет дозаполнение окна и переход номера запроса через SEQUENCE_MASK
+TEST_F(PgwClientTest, PipelinedSequenceWrapsAroundMask) {
+    const std::vector<std::string> imsis = {
+        "001010000000011", "001010000000012", "001010000000013",
+        "001010000000014", "001010000000015", "001010000000016"
+    };
+    const size_t window = 2;
+
+    std::vector<ReceivedRequest> requests;
+    std::thread responder([&]() {
+        // Отвечаем на каждое заполненное окно в обратном порядке
+        while (requests.size() < imsis.size()) {
+            ReceivedRequest request;
+            if (!receiveRequest(request)) {
+                return;
+            }
+            requests.push_back(request);
+            if (requests.size() % window == 0) {
+                for (size_t i = requests.size(); i-- > requests.size() - window;) {
+                    reply(requests[i].from, requests[i].sequence, requests[i].imsi);
+                }
+            }
+        }
+    });
+
+    PgwClient client(configPath, PgwClient::SEQUENCE_MASK - 2);
+    ASSERT_TRUE(client.initialize());
+    auto results = client.sendPipelined(imsis, window, std::chrono::milliseconds(1000));
+    responder.join();
+
+    ASSERT_EQ(requests.size(), imsis.size());
+    const std::vector<uint32_t> expectedSequences = {
+        PgwClient::SEQUENCE_MASK - 2, PgwClient::SEQUENCE_MASK - 1, PgwClient::SEQUENCE_MASK, 0, 1, 2
+    };
+    for (size_t i = 0; i < imsis.size(); ++i) {
+        EXPECT_EQ(requests[i].sequence, expectedSequences[i]) << "request " << i;
+        EXPECT_TRUE(results[i].success) << "request " << i;
+        EXPECT_EQ(results[i].response, imsis[i]) << "request " << i;
+    }
+}
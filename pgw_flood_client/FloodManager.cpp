@@ -1,13 +1,47 @@
 #include <FloodManager.h>
+#include <Metrics.h>
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <netdb.h>
 
-FloodManager::FloodManager(int threadCount) {
-    for (int i = 0; i < threadCount; ++i)
-        _workers.emplace_back(std::make_unique<FloodWorker>(i));
-}
+using namespace std::chrono;
+
+FloodManager::FloodManager(const FloodOptions& options)
+    : _options(options) {}
+
+bool FloodManager::start() {
+    // Имя хоста разрешается один раз для всех потоков
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* result = nullptr;
+    int error = getaddrinfo(_options.serverHost.c_str(), nullptr, &hints, &result);
+    if (error != 0) {
+        std::cerr << "Failed to resolve " << _options.serverHost << ": " << gai_strerror(error) << "\n";
+        return false;
+    }
+    sockaddr_in server{};
+    std::memcpy(&server, result->ai_addr, sizeof(server));
+    server.sin_port = htons(_options.serverPort);
+    freeaddrinfo(result);
 
-void FloodManager::start() {
+    // Сокеты и кольца пакетов готовятся до выбора начала: иначе расписание
+    // первых потоков уходит в прошлое, пока строятся кольца остальных
+    for (int i = 0; i < _options.threads; ++i) {
+        _workers.emplace_back(std::make_unique<FloodWorker>(i, _options, server));
+        if (!_workers.back()->prepare()) {
+            _workers.clear();
+            return false;
+        }
+    }
+
+    // Небольшой запас, чтобы все потоки успели стартовать к общему началу расписания
+    _startTime = FloodWorker::Clock::now() + milliseconds(10);
     for (auto& w : _workers)
-        w->start();
+        w->start(_startTime);
+    return true;
 }
 
 void FloodManager::stop() {
@@ -15,4 +49,106 @@ void FloodManager::stop() {
         w->stop();
     for (auto& w : _workers)
         w->join();
+    _stopTime = FloodWorker::Clock::now();
+
+    auto total = totalStats();
+    publishLatency();
+    Metrics::setLossRatio(total.lossRatio());
+}
+
+bool FloodManager::isFinished() const {
+    return std::all_of(_workers.begin(), _workers.end(),
+                       [](const auto& w) { return w->isFinished(); });
+}
+
+uint64_t FloodManager::sentCount() const {
+    uint64_t total = 0;
+    for (const auto& w : _workers)
+        total += w->sentCount();
+    return total;
+}
+
+FloodWorkerStats FloodManager::totalStats() const {
+    FloodWorkerStats total;
+    for (const auto& w : _workers) {
+        const auto& stats = w->stats();
+        total.sent += stats.sent;
+        total.warmupSent += stats.warmupSent;
+        total.sendErrors += stats.sendErrors;
+        total.maxLag = std::max(total.maxLag, stats.maxLag);
+        total.received += stats.received;
+        total.late += stats.late;
+        total.overwritten += stats.overwritten;
+        total.unmatched += stats.unmatched;
+        for (size_t i = 0; i < RESPONSE_KIND_COUNT; ++i)
+            total.responses[i] += stats.responses[i];
+    }
+    return total;
+}
+
+void FloodManager::mergeLatency(LatencyHistogram& merged) const {
+    for (const auto& w : _workers)
+        merged.merge(w->latency());
+}
+
+void FloodManager::publishLatency() const {
+    LatencyHistogram merged;
+    mergeLatency(merged);
+    Metrics::setLatency(merged);
+}
+
+double FloodManager::measuredWindow() const {
+    auto measureStart = _startTime + duration_cast<FloodWorker::Clock::duration>(duration<double>(_options.warmupSec));
+    auto measureEnd = _stopTime;
+    if (_options.durationSec > 0) {
+        measureEnd = std::min(measureEnd, measureStart + duration_cast<FloodWorker::Clock::duration>(
+                                                             duration<double>(_options.durationSec)));
+    }
+    return std::max(duration<double>(measureEnd - measureStart).count(), 0.0);
+}
+
+void FloodManager::printSummary(std::ostream& out) const {
+    auto total = totalStats();
+    LatencyHistogram latency;
+    mergeLatency(latency);
+
+    double window = measuredWindow();
+
+    out << std::fixed << std::setprecision(1)
+        << "=== Flood summary ===\n"
+        << "Threads:          " << _options.threads << "\n"
+        << "Measured window:  " << window << " s (warmup " << _options.warmupSec << " s, "
+        << total.warmupSent << " requests)\n"
+        << "Sent:             " << total.sent << "\n"
+        << "Send errors:      " << total.sendErrors << "\n";
+    if (_options.ratePerWorker > 0) {
+        out << "Target rate:      " << _options.ratePerWorker * _options.threads << " req/s\n";
+    }
+    out << "Achieved rate:    " << (window > 0 ? static_cast<double>(total.sent) / window : 0.0) << " req/s\n"
+        << "Max schedule lag: " << duration<double, std::micro>(total.maxLag).count() << " us\n";
+
+    out << "Received:         " << total.received << "\n"
+        << "Lost:             " << total.lost() << " (" << std::setprecision(3) << 100.0 * total.lossRatio() << " %)\n"
+        << "Late:             " << total.late << " (after " << _options.responseTimeoutMs << " ms, counted as lost)\n"
+        << "Overwritten:      " << total.overwritten << " (slot reused before response, not counted)\n"
+        << "Unmatched:        " << total.unmatched << "\n";
+
+    auto micros = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    out << std::setprecision(1)
+        << "Latency (us, from scheduled send time):\n"
+        << "  p50:    " << micros(latency.valueAtPercentile(50.0)) << "\n"
+        << "  p90:    " << micros(latency.valueAtPercentile(90.0)) << "\n"
+        << "  p99:    " << micros(latency.valueAtPercentile(99.0)) << "\n"
+        << "  p99.9:  " << micros(latency.valueAtPercentile(99.9)) << "\n"
+        << "  max:    " << micros(latency.max()) << "\n"
+        << "  mean:   " << latency.mean() / 1000.0 << "\n";
+
+    out << "Results:\n";
+    for (size_t i = 0; i < RESPONSE_KIND_COUNT; ++i) {
+        if (total.responses[i] == 0)
+            continue;
+        out << "  " << std::left << std::setw(20) << responseKindName(static_cast<ResponseKind>(i)) << std::right
+            << total.responses[i] << " ("
+            << 100.0 * static_cast<double>(total.responses[i]) / static_cast<double>(total.received) << " %)\n";
+    }
 }
@@ -1,14 +1,69 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <ostream>
+#include <FloodOptions.h>
 #include <FloodWorker.h>
 
+/**
+ * @brief Управляет рабочими потоками нагрузочного клиента и сводит их результаты
+ */
 class FloodManager {
 public:
-    explicit FloodManager(int threadCount);
-    void start();
+    explicit FloodManager(const FloodOptions& options);
+
+    /**
+     * @brief Разрешает адрес сервера и запускает рабочие потоки с общим моментом начала
+     * @return true если все потоки запущены
+     */
+    bool start();
+
+    /**
+     * @brief Останавливает рабочие потоки и дожидается их завершения
+     */
     void stop();
 
+    /**
+     * @brief Проверяет, завершили ли все потоки работу по истечении длительности
+     */
+    [[nodiscard]] bool isFinished() const;
+
+    /**
+     * @brief Возвращает общее число отправленных запросов
+     */
+    [[nodiscard]] uint64_t sentCount() const;
+
+    /**
+     * @brief Сливает гистограммы задержек потоков и публикует перцентили в метрики
+     */
+    void publishLatency() const;
+
+    /**
+     * @brief Выводит итоговый отчет (после stop)
+     * @param out Поток вывода
+     */
+    void printSummary(std::ostream& out) const;
+
+    /**
+     * @brief Суммирует счетчики потоков (после stop)
+     */
+    [[nodiscard]] FloodWorkerStats totalStats() const;
+
+    /**
+     * @brief Сливает гистограммы задержек всех потоков
+     * @param merged Гистограмма-приемник
+     */
+    void mergeLatency(LatencyHistogram& merged) const;
+
+    /**
+     * @brief Возвращает длительность окна измерения: от конца прогрева до истечения длительности или остановки
+     * @return Длительность в секундах (после stop)
+     */
+    [[nodiscard]] double measuredWindow() const;
+
 private:
+    FloodOptions _options;
     std::vector<std::unique_ptr<FloodWorker>> _workers;
+    FloodWorker::Clock::time_point _startTime;
+    FloodWorker::Clock::time_point _stopTime;
 };
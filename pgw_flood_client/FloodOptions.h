@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Распределение интервалов между запросами одного рабочего потока
+ */
+enum class ArrivalProcess {
+    CONSTANT,   // Равные интервалы 1/rate
+    POISSON     // Экспоненциальные интервалы со средним 1/rate (пуассоновский поток)
+};
+
+/**
+ * @brief Профиль выбора IMSI для запросов
+ */
+enum class WorkloadProfile {
+    RANDOM,     // Каждый запрос - новый случайный IMSI (почти всегда создание сессии)
+    UNIFORM,    // Фиксированная популяция абонентов с равной популярностью
+    ZIPF        // Фиксированная популяция с популярностью по закону Ципфа
+};
+
+/**
+ * @brief Параметры модели абонентской нагрузки
+ */
+struct WorkloadOptions {
+    WorkloadProfile profile = WorkloadProfile::RANDOM;  // Профиль выбора IMSI
+    uint64_t population = 100000;                       // Размер популяции абонентов
+    double zipfExponent = 0.99;                         // Показатель распределения Ципфа (профиль ZIPF)
+    std::vector<std::string> blacklist;                 // IMSI из черного списка сервера
+    double blacklistRatio = 0.0;                        // Доля запросов с IMSI из черного списка
+    double churnPerSec = 0.0;                           // Доля популяции, сменяющей IMSI за секунду (отключение и новое подключение)
+    double churnPeriodSec = 0.0;                        // Смена IMSI пачками в начале каждого периода, с (0 - равномерно)
+};
+
+constexpr int MAX_BATCH_SIZE = 1024;   // Предел числа сообщений одного sendmmsg (UIO_MAXIOV)
+
+/**
+ * @brief Параметры нагрузочного клиента
+ *
+ * Нагрузка открытая (open-loop): момент отправки каждого запроса задается
+ * расписанием и не зависит от того, как быстро отвечает сервер.
+ */
+struct FloodOptions {
+    int threads = 1;                                    // Количество рабочих потоков
+    std::string serverHost = "127.0.0.1";               // Адрес или имя хоста сервера
+    uint16_t serverPort = 9000;                         // UDP-порт сервера
+    double ratePerWorker = 1000.0;                      // Целевая частота запросов на поток, 1/с (0 - без ограничения)
+    ArrivalProcess arrival = ArrivalProcess::POISSON;   // Распределение интервалов между запросами
+    double durationSec = 0.0;                           // Длительность измерения, с (0 - до сигнала остановки)
+    double warmupSec = 0.0;                             // Прогрев перед измерением, с (запросы не учитываются)
+    int metricsPort = 9100;                             // Порт Prometheus-метрик
+    int responseTimeoutMs = 1000;                       // Предельная задержка ответа и ожидание после остановки отправки, мс
+    bool blast = false;                                 // Режим высокой частоты: кольцо готовых пакетов и sendmmsg
+    int socketsPerWorker = 1;                           // Подключенных сокетов на поток (разные порты источника)
+    int batchSize = 32;                                 // Пакетов в одном sendmmsg в режиме blast
+    bool pinCpu = false;                                // Закрепить поток отправки за ядром (номер потока по модулю числа ядер)
+    WorkloadOptions workload;                           // Модель абонентской нагрузки
+};
@@ -1,28 +1,96 @@
 #include <FloodWorker.h>
-#include <ImsiGenerator.h>
-#include <iostream>
-#include <chrono>
 #include <Metrics.h>
-
-#include <PgwClient.h>
+#include <bit>
+#include <iostream>
+#include <string_view>
+#include <cstring>
+#include <cerrno>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
 
 using namespace std::chrono;
 
-FloodWorker::FloodWorker(int id)
-    : _id(id), _running(false), _client(std::make_unique<PgwClient>()) {}
+namespace {
+
+constexpr auto SPIN_THRESHOLD = microseconds(100);  // Последний отрезок ожидания проходится без сна (точность таймера)
+constexpr auto RECEIVE_POLL = milliseconds(100);    // Таймаут ожидания ответов для проверки завершения
+constexpr size_t RECEIVE_BUFFER_SIZE = 512;         // Ответ сервера - заголовок и короткая строка или код
+constexpr size_t RECEIVE_BATCH = 64;                // Ответов за один recvmmsg
+constexpr int BLAST_SOCKET_BUFFER = 4 * 1024 * 1024; // Буферы сокетов режима blast, чтобы пики не терялись в ядре
+constexpr uint8_t HEADER_VERSION_CORRELATED = 0x02; // Заголовок с номером запроса
+
+} // namespace
+
+FloodWorker::FloodWorker(int id, const FloodOptions& options, const sockaddr_in& server, uint32_t initialSequence)
+    : _id(id),
+      _options(options),
+      _server(server),
+      _initialSequence(initialSequence & SEQUENCE_MASK),
+      _inFlightSlots(inFlightSlotsFor(options)),
+      _inFlight(std::make_unique<std::atomic<uint64_t>[]>(_inFlightSlots)),
+      _random(std::random_device{}() + static_cast<uint64_t>(id)),
+      _exponential(options.ratePerWorker > 0 ? options.ratePerWorker : 1.0),
+      _workload(options.workload, _random()) {
+    for (size_t i = 0; i < _inFlightSlots; ++i) {
+        _inFlight[i].store(EMPTY_SLOT, std::memory_order_relaxed);
+    }
+}
+
+size_t FloodWorker::inFlightSlotsFor(const FloodOptions& options) {
+    // Без ограничения частоты окно ожидания неизвестно: вытесненные запросы учитываются в overwritten
+    if (options.ratePerWorker <= 0) {
+        return MIN_IN_FLIGHT_SLOTS;
+    }
+    double pending = options.ratePerWorker * options.responseTimeoutMs / 1000.0 * IN_FLIGHT_HEADROOM;
+    if (pending >= static_cast<double>(MAX_IN_FLIGHT_SLOTS)) {
+        return MAX_IN_FLIGHT_SLOTS;
+    }
+    return std::max(std::bit_ceil(static_cast<size_t>(pending)), MIN_IN_FLIGHT_SLOTS);
+}
 
 FloodWorker::~FloodWorker() {
     stop();
     join();
+    for (int socket : _sockets) {
+        close(socket);
+    }
 }
 
-void FloodWorker::start() {
-    if (!_client->initialize()) {
-        std::cerr << "[Worker " << _id << "] Failed to initialize client\n";
-        return;
+bool FloodWorker::prepare() {
+    for (int i = 0; i < _options.socketsPerWorker; ++i) {
+        int fd = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd < 0) {
+            std::cerr << "[Worker " << _id << "] Failed to create socket: " << strerror(errno) << "\n";
+            return false;
+        }
+        _sockets.push_back(fd);
+
+        // Сокет подключается к серверу: адрес не передается с каждым пакетом
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&_server), sizeof(_server)) < 0) {
+            std::cerr << "[Worker " << _id << "] Failed to connect socket: " << strerror(errno) << "\n";
+            return false;
+        }
+        if (_options.blast) {
+            setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &BLAST_SOCKET_BUFFER, sizeof(BLAST_SOCKET_BUFFER));
+            setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &BLAST_SOCKET_BUFFER, sizeof(BLAST_SOCKET_BUFFER));
+        }
     }
+    if (_options.blast) {
+        buildRing();
+    }
+    return true;
+}
+
+void FloodWorker::start(Clock::time_point startTime) {
+    _startTime = startTime;
+    _measureStart = startTime + duration_cast<Clock::duration>(duration<double>(_options.warmupSec));
+    _measureEnd = _measureStart + duration_cast<Clock::duration>(duration<double>(_options.durationSec));
     _running = true;
     _thread = std::thread(&FloodWorker::run, this);
+    _receiverThread = std::thread(&FloodWorker::receive, this);
 }
 
 void FloodWorker::stop() {
@@ -32,26 +100,322 @@ void FloodWorker::stop() {
 void FloodWorker::join() {
     if (_thread.joinable())
         _thread.join();
+    if (_receiverThread.joinable())
+        _receiverThread.join();
+}
+
+FloodWorker::Clock::duration FloodWorker::nextInterval() {
+    if (_options.ratePerWorker <= 0) {
+        return Clock::duration::zero();
+    }
+    double seconds = _options.arrival == ArrivalProcess::POISSON
+                         ? _exponential(_random)
+                         : 1.0 / _options.ratePerWorker;
+    return duration_cast<Clock::duration>(duration<double>(seconds));
+}
+
+void FloodWorker::waitUntil(Clock::time_point when) const {
+    auto now = Clock::now();
+    if (when - now > SPIN_THRESHOLD) {
+        std::this_thread::sleep_until(when - SPIN_THRESHOLD);
+    }
+    while (Clock::now() < when && _running.load(std::memory_order_relaxed)) {
+        std::this_thread::yield();
+    }
+}
+
+void FloodWorker::encodeHeader(uint32_t sequence, char* header) {
+    header[0] = static_cast<char>(HEADER_VERSION_CORRELATED);
+    header[1] = static_cast<char>(sequence >> 16);
+    header[2] = static_cast<char>(sequence >> 8);
+    header[3] = static_cast<char>(sequence);
+}
+
+void FloodWorker::encodeImsi(const std::string& imsi, char* bcd) {
+    for (size_t i = 0; i < IMSI_BYTES; ++i) {
+        uint8_t low = imsi[2 * i] - '0';
+        uint8_t high = 2 * i + 1 < imsi.size() ? imsi[2 * i + 1] - '0' : 0x0F;
+        bcd[i] = static_cast<char>(low | (high << 4));
+    }
+}
+
+void FloodWorker::encodePacket(const std::string& imsi, uint32_t sequence, char* packet) {
+    encodeHeader(sequence, packet);
+    encodeImsi(imsi, packet + HEADER_SIZE);
+}
+
+void FloodWorker::buildRing() {
+    _ring.resize(PACKET_RING_SIZE * IMSI_BYTES);
+    for (size_t i = 0; i < PACKET_RING_SIZE; ++i) {
+        encodeImsi(_workload.next(Clock::duration::zero()), &_ring[i * IMSI_BYTES]);
+    }
+}
+
+void FloodWorker::pinToCpu() const {
+    unsigned cpus = std::thread::hardware_concurrency();
+    if (cpus == 0) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(static_cast<unsigned>(_id) % cpus, &set);
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (error != 0) {
+        std::cerr << "[Worker " << _id << "] Failed to pin to CPU: " << strerror(error) << "\n";
+    }
+}
+
+void FloodWorker::trackRequest(uint32_t sequence, Clock::time_point scheduled) {
+    // Запланированное время публикуется до отправки: ответ может прийти раньше, чем вернется send
+    auto offset = std::max<int64_t>(duration_cast<nanoseconds>(scheduled - _startTime).count(), 0);
+    uint64_t previous = _inFlight[sequence & (_inFlightSlots - 1)].exchange(
+        (static_cast<uint64_t>(offset) >> TIME_SHIFT) << 24 | sequence, std::memory_order_acq_rel);
+    // Вытесненным считается только запрос, чей срок ответа еще не истек: более старый уже потерян
+    if (previous != EMPTY_SLOT && _options.responseTimeoutMs > 0) {
+        auto previousScheduled = scheduledAt(previous);
+        if (previousScheduled >= _measureStart && scheduled - previousScheduled <= milliseconds(_options.responseTimeoutMs)) {
+            ++_stats.overwritten;
+        }
+    }
+}
+
+FloodWorker::Clock::time_point FloodWorker::scheduledAt(uint64_t entry) const {
+    return _startTime + duration_cast<Clock::duration>(nanoseconds((entry >> 24) << TIME_SHIFT));
+}
+
+void FloodWorker::recordSent(Clock::time_point scheduled, Clock::time_point sentAt) {
+    if (scheduled < _measureStart) {
+        ++_stats.warmupSent;
+        return;
+    }
+    ++_stats.sent;
+    _stats.maxLag = std::max(_stats.maxLag, duration_cast<nanoseconds>(sentAt - scheduled));
 }
 
 void FloodWorker::run() {
-    size_t sent = 0;
-    auto last = steady_clock::now();
+    if (_options.pinCpu) {
+        pinToCpu();
+    }
+    waitUntil(_startTime);
 
-    while (_running) {
-        std::string imsi = ImsiGenerator::generate();
-        auto [ok, bcd] = _client->encodeImsiToBcd(imsi);
-        if (ok) {
-            _client->sendUdpPacket(bcd);
-            Metrics::incRequests();
-            ++sent;
+    if (_options.blast) {
+        runBlast();
+    } else {
+        runScheduled();
+    }
+
+    _senderFinishedAtNs.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    _senderFinished.store(true, std::memory_order_release);
+}
+
+void FloodWorker::runScheduled() {
+    const bool limited = _options.durationSec > 0;
+    char packet[PACKET_SIZE];
+    uint32_t sequence = _initialSequence;
+    auto scheduled = _startTime;
+
+    while (_running.load(std::memory_order_relaxed)) {
+        if (_options.ratePerWorker > 0) {
+            scheduled += nextInterval();
+            waitUntil(scheduled);
+        } else {
+            scheduled = Clock::now();
+        }
+        if (limited && scheduled >= _measureEnd) {
+            break;
+        }
+
+        encodePacket(_workload.next(scheduled - _startTime), sequence, packet);
+        trackRequest(sequence, scheduled);
+        int socket = _sockets[sequence % _sockets.size()];
+        sequence = (sequence + 1) & SEQUENCE_MASK;
+
+        auto sentAt = Clock::now();
+        if (send(socket, packet, sizeof(packet), 0) < 0) {
+            ++_stats.sendErrors;
+            continue;
         }
+        Metrics::incRequests();
+        _sentCount.fetch_add(1, std::memory_order_relaxed);
+        recordSent(scheduled, sentAt);
+    }
+}
+
+void FloodWorker::runBlast() {
+    const bool limited = _options.durationSec > 0;
+    const auto batchSize = static_cast<size_t>(_options.batchSize);
+
+    // Заголовок каждого сообщения пачки - свой буфер, IMSI берется из кольца без копирования
+    std::vector<std::array<char, HEADER_SIZE>> headers(batchSize);
+    std::vector<std::array<iovec, 2>> vectors(batchSize);
+    std::vector<mmsghdr> messages(batchSize);
+    std::vector<Clock::time_point> scheduledAt(batchSize);
+    for (size_t i = 0; i < batchSize; ++i) {
+        vectors[i][0] = {headers[i].data(), HEADER_SIZE};
+        messages[i] = {};
+        messages[i].msg_hdr.msg_iov = vectors[i].data();
+        messages[i].msg_hdr.msg_iovlen = vectors[i].size();
+    }
 
-        auto now = steady_clock::now();
-        if (now - last > seconds(1)) {
-            std::cout << "[Worker " << _id << "] Sent: " << sent << " IMSI/s\n";
+    uint32_t sequence = _initialSequence;
+    size_t ringPosition = 0;
+    size_t batchNumber = 0;
+    auto next = _startTime + nextInterval();
+
+    while (_running.load(std::memory_order_relaxed)) {
+        // Пачка - запросы, чье время по расписанию уже наступило (без ограничения частоты - полная пачка)
+        size_t count = 0;
+        if (_options.ratePerWorker > 0) {
+            if (limited && next >= _measureEnd) {
+                break;
+            }
+            waitUntil(next);
+            auto now = Clock::now();
+            while (count < batchSize && next <= now && !(limited && next >= _measureEnd)) {
+                scheduledAt[count++] = next;
+                next += nextInterval();
+            }
+        } else {
+            auto now = Clock::now();
+            if (limited && now >= _measureEnd) {
+                break;
+            }
+            std::fill(scheduledAt.begin(), scheduledAt.end(), now);
+            count = batchSize;
+        }
+        if (count == 0) {
+            continue;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            encodeHeader(sequence, headers[i].data());
+            vectors[i][1] = {&_ring[(ringPosition++ & (PACKET_RING_SIZE - 1)) * IMSI_BYTES], IMSI_BYTES};
+            trackRequest(sequence, scheduledAt[i]);
+            sequence = (sequence + 1) & SEQUENCE_MASK;
+        }
+
+        int sent = sendmmsg(_sockets[batchNumber++ % _sockets.size()], messages.data(), static_cast<unsigned>(count), 0);
+        auto sentAt = Clock::now();
+        if (sent < 0) {
             sent = 0;
-            last = now;
         }
+        _stats.sendErrors += count - static_cast<size_t>(sent);
+        for (int i = 0; i < sent; ++i) {
+            recordSent(scheduledAt[i], sentAt);
+        }
+        Metrics::incRequests(sent);
+        _sentCount.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+    }
+}
+
+void FloodWorker::receive() {
+    const auto responseTimeout = milliseconds(_options.responseTimeoutMs);
+
+    int epollFd = epoll_create1(0);
+    if (epollFd < 0) {
+        std::cerr << "[Worker " << _id << "] Failed to create epoll: " << strerror(errno) << "\n";
+        _receiverFinished.store(true, std::memory_order_release);
+        return;
+    }
+    for (size_t i = 0; i < _sockets.size(); ++i) {
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u32 = static_cast<uint32_t>(i);
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, _sockets[i], &event);
+    }
+
+    std::vector<std::array<char, RECEIVE_BUFFER_SIZE>> buffers(RECEIVE_BATCH);
+    std::vector<iovec> vectors(RECEIVE_BATCH);
+    std::vector<mmsghdr> messages(RECEIVE_BATCH);
+    for (size_t i = 0; i < RECEIVE_BATCH; ++i) {
+        vectors[i] = {buffers[i].data(), RECEIVE_BUFFER_SIZE};
+        messages[i] = {};
+        messages[i].msg_hdr.msg_iov = &vectors[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    std::vector<epoll_event> events(_sockets.size());
+
+    while (true) {
+        if (_senderFinished.load(std::memory_order_acquire)) {
+            Clock::time_point finishedAt{Clock::duration(_senderFinishedAtNs.load(std::memory_order_relaxed))};
+            if (Clock::now() - finishedAt >= responseTimeout) {
+                break;
+            }
+        }
+
+        int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()),
+                               static_cast<int>(RECEIVE_POLL.count()));
+        for (int i = 0; i < ready; ++i) {
+            int socket = _sockets[events[i].data.u32];
+            // Сокет вычитывается до опустошения; ошибка (в том числе ICMP port unreachable) прерывает чтение
+            while (true) {
+                int received = recvmmsg(socket, messages.data(), RECEIVE_BATCH, MSG_DONTWAIT, nullptr);
+                if (received <= 0) {
+                    break;
+                }
+                auto now = Clock::now();
+                for (int j = 0; j < received; ++j) {
+                    handleResponse(buffers[j].data(), messages[j].msg_len, now);
+                }
+                if (static_cast<size_t>(received) < RECEIVE_BATCH) {
+                    break;
+                }
+            }
+        }
+    }
+
+    close(epollFd);
+    _receiverFinished.store(true, std::memory_order_release);
+}
+
+void FloodWorker::handleResponse(const char* buffer, size_t length, Clock::time_point receivedAt) {
+    if (length < HEADER_SIZE || static_cast<uint8_t>(buffer[0]) != HEADER_VERSION_CORRELATED) {
+        ++_stats.unmatched;
+        return;
+    }
+    uint32_t sequence = static_cast<uint32_t>(static_cast<uint8_t>(buffer[1])) << 16 |
+                        static_cast<uint32_t>(static_cast<uint8_t>(buffer[2])) << 8 |
+                        static_cast<uint8_t>(buffer[3]);
+
+    // Слот освобождается атомарно: повторный ответ на тот же запрос не будет учтен дважды
+    auto& slot = _inFlight[sequence & (_inFlightSlots - 1)];
+    uint64_t entry = slot.load(std::memory_order_acquire);
+    if (entry == EMPTY_SLOT || (entry & SEQUENCE_MASK) != sequence ||
+        !slot.compare_exchange_strong(entry, EMPTY_SLOT, std::memory_order_relaxed)) {
+        ++_stats.unmatched;
+        return;
+    }
+
+    auto scheduled = scheduledAt(entry);
+    if (scheduled < _measureStart) {
+        return;
+    }
+    // Ответ позже таймаута приравнивается к потере (при нулевом таймауте возраст не ограничен)
+    if (_options.responseTimeoutMs > 0 && receivedAt - scheduled > milliseconds(_options.responseTimeoutMs)) {
+        ++_stats.late;
+        return;
+    }
+
+    auto kind = classifyResponse(buffer + HEADER_SIZE, length - HEADER_SIZE);
+    ++_stats.received;
+    ++_stats.responses[static_cast<size_t>(kind)];
+    _latency.record(static_cast<uint64_t>(std::max<int64_t>(duration_cast<nanoseconds>(receivedAt - scheduled).count(), 0)));
+    Metrics::incResponses(kind);
+}
+
+ResponseKind FloodWorker::classifyResponse(const char* payload, size_t length) {
+    // Бинарный режим сервера - один байт кода, текстовый - строка
+    if (length == 1) {
+        auto code = static_cast<uint8_t>(payload[0]);
+        return code < static_cast<uint8_t>(ResponseKind::REJECTED) ? static_cast<ResponseKind>(code)
+                                                                    : ResponseKind::UNKNOWN;
+    }
+    std::string_view text(payload, length);
+    if (text == "created") {
+        return ResponseKind::CREATED;
+    }
+    if (text == "rejected") {
+        return ResponseKind::REJECTED;
     }
+    return ResponseKind::UNKNOWN;
 }
@@ -1,25 +1,268 @@
 #pragma once
+#include <FloodOptions.h>
+#include <LatencyHistogram.h>
+#include <ResponseKind.h>
+#include <Workload.h>
+#include <algorithm>
+#include <array>
 #include <atomic>
-#include <thread>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <netinet/in.h>
 
+/**
+ * @brief Счетчики рабочего потока за окно измерения
+ */
+struct FloodWorkerStats {
+    uint64_t sent = 0;                      // Отправлено запросов после прогрева
+    uint64_t warmupSent = 0;                // Отправлено запросов во время прогрева
+    uint64_t sendErrors = 0;                // Ошибки отправки
+    std::chrono::nanoseconds maxLag{0};     // Максимальное отставание отправки от расписания
+    uint64_t received = 0;                  // Получено ответов на запросы окна измерения
+    uint64_t late = 0;                      // Ответы окна измерения позже responseTimeoutMs (считаются потерянными)
+    uint64_t overwritten = 0;               // Запросы окна измерения, чей слот занят новым запросом до срока ответа
+    uint64_t unmatched = 0;                 // Ответы без ожидающего запроса (на вытесненные или чужие запросы)
+    std::array<uint64_t, RESPONSE_KIND_COUNT> responses{}; // Ответы окна измерения по видам
 
-class PgwClient;
+    /**
+     * @brief Потерянные запросы окна измерения
+     *
+     * Потерян запрос без ответа за responseTimeoutMs от запланированной отправки (включая опоздавшие);
+     * запросы с вытесненным из кольца слотом имеют неизвестный исход и в потери не входят
+     */
+    [[nodiscard]] uint64_t lost() const { return sent - std::min(received + overwritten, sent); }
+
+    /**
+     * @brief Доля потерянных запросов от отправленных
+     */
+    [[nodiscard]] double lossRatio() const {
+        return sent > 0 ? static_cast<double>(lost()) / static_cast<double>(sent) : 0.0;
+    }
+};
 
+/**
+ * @brief Рабочий поток нагрузочного клиента
+ *
+ * Отправляет запросы по расписанию открытой нагрузки: момент следующего запроса
+ * отсчитывается от запланированного момента предыдущего, а не от фактической
+ * отправки, поэтому задержки отправки не снижают среднюю частоту (отставание
+ * наверстывается) и учитываются в maxLag.
+ *
+ * Поток приема на том же сокете сопоставляет ответы с запросами по номеру из
+ * заголовка версии 2. Запланированное время каждого запроса хранится в кольце
+ * слотов, индексируемом номером запроса; задержка отсчитывается от
+ * запланированного, а не фактического момента отправки, поэтому отставание
+ * генератора не скрывает задержки сервера (coordinated omission).
+ * Запрос считается потерянным, если ответ не пришел в течение responseTimeoutMs
+ * от запланированного момента отправки: более поздние ответы учитываются в late,
+ * а после остановки отправки прием продолжается столько же.
+ *
+ * Кольцо рассчитано на запросы, ожидающие ответа в течение responseTimeoutMs
+ * при заданной частоте (с запасом, не больше пространства номеров). Если слот
+ * занимает новый запрос раньше, чем истек срок ответа на старый, исход старого
+ * неизвестен: он учитывается в overwritten, а не в потерях.
+ *
+ * В режиме blast IMSI кодируются заранее в кольцо PACKET_RING_SIZE пакетов
+ * (выборка из модели нагрузки на момент начала, без смены IMSI со временем), а
+ * запросы уходят пачками sendmmsg: заголовок и BCD из кольца передаются двумя
+ * iovec без копирования и выделений памяти. Пачка набирается из запросов,
+ * чье время по расписанию уже наступило. Сокеты потока (разные порты
+ * источника) чередуются по пачкам, чтобы сервер распределял их по своим
+ * потокам; прием со всех сокетов идет через epoll и recvmmsg.
+ */
 class FloodWorker {
 public:
-    FloodWorker(int id);
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Создает рабочий поток
+     * @param id Номер потока
+     * @param options Параметры нагрузки
+     * @param server Адрес сервера
+     * @param initialSequence Номер первого запроса (берутся младшие 24 бита)
+     */
+    FloodWorker(int id, const FloodOptions& options, const sockaddr_in& server, uint32_t initialSequence = 0);
     ~FloodWorker();
 
-    void start();
+    FloodWorker(const FloodWorker&) = delete;
+    FloodWorker& operator=(const FloodWorker&) = delete;
+
+    /**
+     * @brief Открывает сокеты и заполняет кольцо пакетов режима blast
+     * @return true если сокеты открыты
+     */
+    bool prepare();
+
+    /**
+     * @brief Запускает потоки отправки и приема (после prepare)
+     * @param startTime Общий для всех потоков момент начала (от него отсчитываются прогрев и длительность)
+     */
+    void start(Clock::time_point startTime);
+
+    /**
+     * @brief Останавливает отправку (прием завершится после ожидания ответов)
+     */
     void stop();
     void join();
 
+    /**
+     * @brief Проверяет, завершили ли работу потоки отправки и приема
+     */
+    [[nodiscard]] bool isFinished() const { return _receiverFinished.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Возвращает общее число отправленных запросов (для вывода прогресса)
+     */
+    [[nodiscard]] uint64_t sentCount() const { return _sentCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает гистограмму задержек окна измерения (можно читать во время работы)
+     */
+    [[nodiscard]] const LatencyHistogram& latency() const { return _latency; }
+
+    /**
+     * @brief Возвращает счетчики (читать после join)
+     */
+    [[nodiscard]] const FloodWorkerStats& stats() const { return _stats; }
+
+    static constexpr size_t HEADER_SIZE = 4;                // Заголовок версии 2 с номером запроса
+    static constexpr size_t IMSI_BYTES = 8;                 // IMSI в BCD
+    static constexpr size_t PACKET_SIZE = HEADER_SIZE + IMSI_BYTES;
+    static constexpr size_t PACKET_RING_SIZE = 1 << 16;     // Заранее закодированных IMSI в режиме blast (степень двойки)
+    static constexpr uint32_t SEQUENCE_MASK = 0xFFFFFF;     // Номер запроса занимает 24 бита
+    static constexpr size_t MIN_IN_FLIGHT_SLOTS = 1 << 16;  // Слотов ожидающих запросов при низкой или неограниченной частоте
+    static constexpr size_t MAX_IN_FLIGHT_SLOTS = size_t{SEQUENCE_MASK} + 1; // Больше слотов, чем номеров, не нужно
+    static constexpr double IN_FLIGHT_HEADROOM = 2.0;       // Запас кольца к rate * responseTimeoutMs (всплески Пуассона)
+
+    /**
+     * @brief Возвращает размер кольца ожидающих запросов для параметров нагрузки
+     * @param options Параметры нагрузки
+     * @return Степень двойки от MIN_IN_FLIGHT_SLOTS до MAX_IN_FLIGHT_SLOTS
+     */
+    static size_t inFlightSlotsFor(const FloodOptions& options);
+
 private:
     void run();
+    void receive();
+
+    /**
+     * @brief Отправляет запросы по одному в момент, заданный расписанием
+     */
+    void runScheduled();
+
+    /**
+     * @brief Отправляет запросы пачками sendmmsg из кольца готовых пакетов
+     */
+    void runBlast();
+
+    /**
+     * @brief Заполняет кольцо закодированными IMSI для режима blast
+     */
+    void buildRing();
+
+    /**
+     * @brief Закрепляет текущий поток за ядром номер _id по модулю числа ядер
+     */
+    void pinToCpu() const;
+
+    /**
+     * @brief Публикует запланированное время запроса для сопоставления с ответом
+     * @param sequence Номер запроса
+     * @param scheduled Запланированный момент отправки
+     */
+    void trackRequest(uint32_t sequence, Clock::time_point scheduled);
+
+    /**
+     * @brief Возвращает запланированное время отправки запроса из записи слота
+     * @param entry Запись слота (не EMPTY_SLOT)
+     */
+    Clock::time_point scheduledAt(uint64_t entry) const;
+
+    /**
+     * @brief Учитывает успешно отправленный запрос в счетчиках окна измерения
+     * @param scheduled Запланированный момент отправки
+     * @param sentAt Фактический момент отправки
+     */
+    void recordSent(Clock::time_point scheduled, Clock::time_point sentAt);
+
+    /**
+     * @brief Возвращает интервал до следующего запроса по расписанию
+     */
+    Clock::duration nextInterval();
+
+    /**
+     * @brief Ожидает запланированного момента отправки
+     * @param when Момент отправки
+     */
+    void waitUntil(Clock::time_point when) const;
+
+    /**
+     * @brief Обрабатывает ответ сервера
+     * @param buffer Данные ответа
+     * @param length Длина ответа
+     * @param receivedAt Время получения
+     */
+    void handleResponse(const char* buffer, size_t length, Clock::time_point receivedAt);
+
+    /**
+     * @brief Определяет вид ответа по телу после заголовка
+     */
+    static ResponseKind classifyResponse(const char* payload, size_t length);
+
+    /**
+     * @brief Кодирует заголовок версии 2
+     * @param sequence Номер запроса (24 бита)
+     * @param header Буфер на HEADER_SIZE байт
+     */
+    static void encodeHeader(uint32_t sequence, char* header);
+
+    /**
+     * @brief Кодирует IMSI в BCD
+     * @param imsi IMSI (15 цифр)
+     * @param bcd Буфер на IMSI_BYTES байт
+     */
+    static void encodeImsi(const std::string& imsi, char* bcd);
+
+    /**
+     * @brief Кодирует запрос с заголовком версии 2 и номером запроса
+     * @param imsi IMSI (15 цифр)
+     * @param sequence Номер запроса (24 бита)
+     * @param packet Буфер на PACKET_SIZE байт
+     */
+    static void encodePacket(const std::string& imsi, uint32_t sequence, char* packet);
 
     int _id;
-    std::atomic<bool> _running;
+    FloodOptions _options;
+    sockaddr_in _server;
+    uint32_t _initialSequence;                  // Номер первого запроса
+    std::vector<int> _sockets;
+    Clock::time_point _startTime;
+    Clock::time_point _measureStart;            // Конец прогрева
+    Clock::time_point _measureEnd;              // Конец окна измерения (при заданной длительности)
+    std::atomic<bool> _running{false};
+    std::atomic<bool> _senderFinished{false};
+    std::atomic<bool> _receiverFinished{false};
+    std::atomic<int64_t> _senderFinishedAtNs{0};
+    std::atomic<uint64_t> _sentCount{0};
+    FloodWorkerStats _stats;
+    LatencyHistogram _latency;
+
+    // Слот хранит номер запроса (младшие 24 бита) и запланированное время отправки
+    // от начала в единицах 64 нс (старшие 40 бит, ~19 часов); EMPTY_SLOT - нет ожидающего запроса
+    static constexpr uint64_t EMPTY_SLOT = ~0ULL;
+    static constexpr int TIME_SHIFT = 6;
+    size_t _inFlightSlots;                      // Размер кольца ожидающих запросов (степень двойки)
+    std::unique_ptr<std::atomic<uint64_t>[]> _inFlight;
+    std::vector<char> _ring;                    // Закодированные IMSI режима blast, PACKET_RING_SIZE * IMSI_BYTES
+
+    std::mt19937_64 _random;
+    std::exponential_distribution<double> _exponential;
+    Workload _workload;                         // Выбор IMSI запросов
     std::thread _thread;
-    std::unique_ptr<PgwClient> _client;
+    std::thread _receiverThread;
 };
@@ -0,0 +1,87 @@
+#include <LatencyHistogram.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+LatencyHistogram::LatencyHistogram()
+    : _buckets(std::make_unique<std::atomic<uint64_t>[]>(BUCKET_COUNT)) {
+    reset();
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value) {
+    value = std::min(value, 2 * MAX_VALUE_NS - 1);
+    if (value < 2 * SUB_BUCKETS) {
+        return static_cast<size_t>(value);
+    }
+    // Старшие SUB_BUCKET_BITS + 1 бит значения: октава и корзина внутри нее
+    int msb = std::bit_width(value) - 1;
+    uint64_t top = value >> (msb - SUB_BUCKET_BITS);
+    return static_cast<size_t>((msb - SUB_BUCKET_BITS) * SUB_BUCKETS + top);
+}
+
+uint64_t LatencyHistogram::bucketUpperValue(size_t index) {
+    if (index < 2 * SUB_BUCKETS) {
+        return index;
+    }
+    int msb = static_cast<int>(index / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+    uint64_t top = index % SUB_BUCKETS + SUB_BUCKETS;
+    int shift = msb - SUB_BUCKET_BITS;
+    return ((top + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t valueNs) {
+    add(_buckets[bucketIndex(valueNs)], 1);
+    add(_sum, valueNs);
+    if (valueNs > _max.load(std::memory_order_relaxed)) {
+        _max.store(valueNs, std::memory_order_relaxed);
+    }
+    // Счетчик публикуется последним: после acquire-загрузки count() корзины содержат не меньше значений
+    add(_count, 1, std::memory_order_release);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    uint64_t merged = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        uint64_t value = other._buckets[i].load(std::memory_order_relaxed);
+        if (value != 0) {
+            add(_buckets[i], value);
+            merged += value;
+        }
+    }
+    add(_count, merged, std::memory_order_release);
+    add(_sum, other._sum.load(std::memory_order_relaxed));
+    _max.store(std::max(max(), other.max()), std::memory_order_relaxed);
+}
+
+void LatencyHistogram::reset() {
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        _buckets[i].store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+    auto target = static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(total)));
+    target = std::max<uint64_t>(target, 1);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += _buckets[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            // Верхняя граница корзины не превышает фактический максимум
+            return std::min(bucketUpperValue(i), max());
+        }
+    }
+    return max();
+}
+
+double LatencyHistogram::mean() const {
+    uint64_t total = count();
+    return total == 0 ? 0.0 : static_cast<double>(_sum.load(std::memory_order_relaxed)) / static_cast<double>(total);
+}
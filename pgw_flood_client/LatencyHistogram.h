@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Гистограмма задержек в стиле HDR Histogram
+ *
+ * Логарифмически-линейные корзины: значения до 256 нс хранятся точно, далее каждая
+ * октава делится на 128 корзин, поэтому относительная погрешность перцентилей
+ * не превышает 1/128 (~0.8%) во всем диапазоне до MAX_VALUE_NS. Запись - одна
+ * корзина без выделений памяти. Пишет один поток (relaxed load/store), а
+ * читать и сливать гистограмму можно параллельно с записью - читатель видит
+ * согласованный с точностью до последних записей снимок. Счетчик значений
+ * публикуется release-записью после корзин и читается acquire-загрузкой до них,
+ * поэтому в корзинах читатель видит не меньше значений, чем в count().
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint64_t MAX_VALUE_NS = 1ULL << 40;   // Верхняя граница (~18 минут), большие значения насыщаются
+    static constexpr int SUB_BUCKET_BITS = 7;                                   // log2 корзин на октаву
+    static constexpr uint64_t SUB_BUCKETS = 1ULL << SUB_BUCKET_BITS;            // Корзин на октаву
+    static constexpr int MAX_MSB = 40;                                          // Старший бит MAX_VALUE_NS
+    static constexpr size_t BUCKET_COUNT = (MAX_MSB - SUB_BUCKET_BITS) * SUB_BUCKETS + 2 * SUB_BUCKETS;
+
+    LatencyHistogram();
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    /**
+     * @brief Записывает значение (вызывается только потоком-владельцем)
+     * @param valueNs Задержка в наносекундах
+     */
+    void record(uint64_t valueNs);
+
+    /**
+     * @brief Добавляет к гистограмме содержимое другой (потокобезопасно относительно записи в other)
+     * @param other Гистограмма-источник
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Обнуляет гистограмму (нельзя вызывать параллельно с записью)
+     */
+    void reset();
+
+    /**
+     * @brief Возвращает значение перцентиля
+     * @param percentile Перцентиль в диапазоне 0..100
+     * @return Наибольшее значение, эквивалентное корзине перцентиля, нс (0 для пустой гистограммы)
+     */
+    [[nodiscard]] uint64_t valueAtPercentile(double percentile) const;
+
+    [[nodiscard]] uint64_t count() const { return _count.load(std::memory_order_acquire); }
+    [[nodiscard]] uint64_t max() const { return _max.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Возвращает среднее значение, нс
+     */
+    [[nodiscard]] double mean() const;
+
+    /**
+     * @brief Возвращает номер корзины значения
+     * @param value Значение, нс (больше 2 * MAX_VALUE_NS - 1 попадают в последнюю корзину)
+     * @return Номер корзины меньше BUCKET_COUNT
+     */
+    static size_t bucketIndex(uint64_t value);
+
+    /**
+     * @brief Возвращает наибольшее значение корзины
+     * @param index Номер корзины
+     */
+    static uint64_t bucketUpperValue(size_t index);
+
+private:
+    /**
+     * @brief Прибавляет значение к счетчику единственного писателя без атомарной операции чтения-записи
+     */
+    static void add(std::atomic<uint64_t>& counter, uint64_t value,
+                    std::memory_order order = std::memory_order_relaxed) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, order);
+    }
+
+    std::unique_ptr<std::atomic<uint64_t>[]> _buckets;  // Счетчики корзин
+    std::atomic<uint64_t> _count{0};                    // Количество значений
+    std::atomic<uint64_t> _sum{0};                      // Сумма значений для среднего
+    std::atomic<uint64_t> _max{0};                      // Максимальное значение
+};
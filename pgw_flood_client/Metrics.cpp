@@ -3,6 +3,12 @@ using namespace prometheus;
 
 std::shared_ptr<Registry> Metrics::registry_;
 Counter* Metrics::requests_counter_ = nullptr;
+std::array<Counter*, RESPONSE_KIND_COUNT> Metrics::responses_counters_{};
+Gauge* Metrics::latency_p50_ = nullptr;
+Gauge* Metrics::latency_p99_ = nullptr;
+Gauge* Metrics::latency_p999_ = nullptr;
+Gauge* Metrics::latency_max_ = nullptr;
+Gauge* Metrics::loss_ratio_ = nullptr;
 
 void Metrics::init(int port) {
     static Exposer exposer{"0.0.0.0:" + std::to_string(port)};
@@ -14,11 +20,57 @@ void Metrics::init(int port) {
         .Register(*registry_);
     requests_counter_ = &fam.Add({});
 
+    auto& responses = BuildCounter()
+        .Name("pgw_flood_responses_total")
+        .Help("Responses to measured requests by result")
+        .Register(*registry_);
+    for (size_t i = 0; i < RESPONSE_KIND_COUNT; ++i) {
+        responses_counters_[i] = &responses.Add({{"result", responseKindName(static_cast<ResponseKind>(i))}});
+    }
+
+    auto& latency = BuildGauge()
+        .Name("pgw_flood_latency_seconds")
+        .Help("Request latency from the scheduled send time")
+        .Register(*registry_);
+    latency_p50_ = &latency.Add({{"quantile", "0.5"}});
+    latency_p99_ = &latency.Add({{"quantile", "0.99"}});
+    latency_p999_ = &latency.Add({{"quantile", "0.999"}});
+    latency_max_ = &latency.Add({{"quantile", "1"}});
+
+    loss_ratio_ = &BuildGauge()
+        .Name("pgw_flood_loss_ratio")
+        .Help("Fraction of measured requests left without a response")
+        .Register(*registry_)
+        .Add({});
+
     exposer.RegisterCollectable(registry_);
 }
 
-void Metrics::incRequests() {
+void Metrics::incRequests(double count) {
     if (requests_counter_) {
-        requests_counter_->Increment();
+        requests_counter_->Increment(count);
+    }
+}
+
+void Metrics::incResponses(ResponseKind kind) {
+    if (auto* counter = responses_counters_[static_cast<size_t>(kind)]) {
+        counter->Increment();
+    }
+}
+
+void Metrics::setLatency(const LatencyHistogram& histogram) {
+    if (!latency_p50_) {
+        return;
     }
-}
\ No newline at end of file
+    constexpr double NS_PER_SECOND = 1e9;
+    latency_p50_->Set(static_cast<double>(histogram.valueAtPercentile(50.0)) / NS_PER_SECOND);
+    latency_p99_->Set(static_cast<double>(histogram.valueAtPercentile(99.0)) / NS_PER_SECOND);
+    latency_p999_->Set(static_cast<double>(histogram.valueAtPercentile(99.9)) / NS_PER_SECOND);
+    latency_max_->Set(static_cast<double>(histogram.max()) / NS_PER_SECOND);
+}
+
+void Metrics::setLossRatio(double ratio) {
+    if (loss_ratio_) {
+        loss_ratio_->Set(ratio);
+    }
+}
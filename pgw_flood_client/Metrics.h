@@ -1,14 +1,47 @@
 #pragma once
+#include <LatencyHistogram.h>
+#include <ResponseKind.h>
+#include <array>
 #include <memory>
 #include <prometheus/registry.h>
 #include <prometheus/counter.h>
+#include <prometheus/gauge.h>
 #include <prometheus/exposer.h>
 
 class Metrics {
 public:
     static void init(int port = 9100);
-    static void incRequests();
+
+    /**
+     * @brief Учитывает отправленные запросы
+     * @param count Количество запросов
+     */
+    static void incRequests(double count = 1.0);
+
+    /**
+     * @brief Учитывает полученный ответ
+     * @param kind Вид ответа
+     */
+    static void incResponses(ResponseKind kind);
+
+    /**
+     * @brief Обновляет перцентили задержки по сводной гистограмме
+     * @param histogram Гистограмма задержек всех потоков
+     */
+    static void setLatency(const LatencyHistogram& histogram);
+
+    /**
+     * @brief Устанавливает долю потерянных запросов окна измерения
+     * @param ratio Доля в диапазоне 0..1
+     */
+    static void setLossRatio(double ratio);
 private:
     static std::shared_ptr<prometheus::Registry> registry_;
     static prometheus::Counter* requests_counter_;
-};
\ No newline at end of file
+    static std::array<prometheus::Counter*, RESPONSE_KIND_COUNT> responses_counters_;
+    static prometheus::Gauge* latency_p50_;
+    static prometheus::Gauge* latency_p99_;
+    static prometheus::Gauge* latency_p999_;
+    static prometheus::Gauge* latency_max_;
+    static prometheus::Gauge* loss_ratio_;
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief Вид ответа сервера
+ */
+enum class ResponseKind : size_t {
+    CREATED,                // Сессия создана (текстовый "created" или бинарный код 0)
+    REFRESHED,              // Сессия продлена (бинарный код 1)
+    REJECTED_BLACKLIST,     // IMSI в черном списке (бинарный код 2)
+    REJECTED_RATE_LIMIT,    // Превышен лимит запросов (бинарный код 3)
+    ERROR,                  // Ошибка сервера (бинарный код 4)
+    INVALID_REQUEST,        // Некорректный запрос (бинарный код 5)
+    REJECTED,               // Текстовый "rejected" без уточнения причины
+    UNKNOWN,                // Нераспознанный ответ
+    COUNT
+};
+
+constexpr size_t RESPONSE_KIND_COUNT = static_cast<size_t>(ResponseKind::COUNT);
+
+/**
+ * @brief Возвращает имя вида ответа для отчета и меток метрик
+ * @param kind Вид ответа
+ * @return Имя в нижнем регистре
+ */
+constexpr const char* responseKindName(ResponseKind kind) {
+    switch (kind) {
+        case ResponseKind::CREATED: return "created";
+        case ResponseKind::REFRESHED: return "refreshed";
+        case ResponseKind::REJECTED_BLACKLIST: return "rejected_blacklist";
+        case ResponseKind::REJECTED_RATE_LIMIT: return "rejected_rate_limit";
+        case ResponseKind::ERROR: return "error";
+        case ResponseKind::INVALID_REQUEST: return "invalid_request";
+        case ResponseKind::REJECTED: return "rejected";
+        default: return "unknown";
+    }
+}
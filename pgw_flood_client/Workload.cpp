@@ -0,0 +1,115 @@
+#include <Workload.h>
+#include <ImsiGenerator.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr uint64_t IMSI_NUMBER_RANGE = 10000000000ULL;  // 10 цифр после IMSI_PREFIX
+
+/**
+ * @brief log1p(x) / x с устойчивостью около нуля
+ */
+double log1pOverX(double x) {
+    return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+/**
+ * @brief expm1(x) / x с устойчивостью около нуля
+ */
+double expm1OverX(double x) {
+    return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+/**
+ * @brief Перемешивает биты (SplitMix64) для фазы смены IMSI абонента
+ */
+uint64_t mix(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ULL;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
+
+} // namespace
+
+ZipfDistribution::ZipfDistribution(uint64_t n, double exponent)
+    : _n(std::max<uint64_t>(n, 1)),
+      _exponent(exponent),
+      _hIntegralX1(hIntegral(1.5) - 1.0),
+      _hIntegralN(hIntegral(static_cast<double>(_n) + 0.5)),
+      _s(2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0))) {}
+
+double ZipfDistribution::h(double x) const {
+    return std::exp(-_exponent * std::log(x));
+}
+
+double ZipfDistribution::hIntegral(double x) const {
+    double logX = std::log(x);
+    return expm1OverX((1.0 - _exponent) * logX) * logX;
+}
+
+double ZipfDistribution::hIntegralInverse(double x) const {
+    double t = std::max(x * (1.0 - _exponent), -1.0);
+    return std::exp(log1pOverX(t) * x);
+}
+
+uint64_t ZipfDistribution::operator()(std::mt19937_64& random) const {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    while (true) {
+        double u = _hIntegralN + uniform(random) * (_hIntegralX1 - _hIntegralN);
+        double x = hIntegralInverse(u);
+        auto k = static_cast<uint64_t>(std::clamp(x + 0.5, 1.0, static_cast<double>(_n)));
+        // Большинство выборок принимается сразу, остальные проверяются по точной площади ранга
+        if (static_cast<double>(k) - x <= _s || u >= hIntegral(static_cast<double>(k) + 0.5) - h(static_cast<double>(k))) {
+            return k;
+        }
+    }
+}
+
+Workload::Workload(const WorkloadOptions& options, uint64_t seed)
+    : _options(options),
+      _random(seed),
+      _subscriber(0, std::max<uint64_t>(options.population, 1) - 1),
+      _blacklistEntry(0, options.blacklist.empty() ? 0 : options.blacklist.size() - 1),
+      _zipf(options.population, options.zipfExponent),
+      _imsi(IMSI_PREFIX) {
+    _imsi.resize(15, '0');
+}
+
+uint64_t Workload::sampleSubscriber() {
+    if (_options.profile == WorkloadProfile::ZIPF) {
+        return _zipf(_random) - 1;
+    }
+    return _subscriber(_random);
+}
+
+uint64_t Workload::generation(uint64_t subscriber, double elapsedSec) const {
+    if (_options.churnPerSec <= 0) {
+        return 0;
+    }
+    if (_options.churnPeriodSec > 0) {
+        elapsedSec = std::floor(elapsedSec / _options.churnPeriodSec) * _options.churnPeriodSec;
+    }
+    // Фаза абонента равномерна на [0, 1): за секунду поколение меняет доля churnPerSec популяции
+    double phase = static_cast<double>(mix(subscriber) >> 11) * 0x1.0p-53;
+    return static_cast<uint64_t>(elapsedSec * _options.churnPerSec + phase);
+}
+
+const std::string& Workload::next(std::chrono::duration<double> elapsed) {
+    if (!_options.blacklist.empty() && _options.blacklistRatio > 0 && _uniform(_random) < _options.blacklistRatio) {
+        return _options.blacklist[_blacklistEntry(_random)];
+    }
+    if (_options.profile == WorkloadProfile::RANDOM) {
+        _imsi = ImsiGenerator::generate();
+        return _imsi;
+    }
+
+    uint64_t subscriber = sampleSubscriber();
+    uint64_t number = (generation(subscriber, elapsed.count()) * _options.population + subscriber) % IMSI_NUMBER_RANGE;
+    for (size_t i = _imsi.size(); i > _imsi.size() - 10; --i) {
+        _imsi[i - 1] = static_cast<char>('0' + number % 10);
+        number /= 10;
+    }
+    return _imsi;
+}
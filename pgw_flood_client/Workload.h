@@ -0,0 +1,91 @@
+#pragma once
+#include <FloodOptions.h>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+
+/**
+ * @brief Распределение Ципфа на 1..n методом rejection-inversion (Hörmann, Derflinger)
+ *
+ * Выборка за O(1) в среднем без таблицы вероятностей, поэтому популяция может
+ * быть сколь угодно большой. Ранг 1 - самый популярный.
+ */
+class ZipfDistribution {
+public:
+    /**
+     * @brief Создает распределение
+     * @param n Количество рангов
+     * @param exponent Показатель (> 0)
+     */
+    ZipfDistribution(uint64_t n, double exponent);
+
+    /**
+     * @brief Возвращает случайный ранг из 1..n
+     * @param random Генератор случайных чисел
+     */
+    uint64_t operator()(std::mt19937_64& random) const;
+
+private:
+    double h(double x) const;
+    double hIntegral(double x) const;
+    double hIntegralInverse(double x) const;
+
+    uint64_t _n;
+    double _exponent;
+    double _hIntegralX1;    // hIntegral(1.5) - 1
+    double _hIntegralN;     // hIntegral(n + 0.5)
+    double _s;              // Порог быстрого принятия
+};
+
+/**
+ * @brief Модель абонентской нагрузки: выбирает IMSI очередного запроса
+ *
+ * Популяция - population абонентов с IMSI вида IMSI_PREFIX + 10 цифр.
+ * Абонент выбирается равновероятно или по Ципфу, так что популярные абоненты
+ * повторяются и проходят ветки продления сессии и ограничения частоты.
+ * Смена абонентов (churn) задается без общего состояния между потоками:
+ * каждый абонент получает новое поколение IMSI раз в 1/churnPerSec секунд со
+ * своим сдвигом фазы, а при churnPeriodSec > 0 время округляется до начала
+ * периода, и накопленная смена происходит одномоментно (массовое переподключение).
+ * Доля blacklistRatio запросов использует IMSI из черного списка.
+ * Экземпляр принадлежит одному потоку.
+ */
+class Workload {
+public:
+    static constexpr const char* IMSI_PREFIX = "25099";     // MCC/MNC популяции, не пересекается с тестовыми IMSI 00101...
+    static constexpr uint64_t MAX_POPULATION = 1000000000;  // Популяция и поколения укладываются в 10 цифр
+
+    /**
+     * @brief Создает модель нагрузки
+     * @param options Параметры модели
+     * @param seed Начальное значение генератора случайных чисел
+     */
+    Workload(const WorkloadOptions& options, uint64_t seed);
+
+    /**
+     * @brief Возвращает IMSI очередного запроса
+     * @param elapsed Время от начала нагрузки (определяет поколение IMSI абонентов)
+     * @return IMSI из 15 цифр; ссылка действительна до следующего вызова
+     */
+    const std::string& next(std::chrono::duration<double> elapsed);
+
+private:
+    /**
+     * @brief Возвращает индекс абонента в популяции
+     */
+    uint64_t sampleSubscriber();
+
+    /**
+     * @brief Возвращает поколение IMSI абонента на момент elapsedSec
+     */
+    uint64_t generation(uint64_t subscriber, double elapsedSec) const;
+
+    WorkloadOptions _options;
+    std::mt19937_64 _random;
+    std::uniform_real_distribution<double> _uniform{0.0, 1.0};
+    std::uniform_int_distribution<uint64_t> _subscriber;
+    std::uniform_int_distribution<size_t> _blacklistEntry;
+    ZipfDistribution _zipf;
+    std::string _imsi;  // Буфер результата next() без выделения памяти на запрос
+};
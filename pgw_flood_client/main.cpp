@@ -1,34 +1,290 @@
 #include <FloodManager.h>
+#include <FloodOptions.h>
 #include <iostream>
 #include <Metrics.h>
+#include <Workload.h>
 #include <atomic>
 #include <csignal>
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <getopt.h>
 
 std::atomic<bool> running{true};
 
+// Параметры модели нагрузки без короткой формы
+enum LongOption {
+    OPTION_PROFILE = 256,
+    OPTION_POPULATION,
+    OPTION_ZIPF,
+    OPTION_BLACKLIST,
+    OPTION_BLACKLIST_RATIO,
+    OPTION_CHURN,
+    OPTION_CHURN_PERIOD
+};
+
 void signal_handler(int) {
     running = false;
 }
 
-int main() {
+/**
+ * @brief Выводит справку по параметрам командной строки
+ * @param programName Имя программы
+ */
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n"
+              << "  -t, --threads N          worker threads (default 1)\n"
+              << "  -s, --server HOST[:PORT] target server (default 127.0.0.1:9000)\n"
+              << "  -r, --rate R             requests per second per worker, 0 - unlimited (default 1000)\n"
+              << "  -a, --arrival MODE       inter-arrival times: poisson or constant (default poisson)\n"
+              << "  -d, --duration S         measured duration in seconds, 0 - until SIGINT (default 0)\n"
+              << "  -w, --warmup S           warmup in seconds before measuring (default 0)\n"
+              << "  -m, --metrics-port P     Prometheus metrics port (default 9100)\n"
+              << "  -T, --timeout MS         response deadline; later replies count as lost, ms (default 1000)\n"
+              << "  -b, --blast              high-rate mode: pre-encoded packet ring and sendmmsg batches\n"
+              << "  -B, --batch N            packets per sendmmsg in blast mode (default 32, max 1024)\n"
+              << "  -S, --sockets N          connected sockets per worker (default 1)\n"
+              << "  -p, --pin                pin each worker's sender thread to a CPU\n"
+              << "      --profile NAME       IMSI workload: random, uniform or zipf (default random)\n"
+              << "      --population N       subscriber population for uniform/zipf (default 100000)\n"
+              << "      --zipf S             Zipf exponent for the zipf profile (default 0.99)\n"
+              << "      --blacklist LIST     comma-separated blacklisted IMSIs known to the server\n"
+              << "      --blacklist-ratio F  fraction of requests using blacklisted IMSIs (default 0)\n"
+              << "      --churn F            fraction of the population re-attaching with a new IMSI per second (default 0)\n"
+              << "      --churn-period S     apply churn in bursts at the start of each period, 0 - continuous (default 0)\n"
+              << "  -h, --help               show this help\n";
+}
+
+/**
+ * @brief Проверяет, что строка - IMSI из 15 цифр
+ * @param imsi Строка
+ * @return true если формат корректен
+ */
+bool isValidImsi(const std::string& imsi) {
+    return imsi.size() == 15 && std::all_of(imsi.begin(), imsi.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+/**
+ * @brief Разбирает параметры командной строки
+ * @param argc Количество аргументов
+ * @param argv Аргументы
+ * @param options Параметры для заполнения
+ * @return true если параметры корректны
+ */
+bool parseOptions(int argc, char* argv[], FloodOptions& options) {
+    static const option longOptions[] = {
+        {"threads", required_argument, nullptr, 't'},
+        {"server", required_argument, nullptr, 's'},
+        {"rate", required_argument, nullptr, 'r'},
+        {"arrival", required_argument, nullptr, 'a'},
+        {"duration", required_argument, nullptr, 'd'},
+        {"warmup", required_argument, nullptr, 'w'},
+        {"metrics-port", required_argument, nullptr, 'm'},
+        {"timeout", required_argument, nullptr, 'T'},
+        {"blast", no_argument, nullptr, 'b'},
+        {"batch", required_argument, nullptr, 'B'},
+        {"sockets", required_argument, nullptr, 'S'},
+        {"pin", no_argument, nullptr, 'p'},
+        {"profile", required_argument, nullptr, OPTION_PROFILE},
+        {"population", required_argument, nullptr, OPTION_POPULATION},
+        {"zipf", required_argument, nullptr, OPTION_ZIPF},
+        {"blacklist", required_argument, nullptr, OPTION_BLACKLIST},
+        {"blacklist-ratio", required_argument, nullptr, OPTION_BLACKLIST_RATIO},
+        {"churn", required_argument, nullptr, OPTION_CHURN},
+        {"churn-period", required_argument, nullptr, OPTION_CHURN_PERIOD},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+
+    try {
+        int opt;
+        while ((opt = getopt_long(argc, argv, "t:s:r:a:d:w:m:T:bB:S:ph", longOptions, nullptr)) != -1) {
+            switch (opt) {
+                case 't':
+                    options.threads = std::stoi(optarg);
+                    break;
+                case 's': {
+                    std::string server = optarg;
+                    auto colon = server.rfind(':');
+                    options.serverHost = server.substr(0, colon);
+                    if (colon != std::string::npos) {
+                        options.serverPort = static_cast<uint16_t>(std::stoul(server.substr(colon + 1)));
+                    }
+                    break;
+                }
+                case 'r':
+                    options.ratePerWorker = std::stod(optarg);
+                    break;
+                case 'a':
+                    if (std::string(optarg) == "poisson") {
+                        options.arrival = ArrivalProcess::POISSON;
+                    } else if (std::string(optarg) == "constant") {
+                        options.arrival = ArrivalProcess::CONSTANT;
+                    } else {
+                        std::cerr << "Error: Unknown arrival mode: " << optarg << "\n";
+                        return false;
+                    }
+                    break;
+                case 'd':
+                    options.durationSec = std::stod(optarg);
+                    break;
+                case 'w':
+                    options.warmupSec = std::stod(optarg);
+                    break;
+                case 'm':
+                    options.metricsPort = std::stoi(optarg);
+                    break;
+                case 'T':
+                    options.responseTimeoutMs = std::stoi(optarg);
+                    break;
+                case 'b':
+                    options.blast = true;
+                    break;
+                case 'B':
+                    options.batchSize = std::stoi(optarg);
+                    break;
+                case 'S':
+                    options.socketsPerWorker = std::stoi(optarg);
+                    break;
+                case 'p':
+                    options.pinCpu = true;
+                    break;
+                case OPTION_PROFILE:
+                    if (std::string(optarg) == "random") {
+                        options.workload.profile = WorkloadProfile::RANDOM;
+                    } else if (std::string(optarg) == "uniform") {
+                        options.workload.profile = WorkloadProfile::UNIFORM;
+                    } else if (std::string(optarg) == "zipf") {
+                        options.workload.profile = WorkloadProfile::ZIPF;
+                    } else {
+                        std::cerr << "Error: Unknown workload profile: " << optarg << "\n";
+                        return false;
+                    }
+                    break;
+                case OPTION_POPULATION:
+                    options.workload.population = std::stoull(optarg);
+                    break;
+                case OPTION_ZIPF:
+                    options.workload.zipfExponent = std::stod(optarg);
+                    break;
+                case OPTION_BLACKLIST: {
+                    std::stringstream list(optarg);
+                    std::string imsi;
+                    while (std::getline(list, imsi, ',')) {
+                        if (!isValidImsi(imsi)) {
+                            std::cerr << "Error: Invalid blacklist IMSI: " << imsi << "\n";
+                            return false;
+                        }
+                        options.workload.blacklist.push_back(imsi);
+                    }
+                    break;
+                }
+                case OPTION_BLACKLIST_RATIO:
+                    options.workload.blacklistRatio = std::stod(optarg);
+                    break;
+                case OPTION_CHURN:
+                    options.workload.churnPerSec = std::stod(optarg);
+                    break;
+                case OPTION_CHURN_PERIOD:
+                    options.workload.churnPeriodSec = std::stod(optarg);
+                    break;
+                default:
+                    return false;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Error: Invalid numeric argument\n";
+        return false;
+    }
+
+    if (options.threads <= 0 || options.serverHost.empty() || options.serverPort == 0 ||
+        options.ratePerWorker < 0 || options.durationSec < 0 || options.warmupSec < 0 ||
+        options.responseTimeoutMs < 0 || options.socketsPerWorker <= 0 ||
+        options.batchSize <= 0 || options.batchSize > MAX_BATCH_SIZE) {
+        std::cerr << "Error: Invalid option value\n";
+        return false;
+    }
+
+    const auto& workload = options.workload;
+    if (workload.population == 0 || workload.population > Workload::MAX_POPULATION || workload.zipfExponent < 0 ||
+        workload.blacklistRatio < 0 || workload.blacklistRatio > 1 || workload.churnPerSec < 0 ||
+        workload.churnPeriodSec < 0) {
+        std::cerr << "Error: Invalid workload option value\n";
+        return false;
+    }
+    if (workload.blacklistRatio > 0 && workload.blacklist.empty()) {
+        std::cerr << "Error: --blacklist-ratio requires --blacklist\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    FloodOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
 
     std::signal(SIGTERM, signal_handler);
     std::signal(SIGINT, signal_handler);
 
-    const int threadCount = 1;
+    Metrics::init(options.metricsPort);
+    std::cout << "Starting IMSI flooder with " << options.threads << " threads against "
+              << options.serverHost << ":" << options.serverPort << ", ";
+    if (options.ratePerWorker > 0) {
+        std::cout << options.ratePerWorker << " req/s per worker ("
+                  << (options.arrival == ArrivalProcess::POISSON ? "poisson" : "constant") << ")\n";
+    } else {
+        std::cout << "unlimited rate\n";
+    }
+    if (options.blast) {
+        std::cout << "Blast mode: " << options.socketsPerWorker << " sockets per worker, batches of "
+                  << options.batchSize << (options.pinCpu ? ", pinned to CPUs" : "") << "\n";
+    }
+    static const char* PROFILE_NAMES[] = {"random", "uniform", "zipf"};
+    std::cout << "Workload: " << PROFILE_NAMES[static_cast<int>(options.workload.profile)];
+    if (options.workload.profile != WorkloadProfile::RANDOM) {
+        std::cout << ", population " << options.workload.population;
+        if (options.workload.profile == WorkloadProfile::ZIPF) {
+            std::cout << ", exponent " << options.workload.zipfExponent;
+        }
+        std::cout << ", churn " << options.workload.churnPerSec << "/s";
+        if (options.workload.churnPeriodSec > 0) {
+            std::cout << " in bursts every " << options.workload.churnPeriodSec << " s";
+        }
+    }
+    if (options.workload.blacklistRatio > 0) {
+        std::cout << ", blacklist ratio " << options.workload.blacklistRatio;
+    }
+    std::cout << "\n";
 
-    Metrics::init(9100);
-    std::cout << "Starting IMSI flooder with " << threadCount << " threads...\n";
-    FloodManager manager(threadCount);
-    manager.start();
+    FloodManager manager(options);
+    if (!manager.start()) {
+        std::cerr << "Error: Failed to start workers\n";
+        return 1;
+    }
 
-    std::cout << "Flooder running. Send SIGTERM or SIGINT to stop.\n";
-    while (running) {
+    if (options.durationSec > 0) {
+        std::cout << "Flooder running for " << options.warmupSec << " s warmup + " << options.durationSec << " s.\n";
+    } else {
+        std::cout << "Flooder running. Send SIGTERM or SIGINT to stop.\n";
+    }
+
+    uint64_t lastSent = 0;
+    while (running && !manager.isFinished()) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
+        uint64_t sent = manager.sentCount();
+        std::cout << "Sent: " << sent - lastSent << " IMSI/s\n";
+        lastSent = sent;
+        manager.publishLatency();
     }
 
     manager.stop();
+    manager.printSummary(std::cout);
 
     std::cout << "Flooding finished.\n";
     return 0;
-}
\ No newline at end of file
+}
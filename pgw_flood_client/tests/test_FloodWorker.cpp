@@ -0,0 +1,285 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include "../FloodWorker.h"
+
+using namespace std::chrono;
+
+/**
+ * @brief Запрос, принятый тестовым UDP-ответчиком
+ */
+struct ReceivedRequest {
+    uint32_t sequence = 0;          // Номер запроса из заголовка версии 2
+    struct sockaddr_in from{};      // Адрес рабочего потока
+};
+
+class FloodWorkerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Ответчик на loopback с портом, выбранным ядром
+        responderSocket = socket(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_GE(responderSocket, 0);
+
+        server.sin_family = AF_INET;
+        server.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        server.sin_port = 0;
+        ASSERT_EQ(bind(responderSocket, reinterpret_cast<struct sockaddr*>(&server), sizeof(server)), 0);
+
+        socklen_t addrLen = sizeof(server);
+        ASSERT_EQ(getsockname(responderSocket, reinterpret_cast<struct sockaddr*>(&server), &addrLen), 0);
+
+        // Постоянная частота и короткое окно измерения без прогрева
+        options.ratePerWorker = 20.0;
+        options.arrival = ArrivalProcess::CONSTANT;
+        options.durationSec = 0.5;
+        options.responseTimeoutMs = 300;
+    }
+
+    void TearDown() override {
+        if (responderSocket >= 0) {
+            close(responderSocket);
+        }
+    }
+
+    /**
+     * @brief Принимает запрос рабочего потока
+     * @param request Принятый запрос
+     * @param timeoutMs Ожидание запроса, мс
+     * @return true если получен запрос с заголовком версии 2
+     */
+    bool receiveRequest(ReceivedRequest& request, int timeoutMs) const {
+        struct pollfd fds[1];
+        fds[0].fd = responderSocket;
+        fds[0].events = POLLIN;
+        if (poll(fds, 1, timeoutMs) <= 0) {
+            return false;
+        }
+
+        uint8_t buffer[64];
+        socklen_t fromLen = sizeof(request.from);
+        ssize_t bytesRead = recvfrom(responderSocket, buffer, sizeof(buffer), 0,
+                                     reinterpret_cast<struct sockaddr*>(&request.from), &fromLen);
+        if (bytesRead != static_cast<ssize_t>(FloodWorker::PACKET_SIZE) || buffer[0] != 0x02) {
+            return false;
+        }
+        request.sequence = (static_cast<uint32_t>(buffer[1]) << 16) |
+                           (static_cast<uint32_t>(buffer[2]) << 8) |
+                           static_cast<uint32_t>(buffer[3]);
+        return true;
+    }
+
+    /**
+     * @brief Отправляет ответ с заголовком версии 2
+     * @param to Адрес рабочего потока
+     * @param sequence Номер запроса
+     * @param payload Тело ответа (текст или бинарный код)
+     */
+    void reply(const struct sockaddr_in& to, uint32_t sequence, const std::string& payload) const {
+        std::string packet;
+        packet.push_back(static_cast<char>(0x02));
+        packet.push_back(static_cast<char>(sequence >> 16));
+        packet.push_back(static_cast<char>(sequence >> 8));
+        packet.push_back(static_cast<char>(sequence));
+        packet += payload;
+        sendRaw(to, packet);
+    }
+
+    /**
+     * @brief Отправляет датаграмму как есть
+     */
+    void sendRaw(const struct sockaddr_in& to, const std::string& packet) const {
+        sendto(responderSocket, packet.data(), packet.size(), 0,
+               reinterpret_cast<const struct sockaddr*>(&to), sizeof(to));
+    }
+
+    /**
+     * @brief Запускает рабочий поток и отвечает на его запросы до завершения приема
+     * @param worker Подготовленный рабочий поток
+     * @param onRequest Обработчик запроса с его порядковым номером
+     * @param onIdle Вызывается между запросами (для отложенных ответов)
+     * @return Принятые запросы в порядке получения
+     */
+    std::vector<ReceivedRequest> runWorker(FloodWorker& worker,
+                                           const std::function<void(size_t, const ReceivedRequest&)>& onRequest,
+                                           const std::function<void()>& onIdle = {}) const {
+        std::vector<ReceivedRequest> requests;
+        worker.start(FloodWorker::Clock::now());
+        auto deadline = steady_clock::now() + seconds(10);
+        while (!worker.isFinished() && steady_clock::now() < deadline) {
+            ReceivedRequest request;
+            if (receiveRequest(request, 10)) {
+                requests.push_back(request);
+                onRequest(requests.size() - 1, request);
+            }
+            if (onIdle) {
+                onIdle();
+            }
+        }
+        worker.stop();
+        worker.join();
+        return requests;
+    }
+
+    int responderSocket = -1;
+    struct sockaddr_in server{};
+    FloodOptions options;
+};
+
+// Этот тест проверяет сопоставление ответов с запросами: потерянный, опоздавший,
+// повторный и чужой ответы, а также вид ответа для текстовых и бинарных кодов
+TEST_F(FloodWorkerTest, AccountsLostLateAndUnmatchedResponses) {
+    FloodWorker worker(0, options, server);
+    ASSERT_TRUE(worker.prepare());
+
+    ReceivedRequest lateRequest;
+    steady_clock::time_point lateReplyAt{};
+    bool lateReplied = false;
+
+    auto requests = runWorker(worker, [&](size_t index, const ReceivedRequest& request) {
+        switch (index) {
+            case 0:
+                // Ответ позже responseTimeoutMs, но до конца приема
+                lateRequest = request;
+                lateReplyAt = steady_clock::now() + milliseconds(500);
+                break;
+            case 1:
+                // Без ответа - потерян
+                break;
+            case 2:
+                reply(request.from, request.sequence, "rejected");
+                break;
+            case 3:
+                reply(request.from, request.sequence, std::string(1, '\x02'));
+                break;
+            case 4:
+                reply(request.from, request.sequence, std::string(1, '\x01'));
+                // Повторный ответ, ответ без номера и ответ на неотправленный номер не сопоставляются
+                reply(request.from, request.sequence, "created");
+                sendRaw(request.from, "created");
+                reply(request.from, (request.sequence + 1000) & FloodWorker::SEQUENCE_MASK, "created");
+                break;
+            case 5:
+                reply(request.from, request.sequence, "garbage");
+                break;
+            case 6:
+                reply(request.from, request.sequence, std::string(1, '\x09'));
+                break;
+            default:
+                reply(request.from, request.sequence, "created");
+                break;
+        }
+    }, [&]() {
+        if (!lateReplied && lateReplyAt != steady_clock::time_point{} && steady_clock::now() >= lateReplyAt) {
+            reply(lateRequest.from, lateRequest.sequence, "created");
+            lateReplied = true;
+        }
+    });
+
+    const auto& stats = worker.stats();
+    const uint64_t n = requests.size();
+    ASSERT_GE(n, 8u);
+    EXPECT_TRUE(lateReplied);
+    EXPECT_EQ(stats.sent, n);
+    EXPECT_EQ(stats.sendErrors, 0u);
+    EXPECT_EQ(stats.received, n - 2);
+    EXPECT_EQ(stats.late, 1u);
+    EXPECT_EQ(stats.unmatched, 3u);
+    EXPECT_EQ(stats.overwritten, 0u);
+    EXPECT_EQ(stats.lost(), 2u);
+    EXPECT_DOUBLE_EQ(stats.lossRatio(), 2.0 / static_cast<double>(n));
+    EXPECT_EQ(worker.latency().count(), n - 2);
+
+    auto responses = [&](ResponseKind kind) { return stats.responses[static_cast<size_t>(kind)]; };
+    EXPECT_EQ(responses(ResponseKind::CREATED), n - 7);
+    EXPECT_EQ(responses(ResponseKind::REJECTED), 1u);
+    EXPECT_EQ(responses(ResponseKind::REJECTED_BLACKLIST), 1u);
+    EXPECT_EQ(responses(ResponseKind::REFRESHED), 1u);
+    EXPECT_EQ(responses(ResponseKind::UNKNOWN), 2u);
+}
+
+// Этот тест проверяет, что ответы прогрева не попадают в счетчики окна измерения
+TEST_F(FloodWorkerTest, WarmupResponsesAreNotCounted) {
+    options.warmupSec = 0.25;
+    options.durationSec = 0.25;
+    FloodWorker worker(0, options, server);
+    ASSERT_TRUE(worker.prepare());
+
+    auto requests = runWorker(worker, [&](size_t, const ReceivedRequest& request) {
+        reply(request.from, request.sequence, "created");
+    });
+
+    const auto& stats = worker.stats();
+    ASSERT_GE(requests.size(), 6u);
+    EXPECT_GT(stats.warmupSent, 0u);
+    EXPECT_GT(stats.sent, 0u);
+    EXPECT_EQ(stats.sent + stats.warmupSent, requests.size());
+    EXPECT_EQ(stats.received, stats.sent);
+    EXPECT_EQ(stats.unmatched, 0u);
+    EXPECT_EQ(stats.lost(), 0u);
+    EXPECT_EQ(worker.latency().count(), stats.sent);
+}
+
+// Этот тест проверяет переход 24-битного номера запроса через SEQUENCE_MASK
+// и сопоставление ответов по обе стороны перехода
+TEST_F(FloodWorkerTest, SequenceWrapsAroundMask) {
+    FloodWorker worker(0, options, server, FloodWorker::SEQUENCE_MASK - 2);
+    ASSERT_TRUE(worker.prepare());
+
+    auto requests = runWorker(worker, [&](size_t, const ReceivedRequest& request) {
+        reply(request.from, request.sequence, "created");
+    });
+
+    const auto& stats = worker.stats();
+    ASSERT_GE(requests.size(), 6u);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        EXPECT_EQ(requests[i].sequence, (FloodWorker::SEQUENCE_MASK - 2 + i) & FloodWorker::SEQUENCE_MASK) << "request " << i;
+    }
+    EXPECT_EQ(requests[3].sequence, 0u);
+    EXPECT_EQ(stats.sent, requests.size());
+    EXPECT_EQ(stats.received, requests.size());
+    EXPECT_EQ(stats.unmatched, 0u);
+    EXPECT_EQ(stats.lost(), 0u);
+}
+
+// Этот тест проверяет режим blast без ограничения частоты: запросы, чей слот занят
+// новым запросом до истечения срока ответа, учитываются в overwritten, а не в потерях
+TEST_F(FloodWorkerTest, BlastModeCountsOverwrittenSlots) {
+    options.blast = true;
+    options.ratePerWorker = 0;
+    options.batchSize = 256;
+    options.durationSec = 0;
+    // Срок ответа с запасом перекрывает заполнение кольца даже на медленной машине
+    options.responseTimeoutMs = 3000;
+    ASSERT_EQ(FloodWorker::inFlightSlotsFor(options), FloodWorker::MIN_IN_FLIGHT_SLOTS);
+
+    FloodWorker worker(0, options, server);
+    ASSERT_TRUE(worker.prepare());
+
+    // Ответчик только вычитывает запросы; отправка останавливается после оборота кольца
+    const uint64_t target = FloodWorker::MIN_IN_FLIGHT_SLOTS + 4096;
+    auto requests = runWorker(worker, [](size_t, const ReceivedRequest&) {}, [&]() {
+        if (worker.sentCount() >= target) {
+            worker.stop();
+        }
+    });
+
+    const auto& stats = worker.stats();
+    uint64_t tracked = stats.sent + stats.sendErrors;
+    ASSERT_GE(stats.sent, target);
+    EXPECT_FALSE(requests.empty());
+    EXPECT_EQ(worker.sentCount(), stats.sent);
+    EXPECT_EQ(stats.received, 0u);
+    EXPECT_EQ(stats.unmatched, 0u);
+    EXPECT_EQ(stats.overwritten, tracked - FloodWorker::MIN_IN_FLIGHT_SLOTS);
+    EXPECT_EQ(stats.lost(), FloodWorker::MIN_IN_FLIGHT_SLOTS - stats.sendErrors);
+}
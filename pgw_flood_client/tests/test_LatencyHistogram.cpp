@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "../LatencyHistogram.h"
+
+namespace {
+
+constexpr double MAX_RELATIVE_ERROR = 1.0 / LatencyHistogram::SUB_BUCKETS;
+
+/**
+ * @brief Проверяет, что корзина значения содержит его и не шире допустимой погрешности
+ * @param value Значение, нс
+ */
+void expectBucketCovers(uint64_t value) {
+    size_t index = LatencyHistogram::bucketIndex(value);
+    ASSERT_LT(index, LatencyHistogram::BUCKET_COUNT) << "value " << value;
+
+    uint64_t upper = LatencyHistogram::bucketUpperValue(index);
+    EXPECT_GE(upper, value) << "value " << value;
+    EXPECT_LE(static_cast<double>(upper - value), MAX_RELATIVE_ERROR * static_cast<double>(value)) << "value " << value;
+    if (index > 0) {
+        EXPECT_LT(LatencyHistogram::bucketUpperValue(index - 1), value) << "value " << value;
+    }
+}
+
+} // namespace
+
+// Этот тест проверяет, что малые значения хранятся точно, по корзине на значение
+TEST(LatencyHistogramTest, SmallValuesHaveExactBuckets) {
+    for (uint64_t value = 0; value < 2 * LatencyHistogram::SUB_BUCKETS; ++value) {
+        EXPECT_EQ(LatencyHistogram::bucketIndex(value), value);
+        EXPECT_EQ(LatencyHistogram::bucketUpperValue(value), value);
+    }
+}
+
+// Этот тест проверяет границы корзин на краях октав и случайных значениях во всем диапазоне
+TEST(LatencyHistogramTest, BucketsCoverValuesWithinRelativeError) {
+    for (int bit = 8; bit <= LatencyHistogram::MAX_MSB; ++bit) {
+        uint64_t power = 1ULL << bit;
+        expectBucketCovers(power - 1);
+        expectBucketCovers(power);
+        expectBucketCovers(power + 1);
+    }
+
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<int> bits(0, LatencyHistogram::MAX_MSB);
+    for (int i = 0; i < 100000; ++i) {
+        uint64_t value = random() >> (63 - bits(random));
+        expectBucketCovers(value);
+    }
+}
+
+// Этот тест проверяет, что номера корзин не убывают и значения сверх диапазона насыщаются
+TEST(LatencyHistogramTest, BucketIndexIsMonotonicAndSaturates) {
+    size_t previous = 0;
+    for (uint64_t value = 1; value < LatencyHistogram::MAX_VALUE_NS; value += value / 7 + 1) {
+        size_t index = LatencyHistogram::bucketIndex(value);
+        EXPECT_GE(index, previous) << "value " << value;
+        previous = index;
+    }
+
+    size_t last = LatencyHistogram::BUCKET_COUNT - 1;
+    EXPECT_EQ(LatencyHistogram::bucketIndex(2 * LatencyHistogram::MAX_VALUE_NS - 1), last);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(LatencyHistogram::MAX_VALUE_NS * 16), last);
+    EXPECT_EQ(LatencyHistogram::bucketIndex(UINT64_MAX), last);
+}
+
+// Этот тест проверяет пустую гистограмму
+TEST(LatencyHistogramTest, EmptyHistogramReturnsZero) {
+    LatencyHistogram histogram;
+
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.valueAtPercentile(50.0), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 0.0);
+}
+
+// Этот тест проверяет перцентили равномерного ряда с учетом погрешности корзин
+TEST(LatencyHistogramTest, PercentilesWithinRelativeError) {
+    LatencyHistogram histogram;
+    const uint64_t n = 100000;
+    for (uint64_t i = 1; i <= n; ++i) {
+        histogram.record(i * 1000);
+    }
+
+    ASSERT_EQ(histogram.count(), n);
+    EXPECT_EQ(histogram.max(), n * 1000);
+    EXPECT_DOUBLE_EQ(histogram.mean(), static_cast<double>(n + 1) / 2.0 * 1000.0);
+
+    for (double percentile : {1.0, 10.0, 50.0, 90.0, 99.0, 99.9}) {
+        auto expected = static_cast<double>(n) * percentile / 100.0 * 1000.0;
+        auto actual = static_cast<double>(histogram.valueAtPercentile(percentile));
+        EXPECT_GE(actual, expected) << "p" << percentile;
+        EXPECT_LE(actual - expected, MAX_RELATIVE_ERROR * expected) << "p" << percentile;
+    }
+
+    // Крайние перцентили и значения за пределами 0..100
+    EXPECT_EQ(histogram.valueAtPercentile(100.0), n * 1000);
+    EXPECT_EQ(histogram.valueAtPercentile(150.0), n * 1000);
+    EXPECT_EQ(histogram.valueAtPercentile(0.0), LatencyHistogram::bucketUpperValue(LatencyHistogram::bucketIndex(1000)));
+    EXPECT_EQ(histogram.valueAtPercentile(-1.0), histogram.valueAtPercentile(0.0));
+}
+
+// Этот тест проверяет, что верхняя граница корзины не превышает фактический максимум
+TEST(LatencyHistogramTest, PercentileDoesNotExceedMax) {
+    LatencyHistogram histogram;
+    histogram.record(1000001);
+
+    EXPECT_EQ(histogram.valueAtPercentile(50.0), 1000001u);
+    EXPECT_EQ(histogram.valueAtPercentile(100.0), 1000001u);
+}
+
+// Этот тест проверяет насыщение значений больше MAX_VALUE_NS
+TEST(LatencyHistogramTest, RecordsValuesAboveRange) {
+    LatencyHistogram histogram;
+    histogram.record(LatencyHistogram::MAX_VALUE_NS * 4);
+
+    EXPECT_EQ(histogram.count(), 1u);
+    EXPECT_EQ(histogram.max(), LatencyHistogram::MAX_VALUE_NS * 4);
+    EXPECT_GE(histogram.valueAtPercentile(50.0), LatencyHistogram::MAX_VALUE_NS);
+}
+
+// Этот тест проверяет слияние гистограмм: количество, среднее, максимум и перцентили
+TEST(LatencyHistogramTest, MergeCombinesHistograms) {
+    LatencyHistogram low;
+    LatencyHistogram high;
+    LatencyHistogram expected;
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        low.record(i * 100);
+        high.record(i * 100000);
+        expected.record(i * 100);
+        expected.record(i * 100000);
+    }
+
+    LatencyHistogram merged;
+    merged.merge(low);
+    merged.merge(high);
+
+    EXPECT_EQ(merged.count(), 2000u);
+    EXPECT_EQ(merged.max(), high.max());
+    EXPECT_DOUBLE_EQ(merged.mean(), expected.mean());
+    for (double percentile : {0.0, 25.0, 50.0, 75.0, 99.0, 100.0}) {
+        EXPECT_EQ(merged.valueAtPercentile(percentile), expected.valueAtPercentile(percentile)) << "p" << percentile;
+    }
+
+    // Источники не меняются, пустая гистограмма ничего не добавляет
+    EXPECT_EQ(low.count(), 1000u);
+    merged.merge(LatencyHistogram());
+    EXPECT_EQ(merged.count(), 2000u);
+    EXPECT_EQ(merged.max(), high.max());
+}
+
+// Этот тест проверяет обнуление гистограммы
+TEST(LatencyHistogramTest, ResetClearsValues) {
+    LatencyHistogram histogram;
+    histogram.record(5000);
+    histogram.reset();
+
+    EXPECT_EQ(histogram.count(), 0u);
+    EXPECT_EQ(histogram.max(), 0u);
+    EXPECT_EQ(histogram.valueAtPercentile(99.0), 0u);
+}
@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Workload.h"
+
+using namespace std::chrono;
+
+namespace {
+
+constexpr int SAMPLES = 200000;
+
+/**
+ * @brief Возвращает номер абонента из 10 последних цифр IMSI популяции
+ * @param imsi IMSI вида Workload::IMSI_PREFIX + 10 цифр
+ */
+uint64_t imsiNumber(const std::string& imsi) {
+    return std::stoull(imsi.substr(imsi.size() - 10));
+}
+
+/**
+ * @brief Вероятности рангов распределения Ципфа
+ * @param n Количество рангов
+ * @param exponent Показатель
+ * @return Вероятность ранга k в элементе k - 1
+ */
+std::vector<double> zipfProbabilities(uint64_t n, double exponent) {
+    std::vector<double> probabilities(n);
+    double total = 0.0;
+    for (uint64_t k = 1; k <= n; ++k) {
+        probabilities[k - 1] = std::pow(static_cast<double>(k), -exponent);
+        total += probabilities[k - 1];
+    }
+    for (double& p : probabilities) {
+        p /= total;
+    }
+    return probabilities;
+}
+
+/**
+ * @brief Проверяет долю в пределах пяти стандартных отклонений биномиальной выборки
+ */
+void expectFraction(double observed, double expected, int samples, const std::string& what) {
+    double sigma = std::sqrt(expected * (1.0 - expected) / samples);
+    EXPECT_NEAR(observed, expected, 5.0 * sigma + 1e-9) << what;
+}
+
+} // namespace
+
+// Этот тест проверяет, что частоты рангов совпадают с законом Ципфа
+TEST(ZipfDistributionTest, RankFrequenciesFollowZipfLaw) {
+    for (double exponent : {0.99, 1.2}) {
+        const uint64_t n = 1000;
+        ZipfDistribution zipf(n, exponent);
+        std::mt19937_64 random(7);
+
+        std::vector<int> counts(n + 1, 0);
+        for (int i = 0; i < SAMPLES; ++i) {
+            uint64_t rank = zipf(random);
+            ASSERT_GE(rank, 1u);
+            ASSERT_LE(rank, n);
+            ++counts[rank];
+        }
+
+        auto probabilities = zipfProbabilities(n, exponent);
+        for (uint64_t k : {1, 2, 3, 10, 100}) {
+            expectFraction(static_cast<double>(counts[k]) / SAMPLES, probabilities[k - 1], SAMPLES,
+                           "rank " + std::to_string(k) + ", exponent " + std::to_string(exponent));
+        }
+        // Хвост распределения
+        int tail = 0;
+        double tailProbability = 0.0;
+        for (uint64_t k = 501; k <= n; ++k) {
+            tail += counts[k];
+            tailProbability += probabilities[k - 1];
+        }
+        expectFraction(static_cast<double>(tail) / SAMPLES, tailProbability, SAMPLES,
+                       "ranks 501..1000, exponent " + std::to_string(exponent));
+    }
+}
+
+// Этот тест проверяет вырожденное распределение из одного ранга
+TEST(ZipfDistributionTest, SingleRank) {
+    ZipfDistribution zipf(1, 0.99);
+    std::mt19937_64 random(1);
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ(zipf(random), 1u);
+    }
+}
+
+// Этот тест проверяет формат IMSI и границы популяции профиля zipf
+TEST(WorkloadTest, ZipfProfileStaysInPopulation) {
+    WorkloadOptions options;
+    options.profile = WorkloadProfile::ZIPF;
+    options.population = 1000;
+    options.zipfExponent = 0.99;
+    Workload workload(options, 11);
+
+    int mostPopular = 0;
+    for (int i = 0; i < SAMPLES; ++i) {
+        const auto& imsi = workload.next(seconds(0));
+        ASSERT_EQ(imsi.size(), 15u);
+        ASSERT_EQ(imsi.rfind(Workload::IMSI_PREFIX, 0), 0u) << imsi;
+        uint64_t number = imsiNumber(imsi);
+        ASSERT_LT(number, options.population);
+        mostPopular += number == 0 ? 1 : 0;
+    }
+    // Абонент 0 - ранг 1
+    expectFraction(static_cast<double>(mostPopular) / SAMPLES, zipfProbabilities(1000, 0.99)[0], SAMPLES, "rank 1");
+}
+
+// Этот тест проверяет равновероятный выбор абонентов профиля uniform
+TEST(WorkloadTest, UniformProfileIsUniform) {
+    WorkloadOptions options;
+    options.profile = WorkloadProfile::UNIFORM;
+    options.population = 10;
+    Workload workload(options, 3);
+
+    std::vector<int> counts(options.population, 0);
+    for (int i = 0; i < SAMPLES; ++i) {
+        uint64_t number = imsiNumber(workload.next(seconds(0)));
+        ASSERT_LT(number, options.population);
+        ++counts[number];
+    }
+    for (size_t subscriber = 0; subscriber < counts.size(); ++subscriber) {
+        expectFraction(static_cast<double>(counts[subscriber]) / SAMPLES, 0.1, SAMPLES,
+                       "subscriber " + std::to_string(subscriber));
+    }
+}
+
+// Этот тест проверяет, что за секунду IMSI меняет доля churnPerSec популяции
+TEST(WorkloadTest, ContinuousChurnReplacesFractionPerSecond) {
+    WorkloadOptions options;
+    options.profile = WorkloadProfile::UNIFORM;
+    options.population = 10000;
+    options.churnPerSec = 0.1;
+    Workload workload(options, 5);
+
+    // В начале все абоненты в нулевом поколении
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_LT(imsiNumber(workload.next(seconds(0))), options.population);
+    }
+
+    // Через секунду новое поколение у доли 0.1 абонентов, через 10 секунд - первое у всех
+    int renewed = 0;
+    for (int i = 0; i < SAMPLES; ++i) {
+        uint64_t number = imsiNumber(workload.next(seconds(1)));
+        ASSERT_LT(number, 2 * options.population);
+        renewed += number >= options.population ? 1 : 0;
+    }
+    EXPECT_NEAR(static_cast<double>(renewed) / SAMPLES, 0.1, 0.01);
+
+    for (int i = 0; i < 10000; ++i) {
+        uint64_t number = imsiNumber(workload.next(seconds(10)));
+        ASSERT_GE(number, options.population);
+        ASSERT_LT(number, 2 * options.population);
+    }
+}
+
+// Этот тест проверяет смену IMSI пачками в начале каждого периода
+TEST(WorkloadTest, PeriodicChurnRenewsAtPeriodStart) {
+    WorkloadOptions options;
+    options.profile = WorkloadProfile::UNIFORM;
+    options.population = 1000;
+    options.churnPerSec = 0.1;
+    options.churnPeriodSec = 10.0;
+    Workload workload(options, 9);
+
+    // До конца первого периода смены нет, в начале второго накопленная смена происходит разом
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_LT(imsiNumber(workload.next(duration<double>(9.99))), options.population);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        uint64_t number = imsiNumber(workload.next(seconds(10)));
+        ASSERT_GE(number, options.population);
+        ASSERT_LT(number, 2 * options.population);
+    }
+}
+
+// Этот тест проверяет долю запросов с IMSI из черного списка
+TEST(WorkloadTest, BlacklistRatio) {
+    WorkloadOptions options;
+    options.profile = WorkloadProfile::UNIFORM;
+    options.population = 1000;
+    options.blacklist = {"001010123456789", "001010000000001"};
+    options.blacklistRatio = 0.25;
+    Workload workload(options, 13);
+
+    std::vector<int> blacklisted(options.blacklist.size(), 0);
+    for (int i = 0; i < SAMPLES; ++i) {
+        const auto& imsi = workload.next(seconds(0));
+        for (size_t j = 0; j < options.blacklist.size(); ++j) {
+            blacklisted[j] += imsi == options.blacklist[j] ? 1 : 0;
+        }
+    }
+    expectFraction(static_cast<double>(blacklisted[0] + blacklisted[1]) / SAMPLES, 0.25, SAMPLES, "blacklist");
+    expectFraction(static_cast<double>(blacklisted[0]) / SAMPLES, 0.125, SAMPLES, "first entry");
+}
+
+// Этот тест проверяет профиль random: каждый запрос - новый IMSI из 15 цифр
+TEST(WorkloadTest, RandomProfileGeneratesValidImsi) {
+    WorkloadOptions options;
+    Workload workload(options, 17);
+
+    for (int i = 0; i < 1000; ++i) {
+        const auto& imsi = workload.next(seconds(0));
+        ASSERT_EQ(imsi.size(), 15u);
+        EXPECT_EQ(imsi.find_first_not_of("0123456789"), std::string::npos) << imsi;
+    }
+}
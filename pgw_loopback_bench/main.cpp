@@ -0,0 +1,321 @@
+#include <AppBootstrap.h>
+#include <FloodManager.h>
+#include <FloodOptions.h>
+#include <LatencyHistogram.h>
+#include <RateLimiter.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <getopt.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Параметры прогона
+ */
+struct BenchOptions {
+    std::vector<double> loads{5000, 10000, 20000};  // Предлагаемая нагрузка, запросов/с суммарно
+    int threads = 2;                                // Потоков встроенного клиента
+    double durationSec = 5.0;                       // Измерение на каждой нагрузке, с
+    double warmupSec = 1.0;                         // Прогрев на каждой нагрузке, с
+    uint16_t basePort = 19000;                      // UDP-порт; HTTP и метрики - следующие два
+    std::string serverConfig;                       // JSON с параметрами сервера поверх значений прогона
+    std::string jsonOutput;                         // Файл результатов в JSON
+    WorkloadOptions workload;                       // Модель абонентской нагрузки
+};
+
+/**
+ * @brief Результат одной нагрузки
+ */
+struct LoadResult {
+    double offered = 0;         // Предлагаемая нагрузка, запросов/с
+    double sendRate = 0;        // Фактическая частота отправки, запросов/с
+    double throughput = 0;      // Полученных ответов в секунду
+    uint64_t sent = 0;          // Отправлено запросов
+    uint64_t received = 0;      // Получено ответов
+    double dropRate = 0;        // Доля потерянных запросов (как Lost в сводке flood-клиента)
+    double p50Us = 0;           // Перцентили задержки, мкс
+    double p99Us = 0;
+    double p999Us = 0;
+    double maxUs = 0;
+};
+
+void printUsage(const char* programName) {
+    std::cout << "Usage: " << programName << " [options]\n"
+              << "  -l, --loads LIST         offered loads in req/s, comma-separated (default 5000,10000,20000)\n"
+              << "  -t, --threads N          client threads (default 2)\n"
+              << "  -d, --duration S         measured duration per load in seconds (default 5)\n"
+              << "  -w, --warmup S           warmup per load in seconds (default 1)\n"
+              << "  -p, --port P             UDP port; HTTP and metrics use P+1 and P+2 (default 19000)\n"
+              << "  -c, --server-config FILE server settings overriding the loopback defaults\n"
+              << "  -j, --json FILE          write results as JSON\n"
+              << "      --profile NAME       IMSI workload: random, uniform or zipf (default random)\n"
+              << "      --population N       subscriber population for uniform/zipf (default 100000)\n"
+              << "  -h, --help               show this help\n";
+}
+
+/**
+ * @brief Разбирает параметры командной строки
+ * @param argc Количество аргументов
+ * @param argv Аргументы
+ * @param options Параметры для заполнения
+ * @return true если параметры корректны
+ */
+bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+    enum { OPTION_PROFILE = 256, OPTION_POPULATION };
+    static const option longOptions[] = {
+        {"loads", required_argument, nullptr, 'l'},
+        {"threads", required_argument, nullptr, 't'},
+        {"duration", required_argument, nullptr, 'd'},
+        {"warmup", required_argument, nullptr, 'w'},
+        {"port", required_argument, nullptr, 'p'},
+        {"server-config", required_argument, nullptr, 'c'},
+        {"json", required_argument, nullptr, 'j'},
+        {"profile", required_argument, nullptr, OPTION_PROFILE},
+        {"population", required_argument, nullptr, OPTION_POPULATION},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0}
+    };
+
+    try {
+        int opt;
+        while ((opt = getopt_long(argc, argv, "l:t:d:w:p:c:j:h", longOptions, nullptr)) != -1) {
+            switch (opt) {
+                case 'l': {
+                    options.loads.clear();
+                    std::stringstream list(optarg);
+                    std::string load;
+                    while (std::getline(list, load, ',')) {
+                        options.loads.push_back(std::stod(load));
+                    }
+                    break;
+                }
+                case 't':
+                    options.threads = std::stoi(optarg);
+                    break;
+                case 'd':
+                    options.durationSec = std::stod(optarg);
+                    break;
+                case 'w':
+                    options.warmupSec = std::stod(optarg);
+                    break;
+                case 'p':
+                    options.basePort = static_cast<uint16_t>(std::stoul(optarg));
+                    break;
+                case 'c':
+                    options.serverConfig = optarg;
+                    break;
+                case 'j':
+                    options.jsonOutput = optarg;
+                    break;
+                case OPTION_PROFILE:
+                    if (std::string(optarg) == "random") {
+                        options.workload.profile = WorkloadProfile::RANDOM;
+                    } else if (std::string(optarg) == "uniform") {
+                        options.workload.profile = WorkloadProfile::UNIFORM;
+                    } else if (std::string(optarg) == "zipf") {
+                        options.workload.profile = WorkloadProfile::ZIPF;
+                    } else {
+                        std::cerr << "Error: Unknown workload profile: " << optarg << "\n";
+                        return false;
+                    }
+                    break;
+                case OPTION_POPULATION:
+                    options.workload.population = std::stoull(optarg);
+                    break;
+                default:
+                    return false;
+            }
+        }
+    } catch (const std::exception&) {
+        std::cerr << "Error: Invalid numeric argument\n";
+        return false;
+    }
+
+    if (options.loads.empty() || options.threads <= 0 || options.durationSec <= 0 || options.warmupSec < 0 ||
+        options.basePort == 0 || options.basePort > 65533 || options.workload.population == 0 ||
+        std::any_of(options.loads.begin(), options.loads.end(), [](double load) { return load <= 0; })) {
+        std::cerr << "Error: Invalid option value\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Записывает конфигурацию сервера для прогона
+ *
+ * Сервер слушает только loopback, пишет CDR и журнал во временный каталог,
+ * журналирует только ошибки и задает максимальный допустимый лимит запросов
+ * абонента (емкость 10^7 токенов не исчерпывается за прогон), чтобы измерялся
+ * путь обработки, а не отказы. Параметры из serverConfig применяются поверх.
+ * @param options Параметры прогона
+ * @param directory Временный каталог
+ * @return Путь к конфигурационному файлу
+ * @throw std::runtime_error если файл параметров не удалось прочитать
+ */
+std::string writeServerConfig(const BenchOptions& options, const std::filesystem::path& directory) {
+    nlohmann::json config = {
+        {"udp_ip", "127.0.0.1"},
+        {"udp_port", options.basePort},
+        {"http_port", options.basePort + 1},
+        {"metrics_port", options.basePort + 2},
+        {"cdr_file", (directory / "cdr.log").string()},
+        {"log_file", (directory / "pgw.log").string()},
+        {"log_level", "ERROR"},
+        {"max_requests_per_minute", RateLimiter::MAX_REQUESTS_PER_MINUTE},
+        {"blacklist", nlohmann::json::array()}
+    };
+
+    if (!options.serverConfig.empty()) {
+        std::ifstream file(options.serverConfig);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open server config: " + options.serverConfig);
+        }
+        config.update(nlohmann::json::parse(file));
+    }
+
+    auto path = directory / "server_config.json";
+    std::ofstream(path) << config.dump(4);
+    return path.string();
+}
+
+/**
+ * @brief Прогоняет одну нагрузку встроенным клиентом
+ * @param options Параметры прогона
+ * @param offered Суммарная предлагаемая нагрузка, запросов/с
+ * @return Результат нагрузки
+ * @throw std::runtime_error если клиент не удалось запустить
+ */
+LoadResult runLoad(const BenchOptions& options, double offered) {
+    FloodOptions flood;
+    flood.threads = options.threads;
+    flood.serverHost = "127.0.0.1";
+    flood.serverPort = options.basePort;
+    flood.ratePerWorker = offered / options.threads;
+    flood.arrival = ArrivalProcess::POISSON;
+    flood.durationSec = options.durationSec;
+    flood.warmupSec = options.warmupSec;
+    flood.workload = options.workload;
+
+    FloodManager manager(flood);
+    if (!manager.start()) {
+        throw std::runtime_error("Failed to start client workers");
+    }
+    while (!manager.isFinished()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    manager.stop();
+
+    auto total = manager.totalStats();
+    LatencyHistogram latency;
+    manager.mergeLatency(latency);
+    double window = manager.measuredWindow();
+
+    LoadResult result;
+    result.offered = offered;
+    result.sent = total.sent;
+    result.received = total.received;
+    result.sendRate = window > 0 ? static_cast<double>(total.sent) / window : 0.0;
+    result.throughput = window > 0 ? static_cast<double>(total.received) / window : 0.0;
+    result.dropRate = total.lossRatio();
+    result.p50Us = static_cast<double>(latency.valueAtPercentile(50.0)) / 1000.0;
+    result.p99Us = static_cast<double>(latency.valueAtPercentile(99.0)) / 1000.0;
+    result.p999Us = static_cast<double>(latency.valueAtPercentile(99.9)) / 1000.0;
+    result.maxUs = static_cast<double>(latency.max()) / 1000.0;
+    return result;
+}
+
+/**
+ * @brief Выводит результаты таблицей
+ * @param results Результаты нагрузок
+ * @param out Поток вывода
+ */
+void printResults(const std::vector<LoadResult>& results, std::ostream& out) {
+    out << std::fixed << std::setprecision(1)
+        << std::setw(10) << "offered" << std::setw(10) << "sent/s" << std::setw(10) << "recv/s"
+        << std::setw(9) << "drop%" << std::setw(10) << "p50us" << std::setw(10) << "p99us"
+        << std::setw(10) << "p99.9us" << std::setw(10) << "maxus" << "\n";
+    for (const auto& r : results) {
+        out << std::setw(10) << r.offered << std::setw(10) << r.sendRate << std::setw(10) << r.throughput
+            << std::setw(9) << std::setprecision(3) << r.dropRate * 100.0 << std::setprecision(1)
+            << std::setw(10) << r.p50Us << std::setw(10) << r.p99Us
+            << std::setw(10) << r.p999Us << std::setw(10) << r.maxUs << "\n";
+    }
+}
+
+/**
+ * @brief Записывает результаты в JSON
+ * @param results Результаты нагрузок
+ * @param options Параметры прогона
+ */
+void writeJson(const std::vector<LoadResult>& results, const BenchOptions& options) {
+    nlohmann::json loads = nlohmann::json::array();
+    for (const auto& r : results) {
+        loads.push_back({
+            {"offered_rps", r.offered},
+            {"sent_rps", r.sendRate},
+            {"throughput_rps", r.throughput},
+            {"sent", r.sent},
+            {"received", r.received},
+            {"drop_rate", r.dropRate},
+            {"latency_us", {{"p50", r.p50Us}, {"p99", r.p99Us}, {"p99_9", r.p999Us}, {"max", r.maxUs}}}
+        });
+    }
+    nlohmann::json report = {
+        {"threads", options.threads},
+        {"duration_sec", options.durationSec},
+        {"warmup_sec", options.warmupSec},
+        {"loads", loads}
+    };
+    std::ofstream(options.jsonOutput) << report.dump(2) << "\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    auto directory = std::filesystem::temp_directory_path() / ("pgw_loopback_" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+
+    int status = 0;
+    try {
+        AppBootstrap app;
+        app.initialize(writeServerConfig(options, directory));
+        app.start();
+        std::cout << "Server started on 127.0.0.1:" << options.basePort << ", CDR in " << directory.string() << "\n";
+
+        std::vector<LoadResult> results;
+        for (double load : options.loads) {
+            std::cout << "Offered load " << load << " req/s: " << options.warmupSec << " s warmup + "
+                      << options.durationSec << " s..." << std::endl;
+            results.push_back(runLoad(options, load));
+        }
+        app.stop();
+
+        printResults(results, std::cout);
+        if (!options.jsonOutput.empty()) {
+            writeJson(results, options);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        status = 1;
+    }
+
+    std::error_code ignored;
+    std::filesystem::remove_all(directory, ignored);
+    return status;
+}
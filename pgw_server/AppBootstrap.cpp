@@ -5,9 +5,12 @@
 #include <SessionManager.h>
 #include <GracefulShutdownManager.h>
 #include <SessionCleaner.h>
+#include <BlacklistReloader.h>
 #include <RateLimiter.h>
 #include <InMemorySessionRepository.h>
+#include <ShardedSessionRepository.h>
 #include <FileCdrRepository.h>
+#include <AsyncFileCdrRepository.h>
 #include <Logger.h>
 #include <Blacklist.h>
 #include <iostream>
@@ -49,9 +52,13 @@ AppBootstrap::~AppBootstrap() {
 }
 
 void AppBootstrap::initialize() {
+    initialize(findConfigFile());
+}
+
+void AppBootstrap::initialize(const std::string& configPath) {
     try {
         // Инициализируем компоненты
-        setupComponents();
+        setupComponents(configPath);
         
         // Регистрируем обработчики сигналов
         std::signal(SIGINT, appBootstrapSignalHandler);
@@ -70,16 +77,11 @@ void AppBootstrap::initialize() {
 }
 
 void AppBootstrap::run() {
-    if (_running.exchange(true)) {
-        if (_logger) {
-            _logger->warn("Application already running");
-        }
-        return;
-    }
-    
     try {
         // Запускаем сервисы
-        startServices();
+        if (!start()) {
+            return;
+        }
         
         if (_logger) {
             _logger->info("Application running");
@@ -106,6 +108,33 @@ void AppBootstrap::run() {
     }
 }
 
+bool AppBootstrap::start() {
+    if (_running.exchange(true)) {
+        if (_logger) {
+            _logger->warn("Application already running");
+        }
+        return false;
+    }
+    try {
+        startServices();
+    } catch (...) {
+        // Уже запущенные сервисы останавливаются, приложение можно запустить повторно
+        _running = false;
+        stopServices();
+        throw;
+    }
+    return true;
+}
+
+void AppBootstrap::stop() {
+    if (_running.exchange(false)) {
+        stopServices();
+        if (_logger) {
+            _logger->info("Application stopped");
+        }
+    }
+}
+
 void AppBootstrap::initiateShutdown() {
     // Проверяем, не запущен ли уже процесс завершения
     if (!_running.load()) {
@@ -169,14 +198,14 @@ std::string AppBootstrap::findConfigFile() {
     throw std::runtime_error("Cannot find configuration file");
 }
 
-void AppBootstrap::setupComponents() {
-
-    // Находим конфигурационный файл
-    std::string configPath = findConfigFile();
+void AppBootstrap::setupComponents(const std::string& configPath) {
 
     // Создаем конфигурацию
     _config = std::make_unique<JsonConfigAdapter>(configPath);
-    _config->load();
+    if (!_config->load()) {
+        // Поля заполняются до проверки, поэтому с некорректной конфигурацией запускаться нельзя
+        throw std::runtime_error("Invalid configuration " + configPath + ": " + _config->getLastError());
+    }
 
     int metrics_port = _config->getUint("metrics_port", 9101);
     ServerMetrics::init(metrics_port);
@@ -184,18 +213,36 @@ void AppBootstrap::setupComponents() {
     // Создаем логгер
     std::string logFile = _config->getString("log_file", "pgw.log");
     std::string logLevelStr = _config->getString("log_level", "INFO");
-    _logger = std::make_unique<Logger>(logFile, Logger::stringToLevel(logLevelStr));
+    LoggerOptions logOptions;
+    logOptions.async = _config->getBool("log_async", false);
+    logOptions.queueSize = _config->getUint("log_queue_size", 8192);
+    logOptions.overflowPolicy = Logger::stringToOverflowPolicy(_config->getString("log_overflow_policy", "block"));
+    _logger = std::make_unique<Logger>(logFile, Logger::stringToLevel(logLevelStr), logOptions);
     _logger->info("Configuration loaded from: " + configPath);
     
     // Создаем shared_ptr для логгера
     auto logger = createSharedFromUnique(_logger.get());
     
     // Создаем репозитории
-    _sessionRepo = std::make_unique<InMemorySessionRepository>(logger);
-    _logger->info("Session repository initialized");
+    uint32_t sessionShards = _config->getUint("session_shards", 1);
+    if (sessionShards > 1) {
+        _sessionRepo = std::make_unique<ShardedSessionRepository>(sessionShards, logger);
+    } else {
+        _sessionRepo = std::make_unique<InMemorySessionRepository>(logger);
+    }
+    _logger->info("Session repository initialized with " + std::to_string(sessionShards) + " shards");
     
     std::string cdrFile = _config->getString("cdr_file", "cdr.log");
-    _cdrRepo = std::make_unique<FileCdrRepository>(cdrFile, logger);
+    if (_config->getBool("cdr_async", false)) {
+        AsyncCdrOptions cdrOptions;
+        cdrOptions.queueCapacity = _config->getUint("cdr_queue_size", 65536);
+        cdrOptions.flushInterval = std::chrono::milliseconds(_config->getUint("cdr_flush_interval_ms", 100));
+        cdrOptions.flushBytes = _config->getUint("cdr_flush_bytes", 65536);
+        cdrOptions.maxEnqueueWait = std::chrono::microseconds(_config->getUint("cdr_enqueue_timeout_us", 1000));
+        _cdrRepo = std::make_unique<AsyncFileCdrRepository>(cdrFile, cdrOptions, logger);
+    } else {
+        _cdrRepo = std::make_unique<FileCdrRepository>(cdrFile, logger);
+    }
     
     // Создаем shared_ptr для репозиториев
     auto sessionRepo = createSharedFromUnique(_sessionRepo.get());
@@ -203,15 +250,38 @@ void AppBootstrap::setupComponents() {
     
     // Создаем черный список
     auto blacklistItems = _config->getStringArray("blacklist");
-    _blacklist = std::make_unique<Blacklist>(blacklistItems);
-    _logger->info("Blacklist initialized with " + std::to_string(blacklistItems.size()) + " items");
+    std::string blacklistFile = _config->getString("blacklist_file", "");
+    if (!blacklistFile.empty()) {
+        if (!blacklistItems.empty()) {
+            _logger->warn("Both blacklist and blacklist_file are set, inline blacklist is ignored");
+        }
+        _blacklist = std::make_unique<Blacklist>(Blacklist::loadFromFile(blacklistFile));
+        _logger->info("Blacklist loaded from " + blacklistFile);
+    } else {
+        _blacklist = std::make_unique<Blacklist>(blacklistItems);
+    }
+    _logger->info("Blacklist initialized with " + std::to_string(_blacklist->size()) + " items, " +
+                  std::to_string(_blacklist->memoryUsage()) + " bytes");
     
     // Создаем shared_ptr для черного списка
     auto blacklist = createSharedFromUnique(_blacklist.get());
     
+    // Черный список из файла можно перезагружать без перезапуска
+    if (!blacklistFile.empty()) {
+        _blacklistReloader = std::make_unique<BlacklistReloader>(
+            blacklist,
+            blacklistFile,
+            logger,
+            std::chrono::milliseconds(_config->getUint("blacklist_watch_interval_ms", 1000))
+        );
+    }
+    
     // Создаем ограничитель скорости запросов
     uint32_t maxRequestsPerMinute = _config->getUint("max_requests_per_minute", 100);
-    _rateLimiter = std::make_unique<RateLimiter>(maxRequestsPerMinute, logger);
+    RateLimiterOptions rateLimiterOptions;
+    rateLimiterOptions.shardCount = _config->getUint("rate_limiter_shards", 16);
+    rateLimiterOptions.maxBuckets = _config->getUint("rate_limiter_max_buckets", 1000000);
+    _rateLimiter = std::make_unique<RateLimiter>(maxRequestsPerMinute, logger, rateLimiterOptions);
     
     // Создаем shared_ptr для ограничителя скорости
     auto rateLimiter = createSharedFromUnique(_rateLimiter.get());
@@ -249,11 +319,21 @@ void AppBootstrap::setupComponents() {
     // Создаем UDP сервер
     std::string serverIp = _config->getString("udp_ip", "0.0.0.0");
     uint16_t udpPort = static_cast<uint16_t>(_config->getUint("udp_port", 9000));
+    UdpServerOptions udpOptions;
+    udpOptions.workerCount = _config->getUint("udp_workers", 1);
+    udpOptions.batchSize = _config->getUint("udp_batch_size", 1);
+    udpOptions.edgeTriggered = _config->getBool("udp_edge_triggered", false);
+    udpOptions.admission.globalPacketsPerSecond = _config->getUint("udp_admission_global_pps", 0);
+    udpOptions.admission.sourcePacketsPerSecond = _config->getUint("udp_admission_source_pps", 0);
+    udpOptions.admission.sourceSlots = _config->getUint("udp_admission_source_slots", 65536);
+    udpOptions.responseMode = _config->getString("udp_response_mode", "text") == "binary"
+                                  ? UdpResponseMode::BINARY : UdpResponseMode::TEXT;
     _udpServer = std::make_unique<UdpServer>(
         serverIp,
         udpPort,
         sessionManager,
-        logger
+        logger,
+        udpOptions
     );
     
     // Создаем HTTP сервер
@@ -265,7 +345,10 @@ void AppBootstrap::setupComponents() {
         sessionManager,
         shutdownManager,
         logger,
-        [this]() { this->initiateShutdown(); }
+        [this]() { this->initiateShutdown(); },
+        _blacklistReloader
+            ? HttpServer::ReloadCallback([this]() { return _blacklistReloader->reload(); })
+            : HttpServer::ReloadCallback()
     );
 }
 
@@ -275,6 +358,11 @@ void AppBootstrap::startServices() const {
         _sessionCleaner->start();
     }
     
+    // Запускаем наблюдение за файлом черного списка
+    if (_blacklistReloader) {
+        _blacklistReloader->start();
+    }
+    
     // Запускаем UDP сервер
     if (_udpServer) {
         if (!_udpServer->start()) {
@@ -301,6 +389,11 @@ void AppBootstrap::stopServices() const {
         _udpServer->stop();
     }
     
+    // Останавливаем наблюдение за файлом черного списка
+    if (_blacklistReloader) {
+        _blacklistReloader->stop();
+    }
+    
     // Останавливаем очиститель сессий
     if (_sessionCleaner) {
         _sessionCleaner->stop();
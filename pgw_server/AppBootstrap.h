@@ -10,9 +10,10 @@ class HttpServer;
 class SessionManager;
 class GracefulShutdownManager;
 class SessionCleaner;
+class BlacklistReloader;
 class RateLimiter;
-class InMemorySessionRepository;
-class FileCdrRepository;
+class ISessionRepository;
+class ICdrRepository;
 class Logger;
 class Blacklist;
 
@@ -45,11 +46,30 @@ public:
      * @throw std::runtime_error в случае ошибки инициализации
      */
     void initialize();
+
+    /**
+     * @brief Инициализирует все компоненты приложения с указанным конфигурационным файлом
+     * @param configPath Путь к конфигурационному файлу
+     * @throw std::runtime_error в случае ошибки инициализации
+     */
+    void initialize(const std::string& configPath);
     
     /**
      * @brief Запускает приложение и блокирует выполнение до завершения
      */
     void run();
+
+    /**
+     * @brief Запускает сервисы без блокировки (встраивание в другой процесс, бенчмарки)
+     * @return false если приложение уже запущено
+     * @throw std::runtime_error если сервис не удалось запустить
+     */
+    bool start();
+
+    /**
+     * @brief Немедленно останавливает сервисы без плавной выгрузки сессий
+     */
+    void stop();
     
     /**
      * @brief Инициирует процесс плавного завершения работы
@@ -66,8 +86,9 @@ private:
     
     /**
      * @brief Создает и настраивает все компоненты приложения
+     * @param configPath Путь к конфигурационному файлу
      */
-    void setupComponents();
+    void setupComponents(const std::string& configPath);
     
     /**
      * @brief Запускает все сервисы
@@ -98,8 +119,8 @@ private:
     std::unique_ptr<Logger> _logger;
     
     // Хранение данных
-    std::unique_ptr<InMemorySessionRepository> _sessionRepo;
-    std::unique_ptr<FileCdrRepository> _cdrRepo;
+    std::unique_ptr<ISessionRepository> _sessionRepo;
+    std::unique_ptr<ICdrRepository> _cdrRepo;
     
     // Бизнес-логика
     std::unique_ptr<Blacklist> _blacklist;
@@ -107,6 +128,7 @@ private:
     std::unique_ptr<SessionManager> _sessionManager;
     std::unique_ptr<GracefulShutdownManager> _shutdownManager;
     std::unique_ptr<SessionCleaner> _sessionCleaner;
+    std::unique_ptr<BlacklistReloader> _blacklistReloader;
     
     // Серверы
     std::unique_ptr<UdpServer> _udpServer;
@@ -0,0 +1,121 @@
+#include <BlacklistReloader.h>
+#include <stdexcept>
+#include <utility>
+#include <sys/stat.h>
+
+BlacklistReloader::BlacklistReloader(std::shared_ptr<Blacklist> blacklist,
+                                     std::string filePath,
+                                     std::shared_ptr<Logger> logger,
+                                     std::chrono::milliseconds watchInterval)
+    : _blacklist(std::move(blacklist)),
+      _filePath(std::move(filePath)),
+      _logger(std::move(logger)),
+      _watchInterval(watchInterval) {
+
+    if (!_blacklist) throw std::invalid_argument("blacklist cannot be null");
+    if (!_logger) throw std::invalid_argument("logger cannot be null");
+    if (_filePath.empty()) throw std::invalid_argument("filePath cannot be empty");
+    if (_watchInterval.count() < 0) throw std::invalid_argument("watchInterval cannot be negative");
+
+    // Текущее содержимое считается загруженным из текущей версии файла
+    _loadedStamp = readStamp();
+
+    _logger->info("BlacklistReloader initialized for " + _filePath + ", watch interval: " +
+                  std::to_string(_watchInterval.count()) + "ms");
+}
+
+BlacklistReloader::~BlacklistReloader() {
+    stop();
+}
+
+bool BlacklistReloader::start() {
+    if (_watchInterval.count() == 0) {
+        _logger->debug("BlacklistReloader.start: File watch disabled");
+        return false;
+    }
+    if (_running.exchange(true)) {
+        _logger->debug("BlacklistReloader.start: Already running, ignoring request");
+        return false;
+    }
+
+    _logger->info("Starting blacklist file watch");
+    _watcherThread = std::thread(&BlacklistReloader::watcherWorker, this);
+    return true;
+}
+
+void BlacklistReloader::stop() {
+    if (!_running.exchange(false)) {
+        return;
+    }
+
+    _cv.notify_all();
+
+    if (_watcherThread.joinable()) {
+        _watcherThread.join();
+    }
+
+    _logger->info("Blacklist file watch stopped");
+}
+
+size_t BlacklistReloader::reload() {
+    std::lock_guard<std::mutex> lock(_reloadMutex);
+
+    // Версия фиксируется до чтения: изменение во время загрузки будет замечено повторно
+    _loadedStamp = readStamp();
+
+    auto startTime = std::chrono::steady_clock::now();
+    Blacklist loaded = Blacklist::loadFromFile(_filePath);
+    _blacklist->replace(loaded);
+
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime);
+    _logger->info("Blacklist reloaded from " + _filePath + ": " + std::to_string(loaded.size()) +
+                  " items in " + std::to_string(duration.count()) + "ms");
+    return loaded.size();
+}
+
+BlacklistReloader::FileStamp BlacklistReloader::readStamp() const {
+    struct stat fileStat{};
+    if (stat(_filePath.c_str(), &fileStat) != 0) {
+        return {};
+    }
+
+    FileStamp stamp;
+    stamp.modifiedNs = static_cast<int64_t>(fileStat.st_mtim.tv_sec) * 1000000000LL + fileStat.st_mtim.tv_nsec;
+    stamp.size = fileStat.st_size;
+    stamp.inode = fileStat.st_ino;
+    return stamp;
+}
+
+void BlacklistReloader::watcherWorker() {
+    _logger->debug("Blacklist watcher thread started");
+
+    while (_running) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait_for(lock, _watchInterval, [this]() { return !_running; });
+        }
+        if (!_running) {
+            break;
+        }
+
+        FileStamp stamp = readStamp();
+        bool changed;
+        {
+            std::lock_guard<std::mutex> lock(_reloadMutex);
+            changed = stamp != FileStamp{} && stamp != _loadedStamp;
+        }
+        if (!changed) {
+            continue;
+        }
+
+        try {
+            reload();
+        } catch (const std::exception& e) {
+            // Прежний список остается; повторная попытка - после следующего изменения файла
+            _logger->error("Blacklist reload failed, keeping previous list: " + std::string(e.what()));
+        }
+    }
+
+    _logger->debug("Blacklist watcher thread terminated");
+}
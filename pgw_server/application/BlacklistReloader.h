@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Blacklist.h>
+#include <Logger.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <sys/types.h>
+
+/**
+ * @brief Класс для перезагрузки черного списка из файла без перезапуска сервера
+ *
+ * Новый список строится в вызывающем потоке (HTTP-обработчик или поток наблюдения),
+ * а затем публикуется в Blacklist атомарной заменой снимка, поэтому проверки
+ * в UDP-потоках не блокируются. При ошибке загрузки остается прежний список.
+ * Поток наблюдения периодически сравнивает время изменения, размер и inode файла
+ * и перезагружает список при их изменении (в том числе при замене файла через rename).
+ * Файл должен заменяться только через rename: изменение на месте может быть
+ * замечено посреди записи, и тогда загрузится неполный текстовый список.
+ */
+class BlacklistReloader {
+public:
+    /**
+     * @brief Создает перезагрузчик черного списка
+     * @param blacklist Указатель на черный список, в который публикуется новое содержимое
+     * @param filePath Путь к файлу черного списка
+     * @param logger Указатель на логгер
+     * @param watchInterval Период проверки изменения файла (0 - наблюдение отключено)
+     */
+    BlacklistReloader(std::shared_ptr<Blacklist> blacklist,
+                      std::string filePath,
+                      std::shared_ptr<Logger> logger,
+                      std::chrono::milliseconds watchInterval = std::chrono::milliseconds(1000));
+
+    /**
+     * @brief Деструктор, останавливает поток наблюдения
+     */
+    ~BlacklistReloader();
+
+    // Запрещаем копирование и перемещение
+    BlacklistReloader(const BlacklistReloader&) = delete;
+    BlacklistReloader& operator=(const BlacklistReloader&) = delete;
+    BlacklistReloader(BlacklistReloader&&) = delete;
+    BlacklistReloader& operator=(BlacklistReloader&&) = delete;
+
+    /**
+     * @brief Запускает наблюдение за файлом
+     * @return true если поток наблюдения запущен, false если уже запущен или наблюдение отключено
+     */
+    bool start();
+
+    /**
+     * @brief Останавливает наблюдение за файлом
+     */
+    void stop();
+
+    /**
+     * @brief Загружает файл и публикует новый черный список
+     * @return Количество IMSI в новом списке
+     * @throws std::runtime_error если файл не удалось загрузить (прежний список сохраняется)
+     */
+    size_t reload();
+
+private:
+    /**
+     * @brief Признаки версии файла, по которым определяется его изменение
+     */
+    struct FileStamp {
+        int64_t modifiedNs = 0;     // Время последнего изменения, нс
+        off_t size = 0;             // Размер файла
+        ino_t inode = 0;            // Номер inode (меняется при замене через rename)
+
+        bool operator==(const FileStamp&) const = default;
+    };
+
+    /**
+     * @brief Считывает признаки версии файла
+     * @return Признаки версии (нулевые, если файл недоступен)
+     */
+    [[nodiscard]] FileStamp readStamp() const;
+
+    /**
+     * @brief Рабочий метод потока наблюдения
+     */
+    void watcherWorker();
+
+    std::shared_ptr<Blacklist> _blacklist;          // Черный список
+    std::string _filePath;                          // Путь к файлу черного списка
+    std::shared_ptr<Logger> _logger;                // Логгер
+    std::chrono::milliseconds _watchInterval;       // Период проверки изменения файла
+
+    std::mutex _reloadMutex;                        // Сериализует перезагрузки
+    FileStamp _loadedStamp;                         // Версия файла последней попытки загрузки
+
+    std::atomic<bool> _running{false};              // Флаг работы потока наблюдения
+    std::thread _watcherThread;                     // Поток наблюдения
+    std::mutex _mutex;                              // Мьютекс для условной переменной
+    std::condition_variable _cv;                    // Условная переменная для быстрой остановки
+};
@@ -81,6 +81,7 @@ void GracefulShutdownManager::shutdownWorker() {
         
         if (totalSessions == 0) {
             _logger->info("No active sessions to shutdown, process complete");
+            _sessionManager->flushCdr();
             _shutdownComplete.store(true);
             _shutdownCondition.notify_all();
             return;
@@ -116,10 +117,10 @@ void GracefulShutdownManager::shutdownWorker() {
                                       std::to_string(totalSessions) + " (" + std::to_string(percent) + "%)");
                     }
                 } else {
-                    _logger->warn("Failed to remove session for IMSI: " + imsi + " during shutdown");
+                    _logger->warn("Failed to remove session for IMSI: " + imsi.toString() + " during shutdown");
                 }
             } else {
-                _logger->debug("Session for IMSI: " + imsi + " no longer active, skipping");
+                _logger->debug("Session for IMSI: " + imsi.toString() + " no longer active, skipping");
             }
             // Если сессий больше не осталось — завершить shutdown немедленно
             if (_sessionManager->getActiveSessionsCount() == 0) {
@@ -147,6 +148,9 @@ void GracefulShutdownManager::shutdownWorker() {
         _logger->critical("Critical error during graceful shutdown: " + std::string(e.what()));
     }
     
+    // Дописываем CDR, накопленные при удалении сессий
+    _sessionManager->flushCdr();
+    
     // Устанавливаем флаг завершения и уведомляем ожидающие потоки
     _shutdownComplete.store(true);
     _shutdownCondition.notify_all();
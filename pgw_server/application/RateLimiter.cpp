@@ -1,91 +1,174 @@
 #include <RateLimiter.h>
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
 
 RateLimiter::RateLimiter(uint32_t maxRequestsPerMinute)
-    : _tokenRate(maxRequestsPerMinute / 60.0),  // Преобразуем в токенов в секунду
-      _maxTokens(std::max(maxRequestsPerMinute / 10.0, 1.0)),   // Максимальный размер бакета - 1/10 от минутного лимита, но не меньше 1
-      _logger(nullptr)
+    : RateLimiter(maxRequestsPerMinute, nullptr)
 {
 }
 
-RateLimiter::RateLimiter(uint32_t maxRequestsPerMinute, std::shared_ptr<Logger> logger)
-    : _tokenRate(maxRequestsPerMinute / 60.0),  // Преобразуем в токенов в секунду
-      _maxTokens(std::max(maxRequestsPerMinute / 10.0, 1.0)),   // Максимальный размер бакета - 1/10 от минутного лимита, но не меньше 1
+RateLimiter::RateLimiter(uint32_t maxRequestsPerMinute, std::shared_ptr<Logger> logger,
+                         RateLimiterOptions options)
+    : _shards(options.shardCount),
+      _refillPerNs(maxRequestsPerMinute),   // TOKEN_UNIT равен числу нс в минуте
+      _capacity(capacityFor(maxRequestsPerMinute)),
+      _idleHorizonNs(std::numeric_limits<int64_t>::max()),
+      _maxBucketsPerShard(0),
       _logger(std::move(logger))
 {
-    if (_logger) {
-        _logger->debug("RateLimiter initialized: " + std::to_string(maxRequestsPerMinute) + 
-                      " req/min, token rate: " + std::to_string(_tokenRate) + 
-                      " tokens/sec, max tokens: " + std::to_string(_maxTokens));
+    if (options.shardCount == 0) throw std::invalid_argument("shardCount must be positive");
+    if (options.maxBuckets < options.shardCount) throw std::invalid_argument("maxBuckets must be at least shardCount");
+
+    // Пустой bucket пополняется полностью за capacity / refillPerNs наносекунд
+    if (_refillPerNs > 0) {
+        _idleHorizonNs = static_cast<int64_t>((_capacity + _refillPerNs - 1) / _refillPerNs);
     }
+
+    _maxBucketsPerShard = options.maxBuckets / options.shardCount;
+
+    PGW_LOG_DEBUG(_logger, "RateLimiter initialized: {} req/min, max tokens: {:.3f}, shards: {}, max buckets: {}",
+                  maxRequestsPerMinute, static_cast<double>(_capacity) / TOKEN_UNIT,
+                  options.shardCount, _maxBucketsPerShard * options.shardCount);
 }
 
-bool RateLimiter::allowRequest(const std::string& imsi) {
-    std::lock_guard<std::mutex> lock(_mutex);
-    
+bool RateLimiter::allowRequest(const Imsi& imsi) {
+    int64_t nowNs = nowNanoseconds();
+    Shard& shard = shardFor(imsi);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
     // Получаем или создаем bucket для данного IMSI
-    auto& bucket = _buckets[imsi];
-    bool isNewBucket = (bucket.lastRefillTime == std::chrono::steady_clock::time_point());
-    
-    // Инициализируем или обновляем bucket
-    initializeOrUpdateBucket(bucket);
-    
+    auto it = shard.buckets.find(imsi);
+    if (it == shard.buckets.end()) {
+        makeRoom(shard, imsi, nowNs);
+
+        // Новый bucket заполнен полностью
+        it = shard.buckets.emplace(imsi, TokenBucket{_capacity, nowNs}).first;
+        PGW_LOG_DEBUG(_logger, "Created new rate limit bucket for IMSI: {}", imsi.toString());
+    } else {
+        refillTokens(it->second, nowNs);
+    }
+
+    TokenBucket& bucket = it->second;
+
     // Проверяем, есть ли доступный токен
-    if (bucket.tokens >= 1.0) {
+    if (bucket.tokens >= TOKEN_UNIT) {
         // Забираем токен
-        bucket.tokens -= 1.0;
-        // Обновляем время последнего использования
-        bucket.lastUseTime = std::chrono::steady_clock::now();
-        
-        if (_logger && isNewBucket) {
-            _logger->debug("Created new rate limit bucket for IMSI: " + imsi);
-        }
-        
+        bucket.tokens -= TOKEN_UNIT;
         return true;
     }
-    
+
     // Нет доступных токенов, запрос отклоняется
-    if (_logger) {
-        _logger->warn("Rate limit exceeded for IMSI: " + imsi + 
-                     ", available tokens: " + std::to_string(bucket.tokens));
-    }
+    PGW_LOG_WARN(_logger, "Rate limit exceeded for IMSI: {}, available tokens: {:.6f}",
+                 imsi.toString(), static_cast<double>(bucket.tokens) / TOKEN_UNIT);
     return false;
 }
-    
-TokenBucket& RateLimiter::initializeOrUpdateBucket(TokenBucket& bucket) const {
-    // Если это первый запрос для данного IMSI, инициализируем bucket
-    if (bucket.lastRefillTime == std::chrono::steady_clock::time_point()) {
-        bucket.tokens = _maxTokens;
-        bucket.tokenRate = _tokenRate;
-        bucket.maxTokens = _maxTokens;
-        bucket.lastRefillTime = std::chrono::steady_clock::now();
-        bucket.lastUseTime = bucket.lastRefillTime;
-    } else {
-        // Пополняем токены в соответствии с прошедшим временем
-        refillTokens(bucket);
+
+size_t RateLimiter::evictIdleBuckets() {
+    return evictIdleBuckets(std::chrono::steady_clock::now());
+}
+
+size_t RateLimiter::evictIdleBuckets(std::chrono::steady_clock::time_point now) {
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    size_t evicted = 0;
+
+    for (auto& shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        evicted += sweepIdle(shard, nowNs);
+    }
+
+    if (evicted > 0) {
+        PGW_LOG_DEBUG(_logger, "Evicted {} idle rate limit buckets", evicted);
+    }
+    return evicted;
+}
+
+size_t RateLimiter::getBucketCount() const {
+    size_t count = 0;
+    for (const auto& shard : _shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.buckets.size();
     }
+    return count;
+}
+
+RateLimiter::Shard& RateLimiter::shardFor(const Imsi& imsi) {
+    // Старшие биты хеша не коррелируют с номером корзины unordered_map внутри шарда
+    uint64_t hash = imsi.hash() * 0x9E3779B97F4A7C15ULL;
+    return _shards[(hash >> 32) % _shards.size()];
+}
 
-    return bucket;
+uint64_t RateLimiter::capacityFor(uint32_t maxRequestsPerMinute) {
+    // Проверка до умножения: при большем лимите произведение не помещается в uint64_t
+    if (maxRequestsPerMinute > MAX_REQUESTS_PER_MINUTE) {
+        throw std::invalid_argument("maxRequestsPerMinute is too large: " + std::to_string(maxRequestsPerMinute));
+    }
+    return std::max(static_cast<uint64_t>(maxRequestsPerMinute) * TOKEN_UNIT / 10, TOKEN_UNIT);
 }
 
-void RateLimiter::refillTokens(TokenBucket& bucket) const {
-    // Текущее время
-    auto now = std::chrono::steady_clock::now();
-    
+void RateLimiter::refillTokens(TokenBucket& bucket, int64_t nowNs) const {
     // Вычисляем прошедшее время с момента последнего пополнения
-    auto timeElapsed = std::chrono::duration_cast<std::chrono::duration<double>>(
-        now - bucket.lastRefillTime).count();
-    
-    // Вычисляем количество новых токенов
-    double newTokens = timeElapsed * bucket.tokenRate;
-    
-    // Обновляем состояние bucket
-    double oldTokens = bucket.tokens;
-    bucket.tokens = std::min(bucket.tokens + newTokens, bucket.maxTokens);
-    bucket.lastRefillTime = now;
-    
-    if (_logger && bucket.tokens > oldTokens + 0.1) { // Логируем только если добавили значимое количество токенов
-        _logger->debug("Refilled tokens: " + std::to_string(bucket.tokens - oldTokens) + 
-                      ", new total: " + std::to_string(bucket.tokens));
+    int64_t elapsedNs = nowNs - bucket.lastRefillNs;
+    if (elapsedNs <= 0) {
+        return;
+    }
+
+    // За время полного пополнения bucket гарантированно заполнен: ограничиваем интервал,
+    // чтобы произведение не переполнилось
+    if (elapsedNs >= _idleHorizonNs) {
+        bucket.tokens = _capacity;
+    } else {
+        bucket.tokens = std::min(bucket.tokens + static_cast<uint64_t>(elapsedNs) * _refillPerNs, _capacity);
+    }
+    bucket.lastRefillNs = nowNs;
+}
+
+void RateLimiter::makeRoom(Shard& shard, const Imsi& imsi, int64_t nowNs) const {
+    // Амортизированная очистка: полный проход запускается, когда шард вырос вдвое
+    // с прошлой очистки, либо не чаще одного раза за время полного пополнения
+    bool grown = shard.buckets.size() >= shard.sweepThreshold;
+    bool due = shard.buckets.size() >= MIN_SWEEP_THRESHOLD && nowNs - shard.lastSweepNs >= _idleHorizonNs;
+    if (grown || due) {
+        sweepIdle(shard, nowNs);
+        shard.sweepThreshold = std::max(shard.buckets.size() * 2, MIN_SWEEP_THRESHOLD);
+        shard.lastSweepNs = nowNs;
+    }
+
+    if (shard.buckets.size() < _maxBucketsPerShard) {
+        return;
+    }
+
+    // Шард заполнен активными bucket'ами: вытесняем самый давно пополнявшийся из выборки,
+    // начиная с корзины, определяемой новым IMSI
+    size_t bucketCount = shard.buckets.bucket_count();
+    size_t index = shard.buckets.bucket(imsi);
+    auto victim = shard.buckets.end();
+    size_t sampled = 0;
+
+    for (size_t scanned = 0; scanned < bucketCount && sampled < EVICTION_SAMPLE_SIZE; ++scanned) {
+        for (auto local = shard.buckets.begin(index); local != shard.buckets.end(index) &&
+                                                      sampled < EVICTION_SAMPLE_SIZE; ++local) {
+            if (victim == shard.buckets.end() || local->second.lastRefillNs < victim->second.lastRefillNs) {
+                victim = shard.buckets.find(local->first);
+            }
+            ++sampled;
+        }
+        index = (index + 1) % bucketCount;
     }
+
+    if (victim != shard.buckets.end()) {
+        PGW_LOG_DEBUG(_logger, "Rate limit bucket table full, evicting IMSI: {}", victim->first.toString());
+        shard.buckets.erase(victim);
+    }
+}
+
+size_t RateLimiter::sweepIdle(Shard& shard, int64_t nowNs) const {
+    return std::erase_if(shard.buckets, [this, nowNs](const auto& entry) {
+        return nowNs - entry.second.lastRefillNs >= _idleHorizonNs;
+    });
+}
+
+int64_t RateLimiter::nowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
 }
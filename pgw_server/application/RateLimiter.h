@@ -4,31 +4,51 @@
 #include <unordered_map>
 #include <mutex>
 #include <chrono>
+#include <vector>
+#include <cstdint>
 #include <Logger.h>
+#include <Imsi.h>
 #include <memory>
 
 /**
- * @brief Структура для хранения состояния token bucket
- * 
- * Реализует алгоритм Token Bucket для ограничения скорости запросов.
- * Токены пополняются со временем с заданной скоростью до максимального значения.
+ * @brief Состояние token bucket в целочисленном представлении с фиксированной точкой
+ *
+ * Токены хранятся в единицах 1/TOKEN_UNIT токена, где TOKEN_UNIT равен числу
+ * наносекунд в минуте. При лимите N запросов в минуту bucket пополняется ровно
+ * на N единиц за наносекунду, поэтому пополнение вычисляется без округлений.
  */
 struct TokenBucket {
-    double tokens{};                     // Текущее количество токенов
-    double tokenRate{};                  // Скорость пополнения токенов (токенов в секунду)
-    double maxTokens{};                  // Максимальное количество токенов
-    std::chrono::steady_clock::time_point lastRefillTime;  // Время последнего пополнения
-    std::chrono::steady_clock::time_point lastUseTime;     // Время последнего использования
+    uint64_t tokens{};                   // Текущее количество токенов (в единицах 1/TOKEN_UNIT)
+    int64_t lastRefillNs{};              // Время последнего пополнения (steady_clock, нс)
+};
+
+/**
+ * @brief Параметры хранилища bucket'ов ограничителя скорости
+ */
+struct RateLimiterOptions {
+    size_t shardCount = 16;              // Количество шардов (независимых мьютексов)
+    size_t maxBuckets = 1000000;         // Максимальное количество отслеживаемых IMSI
 };
 
 /**
  * @brief Класс для ограничения скорости запросов
- * 
+ *
  * Использует алгоритм Token Bucket для ограничения скорости запросов.
  * Каждый IMSI имеет свой bucket, который пополняется со временем.
+ * Bucket'ы разбиты по хешу IMSI на шарды со своими мьютексами.
+ *
+ * Bucket, простаивающий дольше времени полного пополнения, неотличим от нового,
+ * поэтому такие bucket'ы удаляются амортизированно: при двукратном росте шарда
+ * и не чаще одного раза за время полного пополнения. Если шард
+ * достиг предела даже после очистки, вытесняется самый давно пополнявшийся
+ * bucket из небольшой выборки.
  */
 class RateLimiter {
 public:
+    static constexpr uint64_t TOKEN_UNIT = 60ULL * 1000 * 1000 * 1000;   // Единиц в одном токене (нс в минуте)
+    static constexpr uint32_t MAX_REQUESTS_PER_MINUTE = 100000000;      // Лимит * TOKEN_UNIT и сумма токенов с пополнением < 2^64
+    static constexpr size_t EVICTION_SAMPLE_SIZE = 8;                   // Кандидатов на вытеснение при заполненном шарде
+
     /**
      * @brief Создает ограничитель скорости запросов
      * @param maxRequestsPerMinute Максимальное количество запросов в минуту
@@ -39,9 +59,13 @@ public:
      * @brief Создает ограничитель скорости запросов с логированием
      * @param maxRequestsPerMinute Максимальное количество запросов в минуту
      * @param logger Указатель на логгер
+     * @param options Параметры хранилища bucket'ов
+     * @throws std::invalid_argument если лимит превышает MAX_REQUESTS_PER_MINUTE,
+     *         shardCount равен 0 или maxBuckets меньше shardCount
      */
-    RateLimiter(uint32_t maxRequestsPerMinute, std::shared_ptr<Logger> logger);
-    
+    RateLimiter(uint32_t maxRequestsPerMinute, std::shared_ptr<Logger> logger,
+                RateLimiterOptions options = {});
+
     ~RateLimiter() = default;
 
     // Запрещаем копирование и перемещение
@@ -55,25 +79,90 @@ public:
      * @param imsi IMSI абонента
      * @return true если запрос можно обработать, иначе false
      */
-    [[nodiscard]] bool allowRequest(const std::string& imsi);
+    [[nodiscard]] bool allowRequest(const Imsi& imsi);
+
+    /**
+     * @brief Удаляет bucket'ы, простаивающие дольше времени полного пополнения
+     * @return Количество удаленных bucket'ов
+     */
+    size_t evictIdleBuckets();
+
+    /**
+     * @brief Удаляет bucket'ы, простаивающие дольше времени полного пополнения к заданному моменту
+     * @param now Момент проверки (steady_clock); позволяет проверить очистку без ожидания
+     * @return Количество удаленных bucket'ов
+     */
+    size_t evictIdleBuckets(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Возвращает количество отслеживаемых bucket'ов
+     * @return Количество bucket'ов во всех шардах
+     */
+    [[nodiscard]] size_t getBucketCount() const;
 
 private:
+    static constexpr size_t MIN_SWEEP_THRESHOLD = 1024; // Размер шарда, ниже которого очистка не запускается
+
+    /**
+     * @brief Шард bucket'ов со своим мьютексом
+     */
+    struct alignas(64) Shard {
+        std::unordered_map<Imsi, TokenBucket> buckets;  // Bucket'ы шарда
+        size_t sweepThreshold = MIN_SWEEP_THRESHOLD;    // Размер, при котором запускается очистка
+        int64_t lastSweepNs = 0;                        // Время последней очистки (steady_clock, нс)
+        mutable std::mutex mutex;                       // Мьютекс шарда
+    };
+
+    /**
+     * @brief Возвращает шард для IMSI
+     * @param imsi IMSI абонента
+     * @return Шард, в котором хранится bucket
+     */
+    Shard& shardFor(const Imsi& imsi);
+
+    /**
+     * @brief Пополняет bucket в соответствии с прошедшим временем
+     * @param bucket Bucket для пополнения
+     * @param nowNs Текущее время (steady_clock, нс)
+     */
+    void refillTokens(TokenBucket& bucket, int64_t nowNs) const;
+
+    /**
+     * @brief Освобождает место в шарде перед добавлением нового bucket'а
+     * @param shard Шард (мьютекс должен быть захвачен)
+     * @param imsi IMSI, для которого добавляется bucket
+     * @param nowNs Текущее время (steady_clock, нс)
+     */
+    void makeRoom(Shard& shard, const Imsi& imsi, int64_t nowNs) const;
+
     /**
-     * @brief Обновляет состояние bucket для указанного IMSI
-     * @param bucket Bucket для обновления
+     * @brief Удаляет простаивающие bucket'ы шарда
+     * @param shard Шард (мьютекс должен быть захвачен)
+     * @param nowNs Текущее время (steady_clock, нс)
+     * @return Количество удаленных bucket'ов
      */
-    void refillTokens(TokenBucket& bucket) const;
-    
+    size_t sweepIdle(Shard& shard, int64_t nowNs) const;
+
     /**
-     * @brief Инициализирует новый bucket или обновляет существующий
-     * @param bucket Bucket для инициализации
-     * @return Ссылка на инициализированный bucket
+     * @brief Проверяет лимит и вычисляет емкость bucket'а
+     *
+     * Емкость - 1/10 минутного лимита, но не меньше одного токена.
+     * @param maxRequestsPerMinute Максимальное количество запросов в минуту
+     * @return Емкость в единицах 1/TOKEN_UNIT
+     * @throws std::invalid_argument если лимит превышает MAX_REQUESTS_PER_MINUTE
      */
-    TokenBucket& initializeOrUpdateBucket(TokenBucket& bucket) const;
-    
-    std::unordered_map<std::string, TokenBucket> _buckets;  // Хранилище bucket'ов
-    mutable std::mutex _mutex;                              // Мьютекс для потокобезопасности
-    double _tokenRate;                                      // Скорость пополнения токенов (токенов в секунду)
-    double _maxTokens;                                      // Максимальное количество токенов
+    static uint64_t capacityFor(uint32_t maxRequestsPerMinute);
+
+    /**
+     * @brief Возвращает текущее время steady_clock в наносекундах
+     * @return Время в наносекундах
+     */
+    static int64_t nowNanoseconds();
+
+    std::vector<Shard> _shards;                             // Шарды bucket'ов
+    uint64_t _refillPerNs;                                  // Скорость пополнения (единиц за наносекунду)
+    uint64_t _capacity;                                     // Емкость bucket'а (в единицах 1/TOKEN_UNIT)
+    int64_t _idleHorizonNs;                                 // Время полного пополнения пустого bucket'а, нс
+    size_t _maxBucketsPerShard;                             // Предел bucket'ов на шард
     std::shared_ptr<Logger> _logger;                        // Логгер
-};
\ No newline at end of file
+};
@@ -24,102 +24,101 @@ SessionManager::SessionManager(std::shared_ptr<ISessionRepository> sessionRepo,
     _logger->info("Session manager service initialized");
 }
 
-SessionResult SessionManager::createSession(const std::string& imsi) const {
-    _logger->debug("Processing session creation request for IMSI: " + imsi);
+SessionResult SessionManager::createSession(const Imsi& imsi) const {
+    PGW_LOG_DEBUG(_logger, "Processing session creation request for IMSI: {}", imsi.toString());
+    StageTimer timer;
     
     // Проверка черного списка
-    if (isImsiBlacklisted(imsi)) {
-        _logger->info("Session rejected: IMSI " + imsi + " is blacklisted");
+    bool blacklisted = isImsiBlacklisted(imsi);
+    timer.mark(LatencyStage::BLACKLIST);
+    if (blacklisted) {
+        PGW_LOG_INFO(_logger, "Session rejected: IMSI {} is blacklisted", imsi.toString());
         logCdr(imsi, "rejected_blacklist");
+        timer.mark(LatencyStage::CDR);
         ServerMetrics::incRejectedRequests();
-        return SessionResult::REJECTED;
+        return SessionResult::REJECTED_BLACKLIST;
     }
     
     // Проверка ограничения скорости
-    if (!_rateLimiter->allowRequest(imsi)) {
-        _logger->warn("Session rejected: Rate limit exceeded for IMSI " + imsi);
+    bool allowed = _rateLimiter->allowRequest(imsi);
+    timer.mark(LatencyStage::RATE_LIMIT);
+    if (!allowed) {
+        PGW_LOG_WARN(_logger, "Session rejected: Rate limit exceeded for IMSI {}", imsi.toString());
         logCdr(imsi, "rejected_rate_limit");
+        timer.mark(LatencyStage::CDR);
         ServerMetrics::incRejectedRequests();
-        return SessionResult::REJECTED;
-    }
-    
-    // Проверка существования сессии
-    if (_sessionRepo->sessionExists(imsi)) {
-        _sessionRepo->refreshSession(imsi);
-        _logger->debug("Session already exists for IMSI: " + imsi + ", refreshed");
-        ServerMetrics::incProcessedRequests();
-        return SessionResult::CREATED;
+        return SessionResult::REJECTED_RATE_LIMIT;
     }
     
     try {
-        // Создание новой сессии с логгером
-        Session session(imsi, _logger);
-        
-        // Сохранение сессии в репозитории
-        if (_sessionRepo->addSession(session)) {
-            _logger->info("New session successfully created for IMSI: " + imsi);
-            logCdr(imsi, "create");
+        // Создание или обновление сессии за одно обращение к репозиторию
+        auto upsert = _sessionRepo->createOrRefresh(imsi);
+        timer.mark(LatencyStage::SESSION_STORE);
+        if (upsert == UpsertResult::REFRESHED) {
+            PGW_LOG_DEBUG(_logger, "Session already exists for IMSI: {}, refreshed", imsi.toString());
             ServerMetrics::incProcessedRequests();
-            return SessionResult::CREATED;
-        } else {
-            _logger->error("Repository error: Failed to add session for IMSI: " + imsi);
-            return SessionResult::ERROR;
+            return SessionResult::REFRESHED;
         }
+        
+        PGW_LOG_INFO(_logger, "New session successfully created for IMSI: {}", imsi.toString());
+        logCdr(imsi, "create");
+        timer.mark(LatencyStage::CDR);
+        ServerMetrics::incProcessedRequests();
+        return SessionResult::CREATED;
     } catch (const std::exception& e) {
-        _logger->error("Session creation failed for IMSI " + imsi + ": " + e.what());
+        _logger->error("Session creation failed for IMSI " + imsi.toString() + ": " + e.what());
         return SessionResult::ERROR;
     }
 }
 
-bool SessionManager::isSessionActive(const std::string& imsi) const {
+bool SessionManager::isSessionActive(const Imsi& imsi) const {
     bool active = _sessionRepo->sessionExists(imsi);
-    _logger->debug("Session status check for IMSI " + imsi + ": " + (active ? "active" : "not active"));
+    PGW_LOG_DEBUG(_logger, "Session status check for IMSI {}: {}", imsi.toString(), active ? "active" : "not active");
     return active;
 }
 
-bool SessionManager::removeSession(const std::string& imsi, const std::string& action) const {
-    _logger->debug("Removing session for IMSI: " + imsi + " (reason: " + action + ")");
+bool SessionManager::removeSession(const Imsi& imsi, const std::string& action) const {
+    PGW_LOG_DEBUG(_logger, "Removing session for IMSI: {} (reason: {})", imsi.toString(), action);
     
     if (!_sessionRepo->sessionExists(imsi)) {
-        _logger->debug("Session not found for IMSI: " + imsi + ", nothing to remove");
+        PGW_LOG_DEBUG(_logger, "Session not found for IMSI: {}, nothing to remove", imsi.toString());
         return false;
     }
     
     if (_sessionRepo->removeSession(imsi)) {
         logCdr(imsi, action);
-        _logger->info("Session for IMSI: " + imsi + " successfully removed (" + action + ")");
+        PGW_LOG_INFO(_logger, "Session for IMSI: {} successfully removed ({})", imsi.toString(), action);
         return true;
     } else {
-        _logger->error("Repository error: Failed to remove session for IMSI: " + imsi);
+        _logger->error("Repository error: Failed to remove session for IMSI: " + imsi.toString());
         return false;
     }
 }
 
 size_t SessionManager::cleanExpiredSessions(std::chrono::seconds timeout, const std::atomic<bool>* stopFlag) const {
-    _logger->debug("Starting expired sessions cleanup (timeout: " + std::to_string(timeout.count()) + "s)");
-    
-    // Получаем все истекшие сессии
-    auto expiredSessions = _sessionRepo->getExpiredSessions(timeout.count());
-
+    PGW_LOG_DEBUG(_logger, "Starting expired sessions cleanup (timeout: {}s)", timeout.count());
     
     size_t removedCount = 0;
-    for (const auto& session : expiredSessions) {
+    while (true) {
         if (stopFlag && !stopFlag->load()) {
             _logger->debug("Session cleanup interrupted by stop flag");
             break;
         }
-        const auto& imsi = session.getImsi();
-        if (_sessionRepo->removeSession(imsi)) {
+        
+        // Удаляем очередную пачку самых старых истекших сессий
+        auto removedImsis = _sessionRepo->removeExpiredSessions(timeout.count(), CLEANUP_BATCH_SIZE);
+        for (const auto& imsi : removedImsis) {
             logCdr(imsi, "timeout");
-            removedCount++;
-        } else {
-            _logger->warn("Failed to remove expired session for IMSI: " + imsi);
+        }
+        removedCount += removedImsis.size();
+        
+        if (removedImsis.size() < CLEANUP_BATCH_SIZE) {
+            break;
         }
     }
     
     if (removedCount > 0) {
-        _logger->info("Cleaned " + std::to_string(removedCount) + "/" + 
-                     std::to_string(expiredSessions.size()) + " expired sessions");
+        _logger->info("Cleaned " + std::to_string(removedCount) + " expired sessions");
     }
     
     return removedCount;
@@ -127,28 +126,33 @@ size_t SessionManager::cleanExpiredSessions(std::chrono::seconds timeout, const
 
 size_t SessionManager::getActiveSessionsCount() const {
     size_t count = _sessionRepo->getSessionCount();
-    _logger->debug("Current active sessions count: " + std::to_string(count));
+    PGW_LOG_DEBUG(_logger, "Current active sessions count: {}", count);
     return count;
 }
 
-std::vector<std::string> SessionManager::getAllActiveImsis() const {
+std::vector<Imsi> SessionManager::getAllActiveImsis() const {
     auto imsis = _sessionRepo->getAllImsis();
     return imsis;
 }
 
-void SessionManager::logCdr(const std::string& imsi, const std::string& action) const {
+void SessionManager::flushCdr() const {
+    PGW_LOG_DEBUG(_logger, "Flushing CDR repository");
+    _cdrRepo->flush();
+}
+
+void SessionManager::logCdr(const Imsi& imsi, const std::string& action) const {
     try {
-        _logger->debug("Writing CDR record: IMSI=" + imsi + ", action=" + action);
-        if (!_cdrRepo->writeCdr(imsi, action)) {
-            _logger->error("CDR write failed for IMSI " + imsi + ": repository error");
+        PGW_LOG_DEBUG(_logger, "Writing CDR record: IMSI={}, action={}", imsi.toString(), action);
+        if (!_cdrRepo->writeCdr(imsi.toString(), action)) {
+            _logger->error("CDR write failed for IMSI " + imsi.toString() + ": repository error");
         }
     } catch (const std::exception& e) {
-        _logger->critical("CDR system error for IMSI " + imsi + ": " + e.what());
+        _logger->critical("CDR system error for IMSI " + imsi.toString() + ": " + e.what());
     }
 }
 
-bool SessionManager::isImsiBlacklisted(const std::string& imsi) const {
+bool SessionManager::isImsiBlacklisted(const Imsi& imsi) const {
     bool result = _blacklist->isBlacklisted(imsi);
-    _logger->debug("Blacklist check for IMSI " + imsi + ": " + (result ? "blacklisted" : "not blacklisted"));
+    PGW_LOG_DEBUG(_logger, "Blacklist check for IMSI {}: {}", imsi.toString(), result ? "blacklisted" : "not blacklisted");
     return result;
 } 
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <Blacklist.h>
 #include <RateLimiter.h>
 #include <Logger.h>
+#include <Imsi.h>
 #include <string>
 #include <memory>
 #include <chrono>
@@ -14,9 +15,11 @@
  * @brief Результат создания сессии
  */
 enum class SessionResult {
-    CREATED,
-    REJECTED,
-    ERROR
+    CREATED,                // Создана новая сессия
+    REFRESHED,              // Сессия уже существовала, срок действия продлен
+    REJECTED_BLACKLIST,     // Отклонено: IMSI в черном списке
+    REJECTED_RATE_LIMIT,    // Отклонено: превышено ограничение скорости
+    ERROR                   // Ошибка хранилища сессий
 };
 
 /**
@@ -56,14 +59,14 @@ public:
      * @param imsi IMSI абонента
      * @return Результат создания сессии
      */
-    SessionResult createSession(const std::string& imsi) const;
+    SessionResult createSession(const Imsi& imsi) const;
     
     /**
      * @brief Проверяет, активна ли сессия для указанного IMSI
      * @param imsi IMSI абонента
      * @return true если сессия активна, иначе false
      */
-    [[nodiscard]] bool isSessionActive(const std::string& imsi) const;
+    [[nodiscard]] bool isSessionActive(const Imsi& imsi) const;
     
     /**
      * @brief Удаляет сессию для указанного IMSI
@@ -71,11 +74,15 @@ public:
      * @param action Действие для записи в CDR
      * @return true если сессия успешно удалена, иначе false
      */
-    bool removeSession(const std::string& imsi, const std::string& action) const;
+    bool removeSession(const Imsi& imsi, const std::string& action) const;
     
     /**
      * @brief Очищает истекшие сессии
+     * 
+     * Сессии удаляются пачками по CLEANUP_BATCH_SIZE, чтобы не удерживать блокировку
+     * репозитория надолго; флаг остановки проверяется между пачками.
      * @param timeout Таймаут в секундах
+     * @param stopFlag Флаг работы (очистка прерывается, когда он становится false)
      * @return Количество удаленных сессий
      */
     [[nodiscard]] size_t cleanExpiredSessions(std::chrono::seconds timeout, const std::atomic<bool>* stopFlag = nullptr) const;
@@ -90,22 +97,29 @@ public:
      * @brief Возвращает список всех активных IMSI
      * @return Вектор IMSI
      */
-    [[nodiscard]] std::vector<std::string> getAllActiveImsis() const;
+    [[nodiscard]] std::vector<Imsi> getAllActiveImsis() const;
+    
+    /**
+     * @brief Дожидается сохранения всех записанных CDR
+     */
+    void flushCdr() const;
 
 private:
+    static constexpr size_t CLEANUP_BATCH_SIZE = 1024; // Максимум сессий, удаляемых за одно обращение к репозиторию
+
     /**
      * @brief Записывает CDR для указанного IMSI и действия
      * @param imsi IMSI абонента
      * @param action Действие
      */
-    void logCdr(const std::string& imsi, const std::string& action) const;
+    void logCdr(const Imsi& imsi, const std::string& action) const;
     
     /**
      * @brief Проверяет, находится ли IMSI в черном списке
      * @param imsi IMSI для проверки
      * @return true если IMSI в черном списке, иначе false
      */
-    [[nodiscard]] bool isImsiBlacklisted(const std::string& imsi) const;
+    [[nodiscard]] bool isImsiBlacklisted(const Imsi& imsi) const;
 
     std::shared_ptr<ISessionRepository> _sessionRepo;  // Репозиторий сессий
     std::shared_ptr<ICdrRepository> _cdrRepo;          // Репозиторий CDR
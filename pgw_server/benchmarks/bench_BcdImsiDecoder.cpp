@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <BcdImsiDecoder.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t PACKET_COUNT = 1024;  // Количество заранее закодированных пакетов (степень двойки)
+
+/**
+ * @brief Кодирует набор случайных IMSI в пакеты запроса
+ * @return Пакеты: 4 байта заголовка и 8 байт BCD
+ */
+std::vector<std::string> makePackets() {
+    std::mt19937_64 random(42);
+    std::vector<std::string> packets;
+    packets.reserve(PACKET_COUNT);
+    for (size_t i = 0; i < PACKET_COUNT; ++i) {
+        std::string digits = Imsi::fromValue(random() % (Imsi::MAX_VALUE + 1))->toString();
+        std::string packet(BcdImsiDecoder::HEADER_SIZE, '\0');
+        for (size_t j = 0; j < digits.size(); j += 2) {
+            uint8_t high = j + 1 < digits.size() ? digits[j + 1] - '0' : 0x0F;
+            packet.push_back(static_cast<char>((digits[j] - '0') | (high << 4)));
+        }
+        packets.push_back(std::move(packet));
+    }
+    return packets;
+}
+
+/**
+ * @brief Побайтовое декодирование с проверкой каждой цифры ветвлением
+ * @param state Состояние бенчмарка
+ */
+void BM_BcdDecodeScalar(benchmark::State& state) {
+    auto packets = makePackets();
+    size_t index = 0;
+    for (auto _ : state) {
+        const std::string& packet = packets[index++ & (PACKET_COUNT - 1)];
+        benchmark::DoNotOptimize(BcdImsiDecoder::decodeScalar(packet.data(), packet.size()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BcdDecodeScalar);
+
+/**
+ * @brief Декодирование всех 8 байт одним 64-битным словом (SWAR)
+ * @param state Состояние бенчмарка
+ */
+void BM_BcdDecodeSwar(benchmark::State& state) {
+    auto packets = makePackets();
+    size_t index = 0;
+    for (auto _ : state) {
+        const std::string& packet = packets[index++ & (PACKET_COUNT - 1)];
+        benchmark::DoNotOptimize(BcdImsiDecoder::decode(packet.data(), packet.size()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_BcdDecodeSwar);
+
+} // namespace
@@ -0,0 +1,114 @@
+#include <benchmark/benchmark.h>
+#include <Blacklist.h>
+#include <Imsi.h>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <malloc.h>
+#include <string>
+#include <unordered_set>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint64_t IMSI_BASE = 250010000000000ULL;  // Первый IMSI черного списка
+constexpr uint64_t IMSI_STRIDE = 7;                 // Шаг между IMSI списка (промахи попадают между ними)
+constexpr uint64_t QUERY_STEP = 104729;             // Шаг перебора запросов (случайный порядок доступа)
+const char* const BINARY_FILE = "bench_blacklist.bin";
+
+/**
+ * @brief Возвращает объем резидентной памяти процесса
+ * @return Размер в байтах
+ */
+size_t residentBytes() {
+    std::ifstream statm("/proc/self/statm");
+    size_t total = 0;
+    size_t resident = 0;
+    statm >> total >> resident;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+}
+
+/**
+ * @brief Возвращает объем памяти, выделенной через malloc
+ * @return Размер в байтах
+ */
+size_t heapBytes() {
+    return mallinfo2().uordblks;
+}
+
+/**
+ * @brief Записывает бинарный файл черного списка из count IMSI
+ * @param count Количество записей
+ */
+void writeBinaryFile(uint64_t count) {
+    std::ofstream file(BINARY_FILE, std::ios::binary | std::ios::trunc);
+    file.write(Blacklist::BINARY_MAGIC, sizeof(Blacklist::BINARY_MAGIC));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t value = IMSI_BASE + i * IMSI_STRIDE;
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+/**
+ * @brief Поиск в черном списке, загруженном из бинарного файла
+ * @param state Состояние бенчмарка (range(0) - размер списка, range(1) - 1 для попаданий, 0 для промахов)
+ */
+void BM_BlacklistLookup(benchmark::State& state) {
+    const auto count = static_cast<uint64_t>(state.range(0));
+    const uint64_t offset = state.range(1) ? 0 : IMSI_STRIDE / 2;
+    writeBinaryFile(count);
+
+    size_t residentBefore = residentBytes();
+    Blacklist blacklist = Blacklist::loadFromFile(BINARY_FILE);
+    size_t residentAfter = residentBytes();
+
+    uint64_t index = 0;
+    for (auto _ : state) {
+        auto imsi = *Imsi::fromValue(IMSI_BASE + (index % count) * IMSI_STRIDE + offset);
+        index += QUERY_STEP;
+        benchmark::DoNotOptimize(blacklist.isBlacklisted(imsi));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytes_per_entry"] = static_cast<double>(blacklist.memoryUsage()) / static_cast<double>(count);
+    state.counters["resident_mb"] = static_cast<double>(residentAfter - residentBefore) / (1024.0 * 1024.0);
+    std::remove(BINARY_FILE);
+}
+
+/**
+ * @brief Поиск в прежнем представлении (std::unordered_set<Imsi>) для сравнения
+ * @param state Состояние бенчмарка (range(0) - размер списка, range(1) - 1 для попаданий, 0 для промахов)
+ */
+void BM_BlacklistLookupUnorderedSet(benchmark::State& state) {
+    const auto count = static_cast<uint64_t>(state.range(0));
+    const uint64_t offset = state.range(1) ? 0 : IMSI_STRIDE / 2;
+
+    size_t heapBefore = heapBytes();
+    std::unordered_set<Imsi> blacklist;
+    blacklist.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        blacklist.insert(*Imsi::fromValue(IMSI_BASE + i * IMSI_STRIDE));
+    }
+    size_t heapAfter = heapBytes();
+
+    uint64_t index = 0;
+    for (auto _ : state) {
+        auto imsi = *Imsi::fromValue(IMSI_BASE + (index % count) * IMSI_STRIDE + offset);
+        index += QUERY_STEP;
+        benchmark::DoNotOptimize(blacklist.contains(imsi));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytes_per_entry"] = static_cast<double>(heapAfter - heapBefore) / static_cast<double>(count);
+}
+
+} // namespace
+
+BENCHMARK(BM_BlacklistLookup)
+    ->ArgsProduct({{1 << 10, 1 << 20, 1 << 22}, {0, 1}})
+    ->ArgNames({"entries", "hit"});
+
+BENCHMARK(BM_BlacklistLookupUnorderedSet)
+    ->ArgsProduct({{1 << 10, 1 << 20, 1 << 22}, {0, 1}})
+    ->ArgNames({"entries", "hit"});
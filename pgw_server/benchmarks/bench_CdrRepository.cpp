@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <FileCdrRepository.h>
+#include <AsyncFileCdrRepository.h>
+#include <Imsi.h>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t IMSI_BASE = 1010000000000ULL;  // Первый IMSI нагрузки
+constexpr size_t IMSI_POOL_SIZE = 4096;           // Строк IMSI, подготовленных заранее
+const char* const CDR_FILE = "bench_cdr.log";
+
+std::unique_ptr<ICdrRepository> g_repository;     // Общий для всех потоков бенчмарка репозиторий
+
+/**
+ * @brief Возвращает пул строк IMSI, чтобы форматирование IMSI не попадало в измерение
+ */
+const std::vector<std::string>& imsiPool() {
+    static const std::vector<std::string> pool = [] {
+        std::vector<std::string> imsis;
+        imsis.reserve(IMSI_POOL_SIZE);
+        for (uint64_t i = 0; i < IMSI_POOL_SIZE; ++i) {
+            imsis.push_back(Imsi::fromValue(IMSI_BASE + i)->toString());
+        }
+        return imsis;
+    }();
+    return pool;
+}
+
+/**
+ * @brief Запись CDR из нескольких потоков в файл
+ * @param state Состояние бенчмарка (range(0) - 0: FileCdrRepository, 1: AsyncFileCdrRepository)
+ */
+void BM_CdrRepositoryWrite(benchmark::State& state) {
+    const auto& imsis = imsiPool();
+    if (state.thread_index() == 0) {
+        std::remove(CDR_FILE);
+        if (state.range(0) == 0) {
+            g_repository = std::make_unique<FileCdrRepository>(CDR_FILE);
+        } else {
+            g_repository = std::make_unique<AsyncFileCdrRepository>(CDR_FILE, AsyncCdrOptions{});
+        }
+    }
+
+    size_t index = static_cast<size_t>(state.thread_index()) * 7919;
+    uint64_t failed = 0;
+    for (auto _ : state) {
+        if (!g_repository->writeCdr(imsis[index++ % imsis.size()], "create")) {
+            ++failed;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    // Счетчики потоков суммируются Google Benchmark после завершения всех потоков
+    state.counters["failed"] = benchmark::Counter(static_cast<double>(failed));
+
+    if (state.thread_index() == 0) {
+        g_repository.reset();
+        std::remove(CDR_FILE);
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_CdrRepositoryWrite)
+    ->ArgName("async")
+    ->Arg(0)->Arg(1)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
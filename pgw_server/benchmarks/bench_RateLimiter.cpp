@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <RateLimiter.h>
+#include <Imsi.h>
+#include <cstdint>
+#include <memory>
+
+namespace {
+
+constexpr uint64_t IMSI_BASE = 1010000000000ULL;  // Первый IMSI нагрузки
+constexpr uint64_t IMSI_POOL_SIZE = 100000;       // Количество абонентов в нагрузке
+
+std::unique_ptr<RateLimiter> g_limiter; // Общий для всех потоков бенчмарка ограничитель
+
+/**
+ * @brief Запросы постоянного набора абонентов из нескольких потоков
+ * @param state Состояние бенчмарка (range(0) - количество шардов)
+ */
+void BM_RateLimiterKnownImsis(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        RateLimiterOptions options;
+        options.shardCount = static_cast<size_t>(state.range(0));
+        // Максимальный лимит (емкость 10^7 токенов) не исчерпывается за прогон: измеряется путь разрешения
+        g_limiter = std::make_unique<RateLimiter>(RateLimiter::MAX_REQUESTS_PER_MINUTE, nullptr, options);
+    }
+    
+    uint64_t index = static_cast<uint64_t>(state.thread_index()) * 7919;
+    for (auto _ : state) {
+        auto imsi = *Imsi::fromValue(IMSI_BASE + index % IMSI_POOL_SIZE);
+        index += 104729;
+        benchmark::DoNotOptimize(g_limiter->allowRequest(imsi));
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+    
+    if (state.thread_index() == 0) {
+        g_limiter.reset();
+    }
+}
+
+/**
+ * @brief Поток запросов с неповторяющимися IMSI при ограниченной таблице bucket'ов
+ * 
+ * Каждый запрос создает новый bucket; стоимость и память должны оставаться
+ * ограниченными за счет вытеснения.
+ * @param state Состояние бенчмарка (range(0) - максимальное количество bucket'ов)
+ */
+void BM_RateLimiterRandomImsiFlood(benchmark::State& state) {
+    RateLimiterOptions options;
+    options.maxBuckets = static_cast<size_t>(state.range(0));
+    RateLimiter limiter(100, nullptr, options);
+    
+    uint64_t next = IMSI_BASE;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(limiter.allowRequest(*Imsi::fromValue(next++)));
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+    state.counters["buckets"] = static_cast<double>(limiter.getBucketCount());
+}
+
+} // namespace
+
+BENCHMARK(BM_RateLimiterKnownImsis)
+    ->ArgName("shards")
+    ->Arg(1)->Arg(16)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK(BM_RateLimiterRandomImsiFlood)
+    ->ArgName("max_buckets")
+    ->Arg(65536)->Arg(1000000);
@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+#include <SessionManager.h>
+#include <ShardedSessionRepository.h>
+#include <Blacklist.h>
+#include <RateLimiter.h>
+#include <Logger.h>
+#include <Imsi.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint64_t IMSI_BASE = 1010000000000ULL;        // Первый IMSI нагрузки
+constexpr uint64_t IMSI_POOL_SIZE = 100000;             // Абонентов в сценариях с повторяющимися IMSI
+constexpr uint64_t THREAD_IMSI_RANGE = 1ULL << 32;      // Непересекающиеся диапазоны новых IMSI потоков
+constexpr uint64_t NEW_SESSIONS_PER_ROUND = 1ULL << 20; // Новых сессий до очистки хранилища
+constexpr size_t SESSION_SHARDS = 64;                   // Шардов хранилища сессий
+constexpr size_t BLACKLIST_SIZE = 1000;                 // Размер черного списка
+
+/**
+ * @brief Сценарий создания сессии
+ */
+enum Scenario : int64_t {
+    NEW_SESSION = 0,    // Каждый запрос - новый IMSI
+    REFRESH = 1,        // Запросы существующих сессий
+    BLACKLISTED = 2,    // IMSI из черного списка
+    RATE_LIMITED = 3    // Лимит абонента исчерпан
+};
+
+/**
+ * @brief Репозиторий CDR без записи: стоимость CDR измеряется в bench_CdrRepository
+ */
+class NullCdrRepository : public ICdrRepository {
+public:
+    bool writeCdr(const std::string&, const std::string&) override { return true; }
+    bool writeCdr(const std::string&, const std::string&, const std::string&) override { return true; }
+};
+
+/**
+ * @brief Менеджер сессий с зависимостями, общий для всех потоков бенчмарка
+ */
+struct Fixture {
+    std::shared_ptr<ShardedSessionRepository> sessions;
+    std::shared_ptr<SessionManager> manager;
+};
+
+std::unique_ptr<Fixture> g_fixture;
+
+/**
+ * @brief Создает менеджер сессий для сценария
+ * @param scenario Сценарий
+ * @return Менеджер и его хранилище сессий
+ */
+std::unique_ptr<Fixture> makeFixture(Scenario scenario) {
+    // Логирование горячего пути отключено уровнем: измеряется логика, а не вывод
+    auto logger = std::make_shared<Logger>("", LogLevel::ERROR);
+
+    std::vector<std::string> blacklisted;
+    blacklisted.reserve(BLACKLIST_SIZE);
+    for (uint64_t i = 0; i < BLACKLIST_SIZE; ++i) {
+        blacklisted.push_back(Imsi::fromValue(IMSI_BASE + i)->toString());
+    }
+
+    // В сценарии ограничения скорости каждому абоненту доступен один запрос в минуту,
+    // в остальных максимальный лимит (емкость 10^7 токенов) не исчерпывается за прогон
+    uint32_t limit = scenario == RATE_LIMITED ? 1 : RateLimiter::MAX_REQUESTS_PER_MINUTE;
+    RateLimiterOptions limiterOptions;
+    limiterOptions.shardCount = SESSION_SHARDS;
+
+    auto fixture = std::make_unique<Fixture>();
+    fixture->sessions = std::make_shared<ShardedSessionRepository>(SESSION_SHARDS);
+    fixture->manager = std::make_shared<SessionManager>(
+        fixture->sessions,
+        std::make_shared<NullCdrRepository>(),
+        std::make_shared<Blacklist>(scenario == BLACKLISTED ? blacklisted : std::vector<std::string>{}),
+        std::make_shared<RateLimiter>(limit, logger, limiterOptions),
+        logger);
+
+    // Повторяющиеся IMSI заранее проходят через менеджер: сессии существуют, лимит израсходован
+    if (scenario == REFRESH || scenario == RATE_LIMITED) {
+        for (uint64_t i = 0; i < IMSI_POOL_SIZE; ++i) {
+            fixture->manager->createSession(*Imsi::fromValue(IMSI_BASE + i));
+        }
+    }
+    return fixture;
+}
+
+/**
+ * @brief Создание сессии в одном из сценариев из нескольких потоков
+ * @param state Состояние бенчмарка (range(0) - сценарий Scenario)
+ */
+void BM_SessionManagerCreateSession(benchmark::State& state) {
+    const auto scenario = static_cast<Scenario>(state.range(0));
+    if (state.thread_index() == 0) {
+        g_fixture = makeFixture(scenario);
+    }
+
+    const uint64_t pool = scenario == BLACKLISTED ? BLACKLIST_SIZE : IMSI_POOL_SIZE;
+    uint64_t index = static_cast<uint64_t>(state.thread_index()) * 7919;
+    uint64_t next = IMSI_BASE + IMSI_POOL_SIZE + static_cast<uint64_t>(state.thread_index()) * THREAD_IMSI_RANGE;
+    uint64_t roundStart = next;
+
+    for (auto _ : state) {
+        uint64_t value;
+        if (scenario == NEW_SESSION) {
+            // Каждый поток вне измерения удаляет созданные им сессии, чтобы хранилище
+            // не росло с числом итераций и измерялось создание в установившемся режиме
+            if (next - roundStart == NEW_SESSIONS_PER_ROUND) {
+                state.PauseTiming();
+                for (uint64_t i = roundStart; i < next; ++i) {
+                    g_fixture->sessions->removeSession(*Imsi::fromValue(i));
+                }
+                roundStart = next;
+                state.ResumeTiming();
+            }
+            value = next++;
+        } else {
+            value = IMSI_BASE + index % pool;
+            index += 104729;
+        }
+        benchmark::DoNotOptimize(g_fixture->manager->createSession(*Imsi::fromValue(value)));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        state.counters["sessions"] = static_cast<double>(g_fixture->sessions->getSessionCount());
+        g_fixture.reset();
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_SessionManagerCreateSession)
+    ->ArgName("scenario")
+    ->Arg(NEW_SESSION)->Arg(REFRESH)->Arg(BLACKLISTED)->Arg(RATE_LIMITED)
+    ->Threads(1)->Threads(4)
+    ->UseRealTime();
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <InMemorySessionRepository.h>
+#include <ShardedSessionRepository.h>
+#include <Session.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t IMSI_POOL_SIZE = 100000; // Количество абонентов в нагрузке
+
+/**
+ * @brief Генерирует пул сессий для нагрузки
+ * 
+ * Сессии создаются заранее, чтобы валидация IMSI не попадала в измерение.
+ * @return Вектор сессий
+ */
+const std::vector<Session>& sessionPool() {
+    static const std::vector<Session> pool = [] {
+        std::vector<Session> sessions;
+        sessions.reserve(IMSI_POOL_SIZE);
+        for (size_t i = 0; i < IMSI_POOL_SIZE; ++i) {
+            std::string suffix = std::to_string(i);
+            sessions.emplace_back("00101" + std::string(10 - suffix.size(), '0') + suffix);
+        }
+        return sessions;
+    }();
+    return pool;
+}
+
+std::unique_ptr<ISessionRepository> g_repository; // Общий для всех потоков бенчмарка репозиторий
+
+/**
+ * @brief Смешанная нагрузка UDP-пути: создание или обновление сессии,
+ *        а также редкие удаления (SessionCleaner) и проверки HTTP /check_subscriber
+ * @param state Состояние бенчмарка (range(0) - количество шардов, 0 - InMemorySessionRepository)
+ */
+void BM_SessionRepositoryMixed(benchmark::State& state) {
+    const auto& sessions = sessionPool();
+    
+    if (state.thread_index() == 0) {
+        auto shards = static_cast<size_t>(state.range(0));
+        if (shards == 0) {
+            g_repository = std::make_unique<InMemorySessionRepository>();
+        } else {
+            g_repository = std::make_unique<ShardedSessionRepository>(shards);
+        }
+        for (size_t i = 0; i < sessions.size(); i += 2) {
+            g_repository->addSession(sessions[i]);
+        }
+    }
+    
+    // Каждый поток идет по пулу со своим смещением и простым шагом
+    size_t index = static_cast<size_t>(state.thread_index()) * 7919;
+    size_t ops = 0;
+    
+    for (auto _ : state) {
+        const auto& session = sessions[index % sessions.size()];
+        const auto& imsi = session.getImsi();
+        index += 104729;
+        
+        if ((ops & 63) == 0) {
+            benchmark::DoNotOptimize(g_repository->removeSession(imsi));
+        } else if ((ops & 7) == 0) {
+            benchmark::DoNotOptimize(g_repository->sessionExists(imsi));
+        } else {
+            benchmark::DoNotOptimize(g_repository->createOrRefresh(imsi));
+        }
+        ++ops;
+    }
+    
+    state.SetItemsProcessed(state.iterations());
+    
+    if (state.thread_index() == 0) {
+        g_repository.reset();
+    }
+}
+
+/**
+ * @brief Цикл SessionCleaner, когда ни одна сессия не истекла
+ * 
+ * Стоимость должна оставаться постоянной при росте числа сессий:
+ * проход по списку истечения останавливается на первой неистекшей записи.
+ * @param state Состояние бенчмарка (range(0) - количество сессий)
+ */
+void BM_RemoveExpiredSessionsNoneExpired(benchmark::State& state) {
+    InMemorySessionRepository repository;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        repository.createOrRefresh(*Imsi::fromValue(static_cast<uint64_t>(i)));
+    }
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(repository.removeExpiredSessions(30, 1024));
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_SessionRepositoryMixed)
+    ->ArgName("shards")
+    ->Arg(0)->Arg(16)->Arg(64)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK(BM_RemoveExpiredSessionsNoneExpired)
+    ->ArgName("sessions")
+    ->Arg(10000)->Arg(100000)->Arg(1000000);
@@ -0,0 +1,76 @@
+#include <benchmark/benchmark.h>
+#include <TimestampFormatter.h>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Прежняя реализация FileCdrRepository::getCurrentTimestamp
+ * @param time Время
+ * @return Строка с временем
+ */
+std::string legacyTimestamp(std::chrono::system_clock::time_point time) {
+    auto timeT = std::chrono::system_clock::to_time_t(time);
+    
+    std::stringstream ss;
+    ss << std::put_time(std::localtime(&timeT), "%Y-%m-%d %H:%M:%S");
+    
+    return ss.str();
+}
+
+/**
+ * @brief Строка CDR с временной меткой через std::stringstream и std::localtime
+ * @param state Состояние бенчмарка
+ */
+void BM_TimestampStringStream(benchmark::State& state) {
+    std::string line;
+    for (auto _ : state) {
+        line.clear();
+        line += legacyTimestamp(std::chrono::system_clock::now());
+        line += ",001010123456789,create\n";
+        benchmark::DoNotOptimize(line.data());
+    }
+}
+BENCHMARK(BM_TimestampStringStream);
+
+/**
+ * @brief Строка CDR с временной меткой через кэширующий TimestampFormatter
+ * @param state Состояние бенчмарка (range(0) - точность TimestampPrecision)
+ */
+void BM_TimestampFormatterCached(benchmark::State& state) {
+    TimestampFormatter formatter(static_cast<TimestampPrecision>(state.range(0)));
+    std::string line;
+    line.reserve(64);
+    for (auto _ : state) {
+        line.clear();
+        formatter.append(std::chrono::system_clock::now(), line);
+        line += ",001010123456789,create\n";
+        benchmark::DoNotOptimize(line.data());
+    }
+}
+BENCHMARK(BM_TimestampFormatterCached)
+    ->Arg(static_cast<int>(TimestampPrecision::SECONDS))
+    ->Arg(static_cast<int>(TimestampPrecision::MILLISECONDS))
+    ->Arg(static_cast<int>(TimestampPrecision::MICROSECONDS));
+
+/**
+ * @brief Худший случай для кэша: каждая метка приходится на новую секунду
+ * @param state Состояние бенчмарка
+ */
+void BM_TimestampFormatterUncached(benchmark::State& state) {
+    TimestampFormatter formatter;
+    char buffer[TimestampFormatter::MAX_LENGTH];
+    auto time = std::chrono::system_clock::now();
+    for (auto _ : state) {
+        time += std::chrono::seconds(1);
+        benchmark::DoNotOptimize(formatter.format(time, buffer));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_TimestampFormatterUncached);
+
+} // namespace
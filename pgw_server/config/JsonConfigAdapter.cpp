@@ -41,6 +41,34 @@ bool JsonConfigAdapter::load() {
             _config.udp_port = jsonConfig["udp_port"].get<uint16_t>();
         }
         
+        if (jsonConfig.contains("udp_workers")) {
+            _config.udp_workers = jsonConfig["udp_workers"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("udp_batch_size")) {
+            _config.udp_batch_size = jsonConfig["udp_batch_size"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("udp_edge_triggered")) {
+            _config.udp_edge_triggered = jsonConfig["udp_edge_triggered"].get<bool>();
+        }
+        
+        if (jsonConfig.contains("udp_admission_global_pps")) {
+            _config.udp_admission_global_pps = jsonConfig["udp_admission_global_pps"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("udp_admission_source_pps")) {
+            _config.udp_admission_source_pps = jsonConfig["udp_admission_source_pps"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("udp_admission_source_slots")) {
+            _config.udp_admission_source_slots = jsonConfig["udp_admission_source_slots"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("udp_response_mode")) {
+            _config.udp_response_mode = jsonConfig["udp_response_mode"].get<std::string>();
+        }
+        
         if (jsonConfig.contains("session_timeout_sec")) {
             _config.session_timeout_sec = jsonConfig["session_timeout_sec"].get<uint32_t>();
         }
@@ -49,14 +77,42 @@ bool JsonConfigAdapter::load() {
             _config.cleanup_interval_sec = jsonConfig["cleanup_interval_sec"].get<uint32_t>();
         }
         
+        if (jsonConfig.contains("session_shards")) {
+            _config.session_shards = jsonConfig["session_shards"].get<uint32_t>();
+        }
+        
         if (jsonConfig.contains("cdr_file")) {
             _config.cdr_file = jsonConfig["cdr_file"].get<std::string>();
         }
         
+        if (jsonConfig.contains("cdr_async")) {
+            _config.cdr_async = jsonConfig["cdr_async"].get<bool>();
+        }
+        
+        if (jsonConfig.contains("cdr_queue_size")) {
+            _config.cdr_queue_size = jsonConfig["cdr_queue_size"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("cdr_flush_interval_ms")) {
+            _config.cdr_flush_interval_ms = jsonConfig["cdr_flush_interval_ms"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("cdr_flush_bytes")) {
+            _config.cdr_flush_bytes = jsonConfig["cdr_flush_bytes"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("cdr_enqueue_timeout_us")) {
+            _config.cdr_enqueue_timeout_us = jsonConfig["cdr_enqueue_timeout_us"].get<uint32_t>();
+        }
+        
         if (jsonConfig.contains("http_port")) {
             _config.http_port = jsonConfig["http_port"].get<uint16_t>();
         }
         
+        if (jsonConfig.contains("metrics_port")) {
+            _config.metrics_port = jsonConfig["metrics_port"].get<uint16_t>();
+        }
+        
         if (jsonConfig.contains("graceful_shutdown_rate")) {
             _config.graceful_shutdown_rate = jsonConfig["graceful_shutdown_rate"].get<uint32_t>();
         }
@@ -65,6 +121,14 @@ bool JsonConfigAdapter::load() {
             _config.max_requests_per_minute = jsonConfig["max_requests_per_minute"].get<uint32_t>();
         }
         
+        if (jsonConfig.contains("rate_limiter_shards")) {
+            _config.rate_limiter_shards = jsonConfig["rate_limiter_shards"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("rate_limiter_max_buckets")) {
+            _config.rate_limiter_max_buckets = jsonConfig["rate_limiter_max_buckets"].get<uint32_t>();
+        }
+        
         if (jsonConfig.contains("log_file")) {
             _config.log_file = jsonConfig["log_file"].get<std::string>();
         }
@@ -73,6 +137,26 @@ bool JsonConfigAdapter::load() {
             _config.log_level = jsonConfig["log_level"].get<std::string>();
         }
         
+        if (jsonConfig.contains("log_async")) {
+            _config.log_async = jsonConfig["log_async"].get<bool>();
+        }
+        
+        if (jsonConfig.contains("log_queue_size")) {
+            _config.log_queue_size = jsonConfig["log_queue_size"].get<uint32_t>();
+        }
+        
+        if (jsonConfig.contains("log_overflow_policy")) {
+            _config.log_overflow_policy = jsonConfig["log_overflow_policy"].get<std::string>();
+        }
+        
+        if (jsonConfig.contains("blacklist_file")) {
+            _config.blacklist_file = jsonConfig["blacklist_file"].get<std::string>();
+        }
+        
+        if (jsonConfig.contains("blacklist_watch_interval_ms")) {
+            _config.blacklist_watch_interval_ms = jsonConfig["blacklist_watch_interval_ms"].get<uint32_t>();
+        }
+        
         // Загружаем черный список
         if (jsonConfig.contains("blacklist") && jsonConfig["blacklist"].is_array()) {
             _config.blacklist.clear();
@@ -110,19 +194,44 @@ std::string JsonConfigAdapter::getLastError() const {
 
 std::string JsonConfigAdapter::getString(const std::string& key, const std::string& defaultValue) const {
     if (key == "udp_ip") return _config.udp_ip;
+    if (key == "udp_response_mode") return _config.udp_response_mode;
     if (key == "cdr_file") return _config.cdr_file;
     if (key == "log_file") return _config.log_file;
     if (key == "log_level") return _config.log_level;
+    if (key == "log_overflow_policy") return _config.log_overflow_policy;
+    if (key == "blacklist_file") return _config.blacklist_file;
     return defaultValue;
 }
 
 uint32_t JsonConfigAdapter::getUint(const std::string& key, uint32_t defaultValue) const {
     if (key == "udp_port") return _config.udp_port;
+    if (key == "udp_workers") return _config.udp_workers;
+    if (key == "udp_batch_size") return _config.udp_batch_size;
     if (key == "http_port") return _config.http_port;
+    if (key == "metrics_port") return _config.metrics_port;
+    if (key == "udp_admission_global_pps") return _config.udp_admission_global_pps;
+    if (key == "udp_admission_source_pps") return _config.udp_admission_source_pps;
+    if (key == "udp_admission_source_slots") return _config.udp_admission_source_slots;
     if (key == "session_timeout_sec") return _config.session_timeout_sec;
     if (key == "cleanup_interval_sec") return _config.cleanup_interval_sec;
+    if (key == "session_shards") return _config.session_shards;
     if (key == "graceful_shutdown_rate") return _config.graceful_shutdown_rate;
     if (key == "max_requests_per_minute") return _config.max_requests_per_minute;
+    if (key == "rate_limiter_shards") return _config.rate_limiter_shards;
+    if (key == "rate_limiter_max_buckets") return _config.rate_limiter_max_buckets;
+    if (key == "cdr_queue_size") return _config.cdr_queue_size;
+    if (key == "cdr_flush_interval_ms") return _config.cdr_flush_interval_ms;
+    if (key == "cdr_flush_bytes") return _config.cdr_flush_bytes;
+    if (key == "cdr_enqueue_timeout_us") return _config.cdr_enqueue_timeout_us;
+    if (key == "log_queue_size") return _config.log_queue_size;
+    if (key == "blacklist_watch_interval_ms") return _config.blacklist_watch_interval_ms;
+    return defaultValue;
+}
+
+bool JsonConfigAdapter::getBool(const std::string& key, bool defaultValue) const {
+    if (key == "udp_edge_triggered") return _config.udp_edge_triggered;
+    if (key == "cdr_async") return _config.cdr_async;
+    if (key == "log_async") return _config.log_async;
     return defaultValue;
 }
 
@@ -134,15 +243,36 @@ std::vector<std::string> JsonConfigAdapter::getStringArray(const std::string& ke
 void JsonConfigAdapter::setDefaults() {
     _config.udp_ip = "0.0.0.0";
     _config.udp_port = 9000;
+    _config.udp_workers = 1;
+    _config.udp_batch_size = 1;
+    _config.udp_edge_triggered = false;
+    _config.udp_admission_global_pps = 0;
+    _config.udp_admission_source_pps = 0;
+    _config.udp_admission_source_slots = 65536;
+    _config.udp_response_mode = "text";
     _config.session_timeout_sec = 30;
     _config.cleanup_interval_sec = 5;
+    _config.session_shards = 1;
     _config.cdr_file = "cdr.log";
+    _config.cdr_async = false;
+    _config.cdr_queue_size = 65536;
+    _config.cdr_flush_interval_ms = 100;
+    _config.cdr_flush_bytes = 65536;
+    _config.cdr_enqueue_timeout_us = 1000;
     _config.http_port = 8080;
+    _config.metrics_port = 9101;
     _config.graceful_shutdown_rate = 10;
     _config.max_requests_per_minute = 100;
+    _config.rate_limiter_shards = 16;
+    _config.rate_limiter_max_buckets = 1000000;
     _config.log_file = "pgw.log";
     _config.log_level = "INFO";
+    _config.log_async = false;
+    _config.log_queue_size = 8192;
+    _config.log_overflow_policy = "block";
     _config.blacklist.clear();
+    _config.blacklist_file.clear();
+    _config.blacklist_watch_interval_ms = 1000;
 }
 
 bool JsonConfigAdapter::validateConfig() {
@@ -152,12 +282,88 @@ bool JsonConfigAdapter::validateConfig() {
         return false;
     }
     
+    // Проверяем количество рабочих потоков UDP
+    if (_config.udp_workers == 0) {
+        setError("Invalid UDP workers count: 0");
+        return false;
+    }
+    
+    // Проверяем размер пакета UDP (ограничение ядра на vlen - 1024)
+    if (_config.udp_batch_size == 0 || _config.udp_batch_size > 1024) {
+        setError("Invalid UDP batch size: " + std::to_string(_config.udp_batch_size));
+        return false;
+    }
+    
+    // Проверяем параметры контроля допуска
+    if (_config.udp_admission_source_slots == 0) {
+        setError("Invalid UDP admission source slots: 0");
+        return false;
+    }
+    
+    // Проверяем формат ответов UDP
+    if (_config.udp_response_mode != "text" && _config.udp_response_mode != "binary") {
+        setError("Invalid UDP response mode: " + _config.udp_response_mode);
+        return false;
+    }
+    
+    // Проверяем количество шардов хранилища сессий
+    if (_config.session_shards == 0) {
+        setError("Invalid session shards count: 0");
+        return false;
+    }
+    
+    // Проверяем параметры асинхронной записи CDR
+    if (_config.cdr_queue_size == 0) {
+        setError("Invalid CDR queue size: 0");
+        return false;
+    }
+    
+    if (_config.cdr_flush_interval_ms == 0) {
+        setError("Invalid CDR flush interval: 0");
+        return false;
+    }
+    
+    if (_config.cdr_flush_bytes == 0) {
+        setError("Invalid CDR flush bytes: 0");
+        return false;
+    }
+    
+    // Проверяем параметры ограничителя скорости
+    if (_config.rate_limiter_shards == 0) {
+        setError("Invalid rate limiter shards count: 0");
+        return false;
+    }
+    
+    if (_config.rate_limiter_max_buckets < _config.rate_limiter_shards) {
+        setError("Invalid rate limiter max buckets: " + std::to_string(_config.rate_limiter_max_buckets) +
+                 " (must be at least rate_limiter_shards)");
+        return false;
+    }
+    
+    // Проверяем параметры асинхронного логирования
+    if (_config.log_queue_size == 0) {
+        setError("Invalid log queue size: 0");
+        return false;
+    }
+    
+    if (_config.log_overflow_policy != "block" && _config.log_overflow_policy != "drop_oldest" &&
+        _config.log_overflow_policy != "drop_new") {
+        setError("Invalid log overflow policy: " + _config.log_overflow_policy);
+        return false;
+    }
+    
     // Проверяем HTTP порт
     if (_config.http_port == 0) {
         setError("Invalid HTTP port: 0");
         return false;
     }
     
+    // Проверяем порт метрик
+    if (_config.metrics_port == 0) {
+        setError("Invalid metrics port: 0");
+        return false;
+    }
+    
     // Проверяем таймаут сессии
     if (_config.session_timeout_sec == 0) {
         setError("Invalid session timeout: 0");
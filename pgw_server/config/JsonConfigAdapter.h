@@ -12,15 +12,36 @@
 struct ServerConfig {
     std::string udp_ip = "0.0.0.0";               // IP-адрес для UDP-сервера
     uint16_t udp_port = 9000;                     // Порт для UDP-сервера
+    uint32_t udp_workers = 1;                     // Количество рабочих потоков UDP-сервера (SO_REUSEPORT)
+    uint32_t udp_batch_size = 1;                  // Датаграмм на один recvmmsg/sendmmsg (1 - без пакетной обработки)
+    bool udp_edge_triggered = false;              // Режим EPOLLET с вычитыванием сокета до EAGAIN
+    uint32_t udp_admission_global_pps = 0;        // Общий бюджет пакетов в секунду до декодирования (0 - без ограничения)
+    uint32_t udp_admission_source_pps = 0;        // Бюджет пакетов в секунду на IP-адрес источника (0 - без ограничения)
+    uint32_t udp_admission_source_slots = 65536;  // Размер таблицы бюджетов источников
+    std::string udp_response_mode = "text";       // Формат ответов: "text" или "binary"
     uint32_t session_timeout_sec = 30;            // Таймаут сессий в секундах
     uint32_t cleanup_interval_sec = 5;            // Интервал очистки сессий в секундах
+    uint32_t session_shards = 1;                  // Количество шардов хранилища сессий (1 - без шардирования)
     std::string cdr_file = "cdr.log";             // Путь к файлу CDR
+    bool cdr_async = false;                       // Асинхронная пакетная запись CDR в отдельном потоке
+    uint32_t cdr_queue_size = 65536;              // Емкость очереди CDR (асинхронный режим)
+    uint32_t cdr_flush_interval_ms = 100;         // Максимальная задержка записи CDR в файл, мс
+    uint32_t cdr_flush_bytes = 65536;             // Размер буфера CDR, при котором запись выполняется немедленно
+    uint32_t cdr_enqueue_timeout_us = 1000;       // Ожидание места в очереди CDR перед сбросом записи, мкс
     uint16_t http_port = 8080;                    // Порт для HTTP-сервера
+    uint16_t metrics_port = 9101;                 // Порт Prometheus-метрик
     uint32_t graceful_shutdown_rate = 10;         // Скорость удаления сессий при завершении (сессий в секунду)
     uint32_t max_requests_per_minute = 100;       // Максимальное количество запросов в минуту
+    uint32_t rate_limiter_shards = 16;            // Количество шардов ограничителя скорости
+    uint32_t rate_limiter_max_buckets = 1000000;  // Максимальное количество IMSI, отслеживаемых ограничителем
     std::string log_file = "pgw.log";             // Путь к файлу логов
     std::string log_level = "INFO";               // Уровень логирования
+    bool log_async = false;                       // Асинхронная запись логов в отдельном потоке
+    uint32_t log_queue_size = 8192;               // Емкость очереди сообщений лога (асинхронный режим)
+    std::string log_overflow_policy = "block";    // Политика переполнения очереди: block, drop_oldest, drop_new
     std::vector<std::string> blacklist;           // Черный список IMSI
+    std::string blacklist_file;                   // Файл черного списка (текстовый или бинарный); заменяет blacklist
+    uint32_t blacklist_watch_interval_ms = 1000;  // Период проверки изменения файла черного списка (0 - без наблюдения)
 };
 
 /**
@@ -81,6 +102,14 @@ public:
      */
     [[nodiscard]] uint32_t getUint(const std::string& key, uint32_t defaultValue = 0) const;
     
+    /**
+     * @brief Возвращает логическое значение из конфигурации
+     * @param key Ключ параметра
+     * @param defaultValue Значение по умолчанию
+     * @return Значение параметра или значение по умолчанию
+     */
+    [[nodiscard]] bool getBool(const std::string& key, bool defaultValue = false) const;
+    
     /**
      * @brief Возвращает массив строк из конфигурации
      * @param key Ключ параметра
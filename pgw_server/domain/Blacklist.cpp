@@ -1,21 +1,414 @@
 #include <Blacklist.h>
-#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
+namespace {
 
-Blacklist::Blacklist(const std::vector<std::string>& blacklistedImsis) {
+constexpr size_t FILTER_BLOCK_WORDS = 8;                        // Слов в блоке фильтра (одна кэш-линия)
+constexpr size_t FILTER_BLOCK_BITS = FILTER_BLOCK_WORDS * 64;   // Бит в блоке фильтра
+constexpr size_t FILTER_HASHES = 6;                             // Бит, устанавливаемых на одну запись
+constexpr size_t INDEX_STRIDE = 64;                             // Записей массива на один элемент разреженного индекса
+
+/**
+ * @brief Возвращает номер блока фильтра для хеша
+ * @param hash Хеш IMSI
+ * @param blocks Количество блоков
+ * @return Номер блока
+ */
+size_t filterBlock(uint64_t hash, size_t blocks) {
+    // Умножение вместо деления по модулю: старшие 32 бита хеша равномерно отображаются на [0, blocks)
+    return static_cast<size_t>(((hash >> 32) * blocks) >> 32);
+}
+
+/**
+ * @brief Возвращает биты хеша для выбора позиций внутри блока
+ * @param hash Хеш IMSI
+ * @return Перемешанное значение, по 9 бит на позицию
+ */
+uint64_t filterBits(uint64_t hash) {
+    return hash * 0x9E3779B97F4A7C15ULL;
+}
+
+/**
+ * @brief Возвращает последний элемент отсортированного массива, не превышающий значение
+ *
+ * Двоичный поиск без ветвлений: количество итераций зависит только от длины массива.
+ * @param base Начало массива
+ * @param length Длина массива (больше 0)
+ * @param value Искомое значение
+ * @return Указатель на найденный элемент (или на первый, если все элементы больше значения)
+ */
+const uint64_t* floorSearch(const uint64_t* base, size_t length, uint64_t value) {
+    while (length > 1) {
+        size_t half = length / 2;
+        base = base[half] <= value ? base + half : base;
+        length -= half;
+    }
+    return base;
+}
+
+/**
+ * @brief Возвращает полосу счетчиков читателей для текущего потока
+ * @param stripes Количество полос
+ * @return Номер полосы (постоянный для потока)
+ */
+size_t readerStripe(size_t stripes) {
+    static std::atomic<size_t> nextStripe{0};
+    thread_local const size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed);
+    return stripe % stripes;
+}
+
+/**
+ * @brief Удаляет пробельные символы по краям строки
+ * @param line Строка
+ * @return Строка без пробелов по краям
+ */
+std::string_view trim(std::string_view line) {
+    const char* whitespace = " \t\r\n";
+    size_t begin = line.find_first_not_of(whitespace);
+    if (begin == std::string_view::npos) {
+        return {};
+    }
+    size_t end = line.find_last_not_of(whitespace);
+    return line.substr(begin, end - begin + 1);
+}
+
+} // namespace
+
+struct Blacklist::Data {
+    std::vector<uint64_t> ownedEntries;     // Записи в собственной памяти снимка
+    const uint64_t* entries = nullptr;      // Отсортированные упакованные IMSI
+    size_t count = 0;                       // Количество записей
+    std::vector<uint64_t> filter;           // Блоки фильтра Блума
+    size_t filterBlocks = 0;                // Количество блоков фильтра
+    std::vector<uint64_t> index;            // Каждая INDEX_STRIDE-я запись (разреженный индекс)
+
+    Data() = default;
+    Data(const Data&) = delete;
+    Data& operator=(const Data&) = delete;
+
+    /**
+     * @brief Строит фильтр Блума и разреженный индекс по записям
+     */
+    void buildLookup() {
+        index.reserve((count + INDEX_STRIDE - 1) / INDEX_STRIDE);
+        for (size_t i = 0; i < count; i += INDEX_STRIDE) {
+            index.push_back(entries[i]);
+        }
+
+        filterBlocks = std::max<size_t>((count * FILTER_BITS_PER_ENTRY + FILTER_BLOCK_BITS - 1) / FILTER_BLOCK_BITS, 1);
+        filter.assign(filterBlocks * FILTER_BLOCK_WORDS, 0);
+        for (size_t i = 0; i < count; ++i) {
+            uint64_t hash = Imsi::fromValue(entries[i])->hash();
+            uint64_t* block = filter.data() + filterBlock(hash, filterBlocks) * FILTER_BLOCK_WORDS;
+            uint64_t bits = filterBits(hash);
+            for (size_t k = 0; k < FILTER_HASHES; ++k, bits >>= 9) {
+                size_t bit = bits & (FILTER_BLOCK_BITS - 1);
+                block[bit / 64] |= 1ULL << (bit % 64);
+            }
+        }
+    }
+
+    /**
+     * @brief Проверяет наличие упакованного IMSI
+     * @param imsi IMSI
+     * @return true если IMSI есть в списке
+     */
+    bool contains(const Imsi& imsi) const {
+        uint64_t hash = imsi.hash();
+        const uint64_t* block = filter.data() + filterBlock(hash, filterBlocks) * FILTER_BLOCK_WORDS;
+        uint64_t bits = filterBits(hash);
+        for (size_t k = 0; k < FILTER_HASHES; ++k, bits >>= 9) {
+            size_t bit = bits & (FILTER_BLOCK_BITS - 1);
+            if (!(block[bit / 64] & (1ULL << (bit % 64)))) {
+                return false;
+            }
+        }
+
+        // Фильтр допускает ложные срабатывания: подтверждаем поиском сначала по компактному
+        // индексу, затем внутри одного участка массива из INDEX_STRIDE записей
+        uint64_t value = imsi.value();
+        size_t segment = static_cast<size_t>(floorSearch(index.data(), index.size(), value) - index.data());
+        size_t begin = segment * INDEX_STRIDE;
+        return *floorSearch(entries + begin, std::min(INDEX_STRIDE, count - begin), value) == value;
+    }
+};
+
+struct Blacklist::Snapshot {
+    std::shared_ptr<const Data> data;       // Содержимое (nullptr для пустого списка)
+};
+
+template<typename Function>
+decltype(auto) Blacklist::read(Function&& function) const {
+    auto& stripe = _readers[readerStripe(READER_STRIPES)];
+
+    // Регистрируемся в текущей эпохе; если публикация сменила эпоху между чтением
+    // номера и инкрементом, писатель мог нас не увидеть - повторяем вход
+    std::atomic<uint64_t>* active;
+    while (true) {
+        uint64_t epoch = _epoch.load();
+        active = &stripe.active[epoch & 1];
+        active->fetch_add(1);
+        if (_epoch.load() == epoch) {
+            break;
+        }
+        active->fetch_sub(1);
+    }
+
+    // Снимок, прочитанный после регистрации, не освобождается до выхода из секции
+    struct Exit {
+        std::atomic<uint64_t>* active;
+        ~Exit() { active->fetch_sub(1, std::memory_order_release); }
+    } exit{active};
+
+    return function(_current.load()->data);
+}
+
+Blacklist::Blacklist()
+    : Blacklist(std::shared_ptr<const Data>()) {
+}
+
+Blacklist::Blacklist(std::shared_ptr<const Data> data)
+    : _current(new Snapshot{std::move(data)}) {
+}
+
+Blacklist::Blacklist(const std::vector<std::string>& blacklistedImsis)
+    : Blacklist() {
     setBlacklist(blacklistedImsis);
 }
 
+Blacklist::Blacklist(const Blacklist& other)
+    : Blacklist(other.acquire()) {
+}
+
+Blacklist& Blacklist::operator=(const Blacklist& other) {
+    if (this != &other) {
+        publish(other.acquire());
+    }
+    return *this;
+}
+
+Blacklist::~Blacklist() {
+    delete _current.load();
+}
+
+Blacklist Blacklist::loadFromFile(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open blacklist file: " + path + ": " + std::strerror(errno));
+    }
+
+    struct stat fileStat{};
+    char magic[sizeof(BINARY_MAGIC)] = {};
+    bool binary = fstat(fd, &fileStat) == 0 &&
+                  static_cast<size_t>(fileStat.st_size) >= BINARY_HEADER_SIZE &&
+                  pread(fd, magic, sizeof(magic), 0) == static_cast<ssize_t>(sizeof(magic)) &&
+                  std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+
+    if (binary) {
+        // Записи копируются в память снимка, а не отображаются: снимок может жить
+        // дольше файла, и перезапись файла на месте не должна влиять на читателей
+        size_t fileSize = static_cast<size_t>(fileStat.st_size);
+        uint64_t count = 0;
+        bool complete = pread(fd, &count, sizeof(count), sizeof(BINARY_MAGIC)) == static_cast<ssize_t>(sizeof(count));
+        if (!complete || count != (fileSize - BINARY_HEADER_SIZE) / sizeof(uint64_t) ||
+            BINARY_HEADER_SIZE + count * sizeof(uint64_t) != fileSize) {
+            close(fd);
+            throw std::runtime_error("Corrupted blacklist file: " + path + ": size does not match entry count");
+        }
+
+        auto data = std::make_shared<Data>();
+        data->ownedEntries.resize(static_cast<size_t>(count));
+        auto* target = reinterpret_cast<char*>(data->ownedEntries.data());
+        size_t bytes = static_cast<size_t>(count) * sizeof(uint64_t);
+        size_t done = 0;
+        while (done < bytes) {
+            ssize_t result = pread(fd, target + done, bytes - done, static_cast<off_t>(BINARY_HEADER_SIZE + done));
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result <= 0) {
+                int readError = result < 0 ? errno : 0;
+                close(fd);
+                // Файл укоротили во время чтения
+                throw std::runtime_error("Failed to read blacklist file: " + path +
+                                         (readError ? std::string(": ") + std::strerror(readError) : ": unexpected end of file"));
+            }
+            done += static_cast<size_t>(result);
+        }
+        close(fd);
+
+        data->entries = data->ownedEntries.data();
+        data->count = data->ownedEntries.size();
+
+        // Двоичный поиск корректен только на строго возрастающем массиве допустимых значений
+        for (size_t i = 0; i < data->count; ++i) {
+            if (data->entries[i] > Imsi::MAX_VALUE || (i > 0 && data->entries[i] <= data->entries[i - 1])) {
+                throw std::runtime_error("Corrupted blacklist file: " + path +
+                                         ": entries are not sorted valid IMSIs at index " + std::to_string(i));
+            }
+        }
+
+        if (data->count == 0) {
+            return {};
+        }
+        data->buildLookup();
+        return Blacklist(std::move(data));
+    }
+
+    close(fd);
+
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open blacklist file: " + path);
+    }
+
+    std::vector<uint64_t> values;
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        std::string_view item = trim(line);
+        if (item.empty() || item.front() == '#') {
+            continue;
+        }
+
+        auto imsi = Imsi::parse(item);
+        if (!imsi) {
+            throw std::runtime_error("Invalid IMSI in blacklist file " + path + " at line " +
+                                     std::to_string(lineNumber) + ": " + std::string(item));
+        }
+        values.push_back(imsi->value());
+    }
+
+    return Blacklist(build(std::move(values)));
+}
+
+void Blacklist::saveBinaryFile(const std::string& path) const {
+    // Запись во временный файл и rename: наблюдающий BlacklistReloader видит
+    // либо прежний, либо полностью записанный файл
+    const std::string temporaryPath = path + ".tmp";
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open blacklist file for writing: " + temporaryPath);
+    }
+
+    auto data = acquire();
+    uint64_t count = data ? data->count : 0;
+    file.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    if (data) {
+        file.write(reinterpret_cast<const char*>(data->entries),
+                   static_cast<std::streamsize>(data->count * sizeof(uint64_t)));
+    }
+
+    file.close();
+    if (!file) {
+        std::remove(temporaryPath.c_str());
+        throw std::runtime_error("Failed to write blacklist file: " + temporaryPath);
+    }
+
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        int renameError = errno;
+        std::remove(temporaryPath.c_str());
+        throw std::runtime_error("Failed to replace blacklist file: " + path + ": " + std::strerror(renameError));
+    }
+}
+
+bool Blacklist::isBlacklisted(const Imsi& imsi) const {
+    return read([&imsi](const std::shared_ptr<const Data>& data) {
+        return data && data->contains(imsi);
+    });
+}
+
 bool Blacklist::isBlacklisted(const std::string& imsi) const {
-    return _blacklistedImsis.contains(imsi);
+    auto parsed = Imsi::parse(imsi);
+    return parsed && isBlacklisted(*parsed);
+}
+
+bool Blacklist::isBlacklisted(const char* imsi) const {
+    return imsi && isBlacklisted(std::string(imsi));
 }
 
 void Blacklist::setBlacklist(const std::vector<std::string>& blacklistedImsis) {
-    _blacklistedImsis.clear();
-    
-    // Резервируем память для уменьшения перераспределения
-    _blacklistedImsis.reserve(blacklistedImsis.size());
-    
-    // Вставляем все IMSI за одну операцию
-    _blacklistedImsis.insert(blacklistedImsis.begin(), blacklistedImsis.end());
-}
\ No newline at end of file
+    std::vector<uint64_t> values;
+    values.reserve(blacklistedImsis.size());
+
+    // Упаковываем IMSI, записи неверного формата не могут совпасть ни с одним запросом
+    for (const auto& item : blacklistedImsis) {
+        if (auto imsi = Imsi::parse(item)) {
+            values.push_back(imsi->value());
+        }
+    }
+
+    publish(build(std::move(values)));
+}
+
+void Blacklist::replace(const Blacklist& source) {
+    if (this != &source) {
+        publish(source.acquire());
+    }
+}
+
+size_t Blacklist::size() const {
+    return read([](const std::shared_ptr<const Data>& data) -> size_t {
+        return data ? data->count : 0;
+    });
+}
+
+size_t Blacklist::memoryUsage() const {
+    return read([](const std::shared_ptr<const Data>& data) -> size_t {
+        if (!data) {
+            return 0;
+        }
+        return (data->count + data->filter.size() + data->index.size()) * sizeof(uint64_t);
+    });
+}
+
+std::shared_ptr<const Blacklist::Data> Blacklist::acquire() const {
+    return read([](const std::shared_ptr<const Data>& data) {
+        return data;
+    });
+}
+
+void Blacklist::publish(std::shared_ptr<const Data> data) {
+    auto* next = new Snapshot{std::move(data)};
+
+    std::lock_guard<std::mutex> lock(_publishMutex);
+    const Snapshot* previous = _current.exchange(next);
+
+    // Читатели, вошедшие после смены эпохи, видят уже новый снимок; ждем только
+    // тех, кто зарегистрировался в предыдущей эпохе
+    uint64_t previousEpoch = _epoch.fetch_add(1);
+    for (const auto& stripe : _readers) {
+        while (stripe.active[previousEpoch & 1].load() != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    delete previous;
+}
+
+std::shared_ptr<const Blacklist::Data> Blacklist::build(std::vector<uint64_t> values) {
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    if (values.empty()) {
+        return nullptr;
+    }
+
+    values.shrink_to_fit();
+    auto data = std::make_shared<Data>();
+    data->ownedEntries = std::move(values);
+    data->entries = data->ownedEntries.data();
+    data->count = data->ownedEntries.size();
+    data->buildLookup();
+    return data;
+}
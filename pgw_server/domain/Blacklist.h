@@ -1,46 +1,183 @@
 #pragma once
 
+#include <Imsi.h>
 #include <string>
 #include <vector>
-#include <unordered_set>
+#include <memory>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
 
 /**
  * @brief Класс Blacklist представляет черный список IMSI абонентов
+ *
+ * IMSI хранятся как отсортированный массив упакованных 64-битных значений
+ * (8 байт на запись) и ищутся двоичным поиском. Перед поиском запрос
+ * проверяется блочным фильтром Блума (~10 бит на запись, одна кэш-линия
+ * на запрос), поэтому абоненты вне списка - основной поток запросов -
+ * отсекаются без обхода массива. Ложные срабатывания фильтра
+ * подтверждаются точным поиском: сначала по разреженному индексу
+ * (каждая 64-я запись), затем внутри участка из 64 записей.
+ *
+ * Массив может загружаться из текстового файла (по IMSI в строке) или
+ * читаться из бинарного файла без разбора и сортировки. Данные
+ * неизменяемы, принадлежат снимку и разделяются между копиями объекта.
+ *
+ * Замена содержимого (setBlacklist, replace) безопасна при конкурентных
+ * проверках и построена по схеме RCU: новый снимок строится вызывающим
+ * потоком, публикуется атомарной заменой указателя, а старый освобождается
+ * после выхода всех читателей, вошедших до замены. Читатели не берут
+ * блокировок: вход в секцию - инкремент счетчика текущей эпохи в одной из
+ * READER_STRIPES кэш-линий, выбираемой по потоку.
  */
 class Blacklist {
 public:
+    static constexpr char BINARY_MAGIC[8] = {'P', 'G', 'W', 'B', 'L', 'S', 'T', '1'}; // Сигнатура бинарного файла
+    static constexpr size_t BINARY_HEADER_SIZE = 16;    // Сигнатура и количество записей (uint64)
+    static constexpr size_t FILTER_BITS_PER_ENTRY = 10; // Бит фильтра Блума на запись (~1% ложных срабатываний)
+
     /**
      * @brief Создает пустой черный список
      */
-    Blacklist() = default;
-    
+    Blacklist();
+
     /**
      * @brief Создает черный список с указанными IMSI
-     * @param blacklistedImsis Список IMSI для добавления в черный список
+     * @param blacklistedImsis Список IMSI для добавления в черный список (строки неверного формата пропускаются)
      */
     explicit Blacklist(const std::vector<std::string>& blacklistedImsis);
-    
-    // Поддержка семантики копирования и перемещения
-    Blacklist(const Blacklist&) = default;
-    Blacklist& operator=(const Blacklist&) = default;
-    Blacklist(Blacklist&&) noexcept = default;
-    Blacklist& operator=(Blacklist&&) noexcept = default;
-    
-    ~Blacklist() = default;
+
+    // Копия разделяет текущий снимок источника; перемещение выполняется так же
+    Blacklist(const Blacklist& other);
+    Blacklist& operator=(const Blacklist& other);
+
+    ~Blacklist();
+
+    /**
+     * @brief Загружает черный список из файла
+     *
+     * Файл с сигнатурой BINARY_MAGIC читается одним блоком в память снимка
+     * (записи только проверяются на упорядоченность), поэтому последующая
+     * перезапись или усечение файла не влияет на загруженный список.
+     * Иначе файл читается как текст: по одному IMSI в строке,
+     * пустые строки и строки, начинающиеся с '#', пропускаются.
+     * @param path Путь к файлу
+     * @return Черный список
+     * @throws std::runtime_error если файл не удалось прочитать, бинарный файл поврежден
+     *         или текстовый файл содержит строку неверного формата
+     */
+    [[nodiscard]] static Blacklist loadFromFile(const std::string& path);
+
+    /**
+     * @brief Сохраняет черный список в бинарном формате
+     *
+     * Формат: BINARY_MAGIC, количество записей (uint64), затем отсортированные
+     * упакованные IMSI (uint64), все числа в порядке байт платформы.
+     * Файл записывается рядом под именем path + ".tmp" и атомарно заменяет path.
+     * @param path Путь к файлу
+     * @throws std::runtime_error если файл не удалось записать
+     */
+    void saveBinaryFile(const std::string& path) const;
 
     /**
      * @brief Проверяет, находится ли IMSI в черном списке
      * @param imsi IMSI для проверки
      * @return true если IMSI в черном списке, иначе false
      */
+    [[nodiscard]] bool isBlacklisted(const Imsi& imsi) const;
+
+    /**
+     * @brief Проверяет, находится ли IMSI из строки в черном списке
+     * @param imsi Строка с IMSI (строка неверного формата не может быть в черном списке)
+     * @return true если IMSI в черном списке, иначе false
+     */
     [[nodiscard]] bool isBlacklisted(const std::string& imsi) const;
-    
+    [[nodiscard]] bool isBlacklisted(const char* imsi) const;
+
     /**
      * @brief Заменяет текущий черный список новым списком IMSI
-     * @param blacklistedImsis Новый список IMSI
+     * @param blacklistedImsis Новый список IMSI (строки неверного формата пропускаются)
      */
     void setBlacklist(const std::vector<std::string>& blacklistedImsis);
 
+    /**
+     * @brief Атомарно заменяет содержимое содержимым другого черного списка
+     *
+     * Блокирует только вызывающий поток до выхода читателей старого снимка;
+     * проверки в других потоках продолжаются без ожидания.
+     * @param source Черный список, снимок которого публикуется
+     */
+    void replace(const Blacklist& source);
+
+    /**
+     * @brief Возвращает количество IMSI в черном списке
+     * @return Количество уникальных IMSI
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Возвращает объем памяти, занимаемый записями, фильтром и индексом
+     * @return Размер в байтах
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
 private:
-    std::unordered_set<std::string> _blacklistedImsis; // Множество IMSI в черном списке
-};
\ No newline at end of file
+    static constexpr size_t READER_STRIPES = 16; // Полос счетчиков читателей (снижают конкуренцию за кэш-линию)
+
+    /**
+     * @brief Неизменяемое содержимое черного списка
+     */
+    struct Data;
+
+    /**
+     * @brief Опубликованный снимок (владеет ссылкой на содержимое)
+     */
+    struct Snapshot;
+
+    /**
+     * @brief Счетчики активных читателей двух соседних эпох в отдельной кэш-линии
+     */
+    struct alignas(64) ReaderStripe {
+        std::atomic<uint64_t> active[2]{};  // Читатели четной и нечетной эпохи
+    };
+
+    /**
+     * @brief Создает черный список с готовым содержимым
+     * @param data Содержимое (nullptr для пустого списка)
+     */
+    explicit Blacklist(std::shared_ptr<const Data> data);
+
+    /**
+     * @brief Выполняет функцию над текущим содержимым внутри секции читателя
+     * @param function Функция, принимающая const std::shared_ptr<const Data>& (nullptr для пустого списка)
+     * @return Результат функции
+     */
+    template<typename Function>
+    decltype(auto) read(Function&& function) const;
+
+    /**
+     * @brief Возвращает ссылку на текущее содержимое
+     * @return Содержимое (nullptr для пустого списка)
+     */
+    [[nodiscard]] std::shared_ptr<const Data> acquire() const;
+
+    /**
+     * @brief Публикует новое содержимое и освобождает старый снимок после выхода его читателей
+     * @param data Новое содержимое
+     */
+    void publish(std::shared_ptr<const Data> data);
+
+    /**
+     * @brief Строит содержимое из массива упакованных IMSI
+     * @param values Упакованные IMSI (сортируются и очищаются от дубликатов)
+     * @return Содержимое черного списка
+     */
+    static std::shared_ptr<const Data> build(std::vector<uint64_t> values);
+
+    std::atomic<const Snapshot*> _current;                  // Текущий снимок (никогда не nullptr)
+    std::atomic<uint64_t> _epoch{0};                        // Номер эпохи, увеличивается при каждой публикации
+    mutable std::array<ReaderStripe, READER_STRIPES> _readers; // Счетчики читателей
+    std::mutex _publishMutex;                               // Сериализует публикации
+};
@@ -29,4 +29,11 @@ public:
      */
     virtual bool writeCdr(const std::string& imsi, const std::string& action,
                          const std::string& timestamp) = 0;
+
+    /**
+     * @brief Дожидается сохранения всех принятых записей
+     * 
+     * Для синхронных реализаций ничего не делает.
+     */
+    virtual void flush() {}
 };
\ No newline at end of file
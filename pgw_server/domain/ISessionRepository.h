@@ -7,6 +7,14 @@
 
 #include "Session.h"
 
+/**
+ * @brief Результат операции создания или обновления сессии
+ */
+enum class UpsertResult {
+    CREATED,    // Создана новая сессия
+    REFRESHED   // Существующая сессия обновлена
+};
+
 /**
  * @brief Интерфейс репозитория сессий
  *
@@ -28,20 +36,20 @@ public:
      * @param imsi IMSI абонента
      * @return true если сессия успешно удалена, иначе false
      */
-    virtual bool removeSession(const std::string& imsi) = 0;
+    virtual bool removeSession(const Imsi& imsi) = 0;
     
     /**
      * @brief Проверяет существование сессии
      * @param imsi IMSI абонента
      * @return true если сессия существует, иначе false
      */
-    [[nodiscard]] virtual bool sessionExists(const std::string& imsi) const = 0;
+    [[nodiscard]] virtual bool sessionExists(const Imsi& imsi) const = 0;
     
     /**
      * @brief Возвращает все IMSI
      * @return Вектор всех IMSI
      */
-    [[nodiscard]] virtual std::vector<std::string> getAllImsis() const = 0;
+    [[nodiscard]] virtual std::vector<Imsi> getAllImsis() const = 0;
     
     /**
      * @brief Возвращает количество сессий
@@ -61,5 +69,23 @@ public:
      */
     [[nodiscard]] virtual std::vector<Session> getExpiredSessions(uint32_t timeoutSeconds) const = 0;
 
-    virtual bool refreshSession(const std::string& imsi) = 0;
+    /**
+     * @brief Удаляет истекшие сессии, начиная с самых старых
+     * @param timeoutSeconds Таймаут в секундах
+     * @param maxCount Максимальное количество сессий, удаляемых за один вызов
+     * @return IMSI удаленных сессий
+     */
+    virtual std::vector<Imsi> removeExpiredSessions(uint32_t timeoutSeconds, size_t maxCount) = 0;
+
+    virtual bool refreshSession(const Imsi& imsi) = 0;
+    
+    /**
+     * @brief Атомарно создает сессию или обновляет существующую
+     * 
+     * Заменяет последовательность sessionExists + refreshSession/addSession
+     * одной операцией без окна гонки между проверкой и изменением.
+     * @param imsi IMSI абонента
+     * @return CREATED если сессия создана, REFRESHED если обновлена существующая
+     */
+    virtual UpsertResult createOrRefresh(const Imsi& imsi) = 0;
 };
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <Imsi.h>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Разбирает IMSI или выбрасывает исключение
+ * @param digits Строка для разбора
+ * @return Упакованный IMSI
+ * @throws std::invalid_argument если строка имеет неверный формат
+ */
+Imsi parseOrThrow(std::string_view digits) {
+    auto imsi = Imsi::parse(digits);
+    if (!imsi) {
+        throw std::invalid_argument("Invalid IMSI format: " + std::string(digits) +
+                                    ". IMSI must be 15 digits.");
+    }
+    return *imsi;
+}
+
+} // namespace
+
+Imsi::Imsi(const std::string& digits)
+    : Imsi(parseOrThrow(digits)) {
+}
+
+Imsi::Imsi(const char* digits)
+    : Imsi(parseOrThrow(digits ? std::string_view(digits) : std::string_view())) {
+}
+
+std::string Imsi::toString() const {
+    std::string digits(LENGTH, '0');
+    uint64_t value = _value;
+    for (size_t i = LENGTH; i > 0 && value != 0; --i) {
+        digits[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return digits;
+}
+
+std::ostream& operator<<(std::ostream& os, const Imsi& imsi) {
+    return os << imsi.toString();
+}
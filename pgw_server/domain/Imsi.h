@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <compare>
+#include <ostream>
+#include <functional>
+
+/**
+ * @brief IMSI абонента, упакованный в 64-битное целое
+ * 
+ * IMSI всегда состоит из 15 десятичных цифр, поэтому хранится как их
+ * десятичное значение (< 10^15 < 2^50). Значение не требует выделения памяти,
+ * сравнивается одной инструкцией и служит ключом во всех хранилищах.
+ * Ведущие нули восстанавливаются при преобразовании в строку.
+ */
+class Imsi {
+public:
+    static constexpr size_t LENGTH = 15;                    // Количество цифр в IMSI
+    static constexpr uint64_t MAX_VALUE = 999999999999999;  // Максимальное упакованное значение
+
+    /**
+     * @brief Создает IMSI из строки из 15 цифр
+     * 
+     * Конструктор неявный: API, ранее принимавший IMSI строкой, принимает её и сейчас.
+     * @param digits Строка из 15 цифр
+     * @throws std::invalid_argument если строка имеет неверный формат
+     */
+    Imsi(const std::string& digits);
+
+    /**
+     * @brief Создает IMSI из C-строки из 15 цифр
+     * @param digits Строка из 15 цифр
+     * @throws std::invalid_argument если строка имеет неверный формат
+     */
+    Imsi(const char* digits);
+
+    /**
+     * @brief Разбирает IMSI из строки без исключений
+     * @param digits Строка для разбора
+     * @return IMSI или std::nullopt, если строка не является 15 цифрами
+     */
+    [[nodiscard]] static constexpr std::optional<Imsi> parse(std::string_view digits) noexcept {
+        if (digits.size() != LENGTH) {
+            return std::nullopt;
+        }
+        
+        uint64_t value = 0;
+        for (char c : digits) {
+            if (c < '0' || c > '9') {
+                return std::nullopt;
+            }
+            value = value * 10 + static_cast<uint64_t>(c - '0');
+        }
+        return Imsi(value);
+    }
+
+    /**
+     * @brief Создает IMSI из упакованного значения
+     * @param value Десятичное значение IMSI
+     * @return IMSI или std::nullopt, если значение больше MAX_VALUE
+     */
+    [[nodiscard]] static constexpr std::optional<Imsi> fromValue(uint64_t value) noexcept {
+        if (value > MAX_VALUE) {
+            return std::nullopt;
+        }
+        return Imsi(value);
+    }
+
+    /**
+     * @brief Возвращает упакованное значение IMSI
+     * @return Десятичное значение IMSI
+     */
+    [[nodiscard]] constexpr uint64_t value() const noexcept {
+        return _value;
+    }
+
+    /**
+     * @brief Возвращает хеш IMSI (финализатор MurmurHash3)
+     * 
+     * Соседние IMSI отличаются младшими битами, поэтому значение перемешивается,
+     * чтобы равномерно распределяться по бакетам и шардам.
+     * @return Хеш IMSI
+     */
+    [[nodiscard]] constexpr size_t hash() const noexcept {
+        uint64_t h = _value;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb93ec63fe53bULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+
+    /**
+     * @brief Возвращает IMSI в виде строки из 15 цифр
+     * @return Строка с IMSI (с ведущими нулями)
+     */
+    [[nodiscard]] std::string toString() const;
+
+    friend constexpr bool operator==(const Imsi&, const Imsi&) noexcept = default;
+    friend constexpr auto operator<=>(const Imsi&, const Imsi&) noexcept = default;
+
+    /**
+     * @brief Выводит IMSI в поток в виде строки из 15 цифр
+     */
+    friend std::ostream& operator<<(std::ostream& os, const Imsi& imsi);
+
+private:
+    explicit constexpr Imsi(uint64_t value) noexcept : _value(value) {}
+
+    uint64_t _value; // Десятичное значение IMSI
+};
+
+/**
+ * @brief Специализация std::hash для использования Imsi в неупорядоченных контейнерах
+ */
+template<>
+struct std::hash<Imsi> {
+    size_t operator()(const Imsi& imsi) const noexcept {
+        return imsi.hash();
+    }
+};
@@ -1,21 +1,15 @@
 #include <Session.h>
-#include <stdexcept>
-#include <regex>
 
-Session::Session(std::string imsi)
-    : _imsi(std::move(imsi)), _createdAt(std::chrono::system_clock::now()), _logger(nullptr) {
-    validateImsi(_imsi);
+Session::Session(Imsi imsi)
+    : _imsi(imsi), _createdAt(std::chrono::system_clock::now()), _logger(nullptr) {
 }
 
-Session::Session(std::string imsi, std::shared_ptr<Logger> logger)
-    : _imsi(std::move(imsi)), _createdAt(std::chrono::system_clock::now()), _logger(std::move(logger)) {
-    validateImsi(_imsi);
-    if (_logger) {
-        _logger->debug("Session created for IMSI: " + _imsi);
-    }
+Session::Session(Imsi imsi, std::shared_ptr<Logger> logger)
+    : _imsi(imsi), _createdAt(std::chrono::system_clock::now()), _logger(std::move(logger)) {
+    PGW_LOG_DEBUG(_logger, "Session created for IMSI: {}", _imsi.toString());
 }
 
-const std::string& Session::getImsi() const {
+const Imsi& Session::getImsi() const {
     return _imsi;
 }
 
@@ -28,10 +22,9 @@ bool Session::isExpired(std::chrono::seconds timeout) const {
     auto age = std::chrono::duration_cast<std::chrono::seconds>(now - _createdAt);
     bool expired = age > timeout;
     
-    if (_logger && expired) {
-        _logger->debug("Session for IMSI " + _imsi + " expired after " + 
-                      std::to_string(age.count()) + "s (timeout: " + 
-                      std::to_string(timeout.count()) + "s)");
+    if (expired) {
+        PGW_LOG_DEBUG(_logger, "Session for IMSI {} expired after {}s (timeout: {}s)",
+                      _imsi.toString(), age.count(), timeout.count());
     }
     
     return expired;
@@ -41,24 +34,12 @@ std::chrono::seconds Session::getAge() const {
     auto now = std::chrono::system_clock::now();
     auto age = std::chrono::duration_cast<std::chrono::seconds>(now - _createdAt);
     
-    if (_logger) {
-        _logger->debug("Session for IMSI " + _imsi + " age: " + std::to_string(age.count()) + "s");
-    }
+    PGW_LOG_DEBUG(_logger, "Session for IMSI {} age: {}s", _imsi.toString(), age.count());
     
     return age;
 }
 
-void Session::validateImsi(const std::string& imsi) {
-    std::regex imsiPattern("^[0-9]{15}$");
-    if (!std::regex_match(imsi, imsiPattern)) {
-        std::string errorMsg = "Invalid IMSI format: " + imsi + ". IMSI must be 15 digits.";
-        throw std::invalid_argument(errorMsg);
-    }
-} 
-
 void Session::refresh() {
     _createdAt = std::chrono::system_clock::now();
-    if (_logger) {
-        _logger->debug("Session for IMSI " + _imsi + " refreshed (createdAt updated)");
-    }
+    PGW_LOG_DEBUG(_logger, "Session for IMSI {} refreshed (createdAt updated)", _imsi.toString());
 } 
\ No newline at end of file
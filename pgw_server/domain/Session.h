@@ -1,5 +1,6 @@
 // domain/Session.hpp
 #pragma once
+#include <Imsi.h>
 #include <string>
 #include <chrono>
 #include <Logger.h>
@@ -15,19 +16,17 @@ class Session {
 public:
     /**
      * @brief Создает новую сессию с текущим временем
-     * @param imsi IMSI абонента (15 цифр)
-     * @throws std::invalid_argument если IMSI имеет неверный формат
+     * @param imsi IMSI абонента
      */
-    explicit Session(std::string imsi);
+    explicit Session(Imsi imsi);
 
 
     /**
      * @brief Создает новую сессию с текущим временем и логгером
-     * @param imsi IMSI абонента (15 цифр)
+     * @param imsi IMSI абонента
      * @param logger Указатель на логгер
-     * @throws std::invalid_argument если IMSI имеет неверный формат
      */
-    Session(std::string imsi, std::shared_ptr<Logger> logger);
+    Session(Imsi imsi, std::shared_ptr<Logger> logger);
     
 
     // Поддержка семантики копирования и перемещения
@@ -39,7 +38,7 @@ public:
     ~Session() = default;
 
     // Геттеры
-    [[nodiscard]] const std::string& getImsi() const;
+    [[nodiscard]] const Imsi& getImsi() const;
     [[nodiscard]] const std::chrono::system_clock::time_point& getCreatedAt() const;
     
     /**
@@ -58,14 +57,7 @@ public:
     void refresh();
 
 private:
-    /**
-     * @brief Проверяет формат IMSI
-     * @param imsi IMSI для проверки
-     * @throws std::invalid_argument если IMSI имеет неверный формат
-     */
-    void validateImsi(const std::string& imsi);
-    
-    std::string _imsi;                                  // IMSI абонента
+    Imsi _imsi;                                         // IMSI абонента
     std::chrono::system_clock::time_point _createdAt;   // Время создания сессии
     std::shared_ptr<Logger> _logger;                    // Логгер (может быть nullptr)
 };
\ No newline at end of file
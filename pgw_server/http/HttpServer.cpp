@@ -1,5 +1,6 @@
 #include <HttpServer.h>
 #include <httplib.h>
+#include <Imsi.h>
 #include <utility>
 #include <stdexcept>
 
@@ -8,10 +9,12 @@ HttpServer::HttpServer(const std::string& ip,
                      std::shared_ptr<SessionManager> sessionManager,
                      std::shared_ptr<GracefulShutdownManager> shutdownManager,
                      std::shared_ptr<Logger> logger,
-                     StopCallback onStopRequested)
+                     StopCallback onStopRequested,
+                     ReloadCallback onReloadRequested)
     : _ip(ip),
       _port(port),
       _onStopRequested(std::move(onStopRequested)),
+      _onReloadRequested(std::move(onReloadRequested)),
       _sessionManager(std::move(sessionManager)),
       _shutdownManager(std::move(shutdownManager)),
       _logger(std::move(logger)),
@@ -125,6 +128,14 @@ void HttpServer::setupRoutes() const {
         res.set_content(response, "text/plain");
     });
     
+    // Маршрут для перезагрузки черного списка
+    server->Get(RELOAD_BLACKLIST_PATH, [this](const httplib::Request& req, httplib::Response& res) {
+        _logger->info("Received blacklist reload request from " + req.remote_addr);
+        std::string response;
+        res.status = handleReloadBlacklist(response);
+        res.set_content(response, "text/plain");
+    });
+    
     // Маршрут для проверки работоспособности сервера
     server->Get("/health", [this](const httplib::Request& req, httplib::Response& res) {
         _logger->debug("Received health check from " + req.remote_addr);
@@ -139,6 +150,11 @@ void HttpServer::setupRoutes() const {
     
     // Обработчик для всех остальных маршрутов
     server->set_error_handler([this](const httplib::Request& req, httplib::Response& res) {
+        // httplib вызывает обработчик для любого статуса >= 400: ошибку перезагрузки
+        // черного списка с текстом из handleReloadBlacklist возвращаем как есть
+        if (req.path == RELOAD_BLACKLIST_PATH && !res.body.empty()) {
+            return;
+        }
         _logger->warn("Invalid request to " + req.path + " from " + req.remote_addr);
         res.status = 404;
         res.set_content("Not Found", "text/plain");
@@ -149,7 +165,13 @@ void HttpServer::setupRoutes() const {
 void HttpServer::handleCheckSubscriber(const std::string& imsi, std::string& response) const {
     _logger->info("Checking subscriber status for IMSI: " + imsi);
     
-    if (_sessionManager->isSessionActive(imsi)) {
+    // IMSI неверного формата не может иметь активной сессии
+    auto parsedImsi = Imsi::parse(imsi);
+    if (!parsedImsi) {
+        _logger->warn("Invalid IMSI format in check_subscriber request: " + imsi);
+    }
+    
+    if (parsedImsi && _sessionManager->isSessionActive(*parsedImsi)) {
         response = "active";
     } else {
         response = "not active";
@@ -174,4 +196,22 @@ void HttpServer::handleStopCommand(std::string& response) const {
             response = "Shutdown already in progress";
         }
     }
-} 
\ No newline at end of file
+} 
+
+int HttpServer::handleReloadBlacklist(std::string& response) const {
+    if (!_onReloadRequested) {
+        _logger->warn("Blacklist reload requested, but no blacklist file is configured");
+        response = "Blacklist reload is not configured";
+        return 501;
+    }
+    
+    try {
+        size_t count = _onReloadRequested();
+        response = "Blacklist reloaded: " + std::to_string(count) + " items";
+        return 200;
+    } catch (const std::exception& e) {
+        _logger->error("Blacklist reload failed: " + std::string(e.what()));
+        response = "Blacklist reload failed: " + std::string(e.what());
+        return 500;
+    }
+}
@@ -20,6 +20,7 @@ namespace httplib {
  * Предоставляет REST API для проверки статуса сессий и управления системой:
  * - GET /check_subscriber?imsi=XXX - проверка статуса абонента
  * - GET /stop - инициирование плавного завершения работы
+ * - GET /reload_blacklist - перезагрузка черного списка из файла
  * - GET /health - проверка работоспособности сервера
  */
 class HttpServer {
@@ -29,6 +30,13 @@ public:
      */
     using StopCallback = std::function<void()>;
 
+    /**
+     * @brief Тип функции обратного вызова для перезагрузки черного списка
+     *
+     * Возвращает количество IMSI в новом списке, при ошибке выбрасывает исключение.
+     */
+    using ReloadCallback = std::function<size_t()>;
+
     /**
      * @brief Создает новый HTTP-сервер
      * @param ip IP-адрес для прослушивания
@@ -37,13 +45,16 @@ public:
      * @param shutdownManager Указатель на менеджер плавного завершения
      * @param logger Указатель на логгер
      * @param onStopRequested Функция обратного вызова для обработки команды остановки
+     * @param onReloadRequested Функция обратного вызова для перезагрузки черного списка
+     *        (если не задана, /reload_blacklist отвечает 501)
      */
     HttpServer(const std::string& ip,
                uint16_t port,
                std::shared_ptr<SessionManager> sessionManager,
                std::shared_ptr<GracefulShutdownManager> shutdownManager,
                std::shared_ptr<Logger> logger,
-               StopCallback onStopRequested = nullptr);
+               StopCallback onStopRequested = nullptr,
+               ReloadCallback onReloadRequested = nullptr);
     
     /**
      * @brief Деструктор, останавливает сервер
@@ -80,6 +91,8 @@ public:
     [[nodiscard]] uint16_t getPort() const { return _port; }
 
 private:
+    static constexpr const char* RELOAD_BLACKLIST_PATH = "/reload_blacklist"; // Маршрут перезагрузки черного списка
+
     /**
      * @brief Настраивает маршруты HTTP-сервера
      */
@@ -97,12 +110,20 @@ private:
      * @param response Строка для записи ответа
      */
     void handleStopCommand(std::string& response) const;
+    
+    /**
+     * @brief Обрабатывает команду перезагрузки черного списка
+     * @param response Строка для записи ответа
+     * @return HTTP-статус ответа
+     */
+    int handleReloadBlacklist(std::string& response) const;
 
     std::string _ip;                                 // IP-адрес для прослушивания
     uint16_t _port;                                  // Порт для прослушивания
     std::atomic<bool> _running{false};             // Флаг работы сервера
     std::thread _serverThread;                       // Поток сервера
     StopCallback _onStopRequested;                   // Функция обратного вызова для обработки команды остановки
+    ReloadCallback _onReloadRequested;               // Функция обратного вызова для перезагрузки черного списка
 
     std::shared_ptr<SessionManager> _sessionManager;           // Менеджер сессий
     std::shared_ptr<GracefulShutdownManager> _shutdownManager; // Менеджер плавного завершения
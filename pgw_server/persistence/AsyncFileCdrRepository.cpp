@@ -0,0 +1,234 @@
+#include <AsyncFileCdrRepository.h>
+#include <ServerMetrics.h>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+AsyncFileCdrRepository::AsyncFileCdrRepository(std::string filePath, AsyncCdrOptions options,
+                                               std::shared_ptr<Logger> logger)
+    : _filePath(std::move(filePath)),
+      _options(options),
+      _logger(std::move(logger)),
+      _queue(_options.queueCapacity),
+      _wakeThreshold(static_cast<int64_t>(std::max<size_t>(_queue.capacity() / 2, 1)))
+{
+    if (_options.flushInterval.count() <= 0) throw std::invalid_argument("flushInterval must be positive");
+    if (_options.flushBytes == 0) throw std::invalid_argument("flushBytes must be positive");
+    
+    // Открываем файл для append
+    _file.open(_filePath, std::ios::app);
+    if (!_file.is_open()) {
+        _isHealthy = false;
+        if (_logger) {
+            _logger->critical("Failed to initialize async CDR repository: cannot open file " + _filePath);
+        }
+    } else if (_logger) {
+        _logger->info("Async CDR repository initialized with file: " + _filePath +
+                      " (queue: " + std::to_string(_queue.capacity()) +
+                      ", flush interval: " + std::to_string(_options.flushInterval.count()) + "ms" +
+                      ", flush bytes: " + std::to_string(_options.flushBytes) + ")");
+    }
+    
+    _buffer.reserve(_options.flushBytes);
+    _writerThread = std::thread(&AsyncFileCdrRepository::writerLoop, this);
+}
+
+AsyncFileCdrRepository::~AsyncFileCdrRepository() {
+    {
+        // Флаг меняется под мьютексом ожидания, иначе писатель может проверить предикат до
+        // изменения и уснуть после уведомления, пропустив остановку на весь интервал сброса
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _running = false;
+    }
+    _wakeCondition.notify_one();
+    
+    if (_writerThread.joinable()) {
+        _writerThread.join();
+    }
+    
+    if (_file.is_open()) {
+        _file.close();
+    }
+    
+    if (_logger) {
+        _logger->debug("Async CDR repository stopped: " + _filePath +
+                      " (dropped: " + std::to_string(_dropped.load()) + ")");
+    }
+}
+
+bool AsyncFileCdrRepository::writeCdr(const std::string& imsi, const std::string& action) {
+    // Время фиксируется сразу, а форматируется уже в потоке записи
+    CdrRecord record{std::chrono::system_clock::now(), {}, imsi, action};
+    return enqueue(record);
+}
+
+bool AsyncFileCdrRepository::writeCdr(const std::string& imsi, const std::string& action,
+                                      const std::string& timestamp) {
+    CdrRecord record{{}, timestamp, imsi, action};
+    return enqueue(record);
+}
+
+void AsyncFileCdrRepository::flush() {
+    std::unique_lock<std::mutex> lock(_wakeMutex);
+    uint64_t target = ++_flushRequested;
+    _wakeCondition.notify_one();
+    _flushCondition.wait(lock, [this, target]() { return _flushCompleted >= target; });
+}
+
+uint64_t AsyncFileCdrRepository::getDroppedCount() const {
+    return _dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t AsyncFileCdrRepository::getBackpressureCount() const {
+    return _backpressure.load(std::memory_order_relaxed);
+}
+
+bool AsyncFileCdrRepository::enqueue(CdrRecord& record) {
+    if (!_isHealthy.load(std::memory_order_relaxed)) {
+        if (_logger) {
+            _logger->error("CDR write failed: repository is in unhealthy state");
+        }
+        return false;
+    }
+    
+    if (_queue.tryPush(record)) {
+        // Будит поток записи только производитель, заполнивший очередь до порога
+        if (_queued.fetch_add(1, std::memory_order_relaxed) + 1 == _wakeThreshold) {
+            requestWake();
+        }
+        return true;
+    }
+    
+    // Очередь заполнена: будим поток записи и ждем освобождения места
+    _backpressure.fetch_add(1, std::memory_order_relaxed);
+    ServerMetrics::incCdrBackpressure();
+    requestWake();
+    
+    auto deadline = std::chrono::steady_clock::now() + _options.maxEnqueueWait;
+    while (std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+        if (_queue.tryPush(record)) {
+            _queued.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    
+    _dropped.fetch_add(1, std::memory_order_relaxed);
+    ServerMetrics::incCdrDropped();
+    if (_logger) {
+        _logger->warn("CDR queue full, record dropped for IMSI: " + record.imsi + ", action: " + record.action);
+    }
+    return false;
+}
+
+void AsyncFileCdrRepository::requestWake() {
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _wakeRequested = true;
+    }
+    _wakeCondition.notify_one();
+}
+
+void AsyncFileCdrRepository::writerLoop() {
+    // Время появления самой старой записи в буфере
+    auto oldestBuffered = std::chrono::steady_clock::now();
+    uint64_t flushCompleted = 0;
+    
+    while (true) {
+        // Останов и запрос flush читаем до опустошения очереди, чтобы учесть все записи, принятые до них
+        bool stopping = !_running.load();
+        uint64_t flushTarget;
+        {
+            std::lock_guard<std::mutex> lock(_wakeMutex);
+            flushTarget = _flushRequested;
+            // Сбрасываем до опустошения: пробуждение, запрошенное после, не теряется
+            _wakeRequested = false;
+        }
+        
+        bool wasEmpty = _buffer.empty();
+        _queued.fetch_sub(static_cast<int64_t>(drainQueue()), std::memory_order_relaxed);
+        
+        auto now = std::chrono::steady_clock::now();
+        if (wasEmpty && !_buffer.empty()) {
+            oldestBuffered = now;
+        }
+        
+        bool flushDue = _buffer.size() >= _options.flushBytes ||
+                        (!_buffer.empty() && now - oldestBuffered >= _options.flushInterval);
+        if (flushDue || flushTarget != flushCompleted || stopping) {
+            writeBuffer();
+        }
+        
+        if (flushTarget != flushCompleted) {
+            flushCompleted = flushTarget;
+            {
+                std::lock_guard<std::mutex> lock(_wakeMutex);
+                _flushCompleted = flushCompleted;
+            }
+            _flushCondition.notify_all();
+        }
+        
+        if (stopping) {
+            break;
+        }
+        
+        // Спим до срока сброса буфера, запроса flush, заполнения очереди или остановки.
+        // Ждем абсолютный срок: округление остатка до миллисекунд вниз давало бы wait_for(0) и холостой цикл
+        auto deadline = (_buffer.empty() ? now : oldestBuffered) + _options.flushInterval;
+        
+        std::unique_lock<std::mutex> lock(_wakeMutex);
+        _wakeCondition.wait_until(lock, deadline, [this, flushCompleted]() {
+            return !_running.load() || _flushRequested != flushCompleted || _wakeRequested;
+        });
+    }
+    
+    // Отпускаем ожидающих flush, если запрос пришел во время остановки
+    {
+        std::lock_guard<std::mutex> lock(_wakeMutex);
+        _flushCompleted = _flushRequested;
+    }
+    _flushCondition.notify_all();
+}
+
+size_t AsyncFileCdrRepository::drainQueue() {
+    size_t count = 0;
+    
+    while (auto record = _queue.tryPop()) {
+        if (record->timestamp.empty()) {
+            _timestampFormatter.append(record->time, _buffer);
+        } else {
+            _buffer += record->timestamp;
+        }
+        _buffer += ',';
+        _buffer += record->imsi;
+        _buffer += ',';
+        _buffer += record->action;
+        _buffer += '\n';
+        ++count;
+    }
+    
+    return count;
+}
+
+void AsyncFileCdrRepository::writeBuffer() {
+    if (_buffer.empty()) {
+        return;
+    }
+    
+    if (_isHealthy.load(std::memory_order_relaxed)) {
+        // Один крупный блок вместо сброса на каждой записи
+        _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _file.flush();
+        
+        if (_file.fail()) {
+            _isHealthy = false;
+            if (_logger) {
+                _logger->critical("CDR system failure: write operation failed on file " + _filePath);
+            }
+        } else if (_logger) {
+            _logger->debug("CDR batch written: " + std::to_string(_buffer.size()) + " bytes");
+        }
+    }
+    
+    _buffer.clear();
+}
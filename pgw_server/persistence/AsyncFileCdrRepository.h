@@ -0,0 +1,161 @@
+#pragma once
+
+#include <ICdrRepository.h>
+#include <BoundedMpscQueue.h>
+#include <Logger.h>
+#include <TimestampFormatter.h>
+#include <string>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+/**
+ * @brief Параметры асинхронной записи CDR
+ */
+struct AsyncCdrOptions {
+    size_t queueCapacity = 65536;                              // Емкость очереди записей (округляется до степени двойки)
+    std::chrono::milliseconds flushInterval{100};              // Максимальная задержка записи в файл
+    size_t flushBytes = 64 * 1024;                             // Размер буфера, при котором запись выполняется немедленно
+    std::chrono::microseconds maxEnqueueWait{1000};            // Сколько производитель ждет места в очереди перед сбросом записи
+};
+
+/**
+ * @brief Репозиторий CDR с асинхронной пакетной записью в файл
+ *
+ * Потоки запросов только кладут запись в lock-free очередь MPSC; отдельный поток
+ * форматирует записи, накапливает их в буфере и пишет в файл крупными блоками —
+ * по достижении flushBytes или раз в flushInterval. Формат строки совпадает
+ * с FileCdrRepository: timestamp,IMSI,action.
+ * 
+ * При заполненной очереди производитель будит поток записи и ждет до
+ * maxEnqueueWait (backpressure), после чего запись отбрасывается и учитывается
+ * в счетчике потерь. Поток записи также будится, когда очередь заполнена
+ * наполовину, поэтому под нагрузкой очередь опустошается и flushBytes
+ * проверяется, не дожидаясь flushInterval.
+ */
+class AsyncFileCdrRepository : public ICdrRepository {
+public:
+    /**
+     * @brief Создает репозиторий и запускает поток записи
+     * @param filePath Путь к файлу для записи CDR
+     * @param options Параметры очереди и сброса буфера
+     * @param logger Указатель на логгер (может быть nullptr)
+     * @throws std::invalid_argument если flushInterval или flushBytes равны 0
+     */
+    AsyncFileCdrRepository(std::string filePath, AsyncCdrOptions options,
+                           std::shared_ptr<Logger> logger = nullptr);
+    
+    /**
+     * @brief Дописывает все принятые записи и останавливает поток записи
+     */
+    ~AsyncFileCdrRepository() override;
+
+    // Запрещаем копирование и перемещение
+    AsyncFileCdrRepository(const AsyncFileCdrRepository&) = delete;
+    AsyncFileCdrRepository& operator=(const AsyncFileCdrRepository&) = delete;
+    AsyncFileCdrRepository(AsyncFileCdrRepository&&) = delete;
+    AsyncFileCdrRepository& operator=(AsyncFileCdrRepository&&) = delete;
+
+    /**
+     * @brief Ставит в очередь CDR с текущим временем
+     * @param imsi IMSI абонента
+     * @param action Действие
+     * @return true если запись принята, false если отброшена или репозиторий неработоспособен
+     */
+    bool writeCdr(const std::string& imsi, const std::string& action) override;
+    
+    /**
+     * @brief Ставит в очередь CDR с указанным временем
+     * @param imsi IMSI абонента
+     * @param action Действие
+     * @param timestamp Временная метка в строковом формате
+     * @return true если запись принята, false если отброшена или репозиторий неработоспособен
+     */
+    bool writeCdr(const std::string& imsi, const std::string& action,
+                 const std::string& timestamp) override;
+
+    /**
+     * @brief Дожидается записи в файл всех CDR, принятых до вызова
+     */
+    void flush() override;
+
+    /**
+     * @brief Возвращает количество отброшенных записей
+     * @return Количество записей, не поместившихся в очередь
+     */
+    [[nodiscard]] uint64_t getDroppedCount() const;
+
+    /**
+     * @brief Возвращает количество ожиданий места в очереди
+     * @return Сколько раз производитель застал очередь заполненной
+     */
+    [[nodiscard]] uint64_t getBackpressureCount() const;
+
+private:
+    /**
+     * @brief Запись CDR в очереди
+     */
+    struct CdrRecord {
+        std::chrono::system_clock::time_point time; // Время события (если timestamp пуст)
+        std::string timestamp;                      // Явно заданная временная метка
+        std::string imsi;                           // IMSI абонента
+        std::string action;                         // Действие
+    };
+
+    /**
+     * @brief Ставит запись в очередь с ожиданием места
+     * @param record Запись
+     * @return true если запись принята
+     */
+    bool enqueue(CdrRecord& record);
+
+    /**
+     * @brief Будит поток записи, не дожидаясь срока сброса буфера
+     */
+    void requestWake();
+
+    /**
+     * @brief Рабочий метод потока записи
+     */
+    void writerLoop();
+
+    /**
+     * @brief Переносит все записи из очереди в буфер
+     * @return Количество перенесенных записей
+     */
+    size_t drainQueue();
+
+    /**
+     * @brief Записывает буфер в файл
+     */
+    void writeBuffer();
+
+    std::string _filePath;                          // Путь к файлу CDR
+    AsyncCdrOptions _options;                       // Параметры очереди и сброса
+    std::shared_ptr<Logger> _logger;                // Логгер (может быть nullptr)
+    
+    BoundedMpscQueue<CdrRecord> _queue;             // Очередь записей от потоков запросов
+    std::string _buffer;                            // Буфер отформатированных строк (только поток записи)
+    TimestampFormatter _timestampFormatter;         // Форматтер временных меток (только поток записи)
+    std::ofstream _file;                            // Файловый поток (только поток записи)
+    std::atomic<bool> _isHealthy{true};             // Флаг работоспособности
+    
+    std::atomic<bool> _running{true};               // Флаг работы потока записи
+    std::atomic<uint64_t> _dropped{0};              // Количество отброшенных записей
+    std::atomic<uint64_t> _backpressure{0};         // Количество ожиданий места в очереди
+    std::atomic<int64_t> _queued{0};                // Приблизительное число записей в очереди
+    int64_t _wakeThreshold;                         // Число записей в очереди, при котором будится поток записи
+    
+    std::mutex _wakeMutex;                          // Мьютекс для пробуждения и flush
+    std::condition_variable _wakeCondition;         // Пробуждение потока записи
+    std::condition_variable _flushCondition;        // Уведомление о завершении flush
+    uint64_t _flushRequested = 0;                   // Номер последнего запроса flush
+    uint64_t _flushCompleted = 0;                   // Номер последнего выполненного flush
+    bool _wakeRequested = false;                    // Поток записи должен опустошить очередь немедленно
+    
+    std::thread _writerThread;                      // Поток записи
+};
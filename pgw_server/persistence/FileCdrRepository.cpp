@@ -1,7 +1,5 @@
 #include <FileCdrRepository.h>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
 #include <utility>
 
 FileCdrRepository::FileCdrRepository(std::string filePath)
@@ -34,13 +32,20 @@ FileCdrRepository::~FileCdrRepository() {
 }
 
 bool FileCdrRepository::writeCdr(const std::string& imsi, const std::string& action) {
-    // Используем текущее время
-    return writeCdr(imsi, action, getCurrentTimestamp());
+    std::lock_guard<std::mutex> lock(_mutex);
+    
+    // Используем текущее время без промежуточной строки
+    char timestamp[TimestampFormatter::MAX_LENGTH];
+    size_t length = _timestampFormatter.format(std::chrono::system_clock::now(), timestamp);
+    return writeRecord(imsi, action, std::string_view(timestamp, length));
 }
 
 bool FileCdrRepository::writeCdr(const std::string& imsi, const std::string& action, const std::string& timestamp) {
     std::lock_guard<std::mutex> lock(_mutex);
-    
+    return writeRecord(imsi, action, timestamp);
+}
+
+bool FileCdrRepository::writeRecord(const std::string& imsi, const std::string& action, std::string_view timestamp) {
     if (!_isHealthy) {
         if (_logger) {
             _logger->error("CDR write failed: repository is in unhealthy state");
@@ -67,21 +72,16 @@ bool FileCdrRepository::writeCdr(const std::string& imsi, const std::string& act
         return false;
     }
     
-    if (_logger) {
-        _logger->debug("CDR record written: " + timestamp + "," + imsi + "," + action);
-    }
+    PGW_LOG_DEBUG(_logger, "CDR record written: {},{},{}", timestamp, imsi, action);
     
     return true;
 }
 
-std::string FileCdrRepository::getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
-    
-    return ss.str();
+void FileCdrRepository::flush() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_file.is_open()) {
+        _file.flush();
+    }
 }
 
 bool FileCdrRepository::openFileIfNeeded() {
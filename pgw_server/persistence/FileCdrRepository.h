@@ -2,7 +2,9 @@
 
 #include <ICdrRepository.h>
 #include <Logger.h>
+#include <TimestampFormatter.h>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <mutex>
 #include <memory>
@@ -54,11 +56,21 @@ public:
     bool writeCdr(const std::string& imsi, const std::string& action,
                  const std::string& timestamp) override;
 
+    /**
+     * @brief Сбрасывает буфер файлового потока
+     */
+    void flush() override;
+
 private:
     /**
-     * @brief Возвращает текущую временную метку в формате YYYY-MM-DD HH:MM:SS
+     * @brief Записывает строку CDR в файл
+     * @param imsi IMSI абонента
+     * @param action Действие
+     * @param timestamp Временная метка
+     * @return true если запись успешно создана, иначе false
+     * @note Вызывающая функция должна захватить мьютекс перед вызовом
      */
-    [[nodiscard]] static std::string getCurrentTimestamp();
+    bool writeRecord(const std::string& imsi, const std::string& action, std::string_view timestamp);
     
     /**
      * @brief Открывает файл, если он еще не открыт
@@ -72,4 +84,5 @@ private:
     std::ofstream _file;           // Файловый поток
     bool _isHealthy = true;        // Флаг работоспособности
     std::shared_ptr<Logger> _logger; // Логгер (может быть nullptr)
+    TimestampFormatter _timestampFormatter; // Форматтер текущего времени (под мьютексом)
 };
\ No newline at end of file
@@ -15,64 +15,61 @@ InMemorySessionRepository::InMemorySessionRepository(std::shared_ptr<Logger> log
 bool InMemorySessionRepository::addSession(const Session& session) {
     std::lock_guard<std::mutex> lock(_mutex);
     
-    const std::string& imsi = session.getImsi();
+    const Imsi& imsi = session.getImsi();
     
     // Проверяем, существует ли уже сессия с таким IMSI
     if (_sessions.contains(imsi)) {
-        if (_logger) {
-            _logger->debug("Session add failed: IMSI " + imsi + " already exists");
-        }
+        PGW_LOG_DEBUG(_logger, "Session add failed: IMSI {} already exists", imsi.toString());
         return false;
     }
     
     // Используем emplace для эффективного добавления
     auto [it, inserted] = _sessions.emplace(imsi, session);
-    
-    if (_logger) {
-        if (inserted) {
-            _logger->debug("Session added for IMSI: " + imsi + 
-                          " (total sessions: " + std::to_string(_sessions.size()) + ")");
-        } else {
-            _logger->warn("Failed to add session for IMSI: " + imsi);
-        }
+    if (inserted) {
+        linkAsNewest(it->second);
+        PGW_LOG_DEBUG(_logger, "Session added for IMSI: {} (total sessions: {})",
+                      imsi.toString(), _sessions.size());
+    } else {
+        PGW_LOG_WARN(_logger, "Failed to add session for IMSI: {}", imsi.toString());
     }
     
     return inserted;
 }
 
-bool InMemorySessionRepository::removeSession(const std::string& imsi) {
+bool InMemorySessionRepository::removeSession(const Imsi& imsi) {
     std::lock_guard<std::mutex> lock(_mutex);
     
-    auto count = _sessions.erase(imsi);
+    size_t count = 0;
+    if (auto it = _sessions.find(imsi); it != _sessions.end()) {
+        unlink(it->second);
+        _sessions.erase(it);
+        count = 1;
+    }
     
-    if (_logger) {
-        if (count > 0) {
-            _logger->debug("Session removed for IMSI: " + imsi + 
-                          " (remaining sessions: " + std::to_string(_sessions.size()) + ")");
-        } else {
-            _logger->debug("Session removal failed: IMSI " + imsi + " not found");
-        }
+    if (count > 0) {
+        PGW_LOG_DEBUG(_logger, "Session removed for IMSI: {} (remaining sessions: {})",
+                      imsi.toString(), _sessions.size());
+    } else {
+        PGW_LOG_DEBUG(_logger, "Session removal failed: IMSI {} not found", imsi.toString());
     }
     
     return count > 0;
 }
 
-bool InMemorySessionRepository::sessionExists(const std::string& imsi) const {
+bool InMemorySessionRepository::sessionExists(const Imsi& imsi) const {
     std::lock_guard<std::mutex> lock(_mutex);
     bool exists = _sessions.contains(imsi);
     
-    if (_logger) {
-        _logger->debug("Session existence check for IMSI " + imsi + ": " + 
-                      (exists ? "exists" : "not found"));
-    }
+    PGW_LOG_DEBUG(_logger, "Session existence check for IMSI {}: {}",
+                  imsi.toString(), exists ? "exists" : "not found");
     
     return exists;
 }
 
-std::vector<std::string> InMemorySessionRepository::getAllImsis() const {
+std::vector<Imsi> InMemorySessionRepository::getAllImsis() const {
     std::lock_guard<std::mutex> lock(_mutex);
     
-    std::vector<std::string> imsis;
+    std::vector<Imsi> imsis;
     imsis.reserve(_sessions.size());
     
     for (const auto &key: _sessions | std::views::keys) {
@@ -98,6 +95,8 @@ void InMemorySessionRepository::clear() {
     
     size_t count = _sessions.size();
     _sessions.clear();
+    _oldest = nullptr;
+    _newest = nullptr;
     
     if (_logger) {
         _logger->info("Repository cleared, removed " + std::to_string(count) + " sessions");
@@ -109,22 +108,100 @@ std::vector<Session> InMemorySessionRepository::getExpiredSessions(uint32_t time
     
     std::vector<Session> expiredSessions;
     const auto timeout = std::chrono::seconds(timeoutSeconds);
+    const auto now = std::chrono::steady_clock::now();
     
-    for (const auto &val: _sessions | std::views::values) {
-        if (const auto &session = val; session.isExpired(timeout)) {
-            expiredSessions.push_back(session);
-        }
+    // Список упорядочен по времени активности: останавливаемся на первой неистекшей сессии
+    for (const SessionEntry* entry = _oldest; entry && isExpired(*entry, timeout, now); entry = entry->next) {
+        expiredSessions.push_back(entry->session);
     }
     
     return expiredSessions;
 }
 
-bool InMemorySessionRepository::refreshSession(const std::string& imsi) {
+std::vector<Imsi> InMemorySessionRepository::removeExpiredSessions(uint32_t timeoutSeconds, size_t maxCount) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    
+    std::vector<Imsi> removedImsis;
+    const auto timeout = std::chrono::seconds(timeoutSeconds);
+    const auto now = std::chrono::steady_clock::now();
+    
+    while (_oldest && removedImsis.size() < maxCount && isExpired(*_oldest, timeout, now)) {
+        SessionEntry* entry = _oldest;
+        Imsi imsi = entry->session.getImsi();
+        unlink(*entry);
+        _sessions.erase(imsi);
+        removedImsis.push_back(imsi);
+    }
+    
+    if (!removedImsis.empty()) {
+        PGW_LOG_DEBUG(_logger, "Removed {} expired sessions (remaining sessions: {})",
+                      removedImsis.size(), _sessions.size());
+    }
+    
+    return removedImsis;
+}
+
+bool InMemorySessionRepository::refreshSession(const Imsi& imsi) {
     std::lock_guard<std::mutex> lock(_mutex);
     auto it = _sessions.find(imsi);
     if (it != _sessions.end()) {
-        it->second.refresh();
+        it->second.session.refresh();
+        unlink(it->second);
+        linkAsNewest(it->second);
         return true;
     }
     return false;
-}
\ No newline at end of file
+}
+
+UpsertResult InMemorySessionRepository::createOrRefresh(const Imsi& imsi) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    
+    // try_emplace выполняет одну пробу хеш-таблицы и создает сессию только при отсутствии ключа
+    auto [it, inserted] = _sessions.try_emplace(imsi, imsi, _logger);
+    if (!inserted) {
+        it->second.session.refresh();
+        unlink(it->second);
+    }
+    linkAsNewest(it->second);
+    
+    PGW_LOG_DEBUG(_logger, "Session {} for IMSI: {} (total sessions: {})",
+                  inserted ? "created" : "refreshed", imsi.toString(), _sessions.size());
+    
+    return inserted ? UpsertResult::CREATED : UpsertResult::REFRESHED;
+}
+
+void InMemorySessionRepository::linkAsNewest(SessionEntry& entry) {
+    entry.lastActivity = std::chrono::steady_clock::now();
+    entry.prev = _newest;
+    entry.next = nullptr;
+    
+    if (_newest) {
+        _newest->next = &entry;
+    } else {
+        _oldest = &entry;
+    }
+    _newest = &entry;
+}
+
+void InMemorySessionRepository::unlink(SessionEntry& entry) {
+    if (entry.prev) {
+        entry.prev->next = entry.next;
+    } else {
+        _oldest = entry.next;
+    }
+    
+    if (entry.next) {
+        entry.next->prev = entry.prev;
+    } else {
+        _newest = entry.prev;
+    }
+    
+    entry.prev = nullptr;
+    entry.next = nullptr;
+}
+
+bool InMemorySessionRepository::isExpired(const SessionEntry& entry, std::chrono::seconds timeout,
+                                          std::chrono::steady_clock::time_point now) {
+    // Та же граница, что и в Session::isExpired: возраст в целых секундах строго больше таймаута
+    return std::chrono::duration_cast<std::chrono::seconds>(now - entry.lastActivity) > timeout;
+}
@@ -4,16 +4,23 @@
 #include <Session.h>
 #include <Logger.h>
 #include <unordered_map>
+#include <chrono>
 #include <mutex>
 #include <string>
 #include <vector>
 #include <memory>
+#include <utility>
 
 /**
  * @brief Потокобезопасное in-memory хранилище сессий
  * 
  * Реализует интерфейс ISessionRepository для хранения сессий в оперативной памяти
  * Не сохраняет данные между перезапусками приложения
+ * 
+ * Записи дополнительно связаны интрузивным двусвязным списком в порядке времени
+ * последней активности по steady_clock: вставка и обновление переносят запись в конец
+ * списка за O(1), а поиск и удаление истекших сессий идут от начала и стоят O(истекших),
+ * а не O(всех). Перевод системных часов не нарушает порядок списка.
  */
 class InMemorySessionRepository : public ISessionRepository {
 public:
@@ -48,20 +55,20 @@ public:
      * @param imsi IMSI абонента
      * @return true, если сессия была удалена
      */
-    bool removeSession(const std::string& imsi) override;
+    bool removeSession(const Imsi& imsi) override;
 
     /**
      * @brief Проверить наличие сессии по IMSI
      * @param imsi IMSI абонента
      * @return true если сессия существует, иначе false
      */
-    [[nodiscard]] bool sessionExists(const std::string& imsi) const override;
+    [[nodiscard]] bool sessionExists(const Imsi& imsi) const override;
 
     /**
      * @brief Получить все IMSI
      * @return Вектор всех IMSI
      */
-    [[nodiscard]] std::vector<std::string> getAllImsis() const override;
+    [[nodiscard]] std::vector<Imsi> getAllImsis() const override;
 
     /**
      * @brief Получить количество сессий
@@ -77,14 +84,72 @@ public:
     /**
      * @brief Получить все истёкшие сессии
      * @param timeoutSeconds Таймаут в секундах
-     * @return Вектор истёкших сессий
+     * @return Вектор истёкших сессий (от самых старых)
      */
     [[nodiscard]] std::vector<Session> getExpiredSessions(uint32_t timeoutSeconds) const override;
 
-    bool refreshSession(const std::string& imsi) override;
+    /**
+     * @brief Удалить истёкшие сессии, начиная с самых старых
+     * @param timeoutSeconds Таймаут в секундах
+     * @param maxCount Максимальное количество сессий, удаляемых за один вызов
+     * @return IMSI удалённых сессий
+     */
+    std::vector<Imsi> removeExpiredSessions(uint32_t timeoutSeconds, size_t maxCount) override;
+
+    bool refreshSession(const Imsi& imsi) override;
+    
+    /**
+     * @brief Атомарно создает сессию или обновляет существующую
+     * @param imsi IMSI абонента
+     * @return CREATED если сессия создана, REFRESHED если обновлена существующая
+     */
+    UpsertResult createOrRefresh(const Imsi& imsi) override;
 
 private:
+    /**
+     * @brief Запись хранилища: сессия и звенья списка в порядке истечения
+     * 
+     * Узлы unordered_map не перемещаются при рехешировании, поэтому
+     * указатели между записями остаются действительными до их удаления.
+     */
+    struct SessionEntry {
+        template<typename... Args>
+        explicit SessionEntry(Args&&... args) : session(std::forward<Args>(args)...) {}
+
+        Session session;                                    // Сессия абонента
+        std::chrono::steady_clock::time_point lastActivity; // Время последней активности (монотонное)
+        SessionEntry* prev = nullptr;                       // Более старая запись
+        SessionEntry* next = nullptr;                       // Более новая запись
+    };
+
+    /**
+     * @brief Отмечает активность записи и добавляет ее в конец списка
+     * 
+     * Время активности берется из steady_clock, поэтому запись всегда самая новая
+     * и вставка выполняется за O(1) даже при переводе системных часов.
+     * @param entry Запись для вставки (не должна находиться в списке)
+     */
+    void linkAsNewest(SessionEntry& entry);
+
+    /**
+     * @brief Исключает запись из списка
+     * @param entry Запись для исключения
+     */
+    void unlink(SessionEntry& entry);
+
+    /**
+     * @brief Проверяет, истекла ли запись к заданному моменту
+     * @param entry Запись для проверки
+     * @param timeout Таймаут неактивности
+     * @param now Текущее время steady_clock
+     * @return true, если запись неактивна дольше таймаута
+     */
+    static bool isExpired(const SessionEntry& entry, std::chrono::seconds timeout,
+                          std::chrono::steady_clock::time_point now);
+
     mutable std::mutex _mutex; // Мьютекс для потокобезопасности
-    std::unordered_map<std::string, Session> _sessions; // Хранилище сессий
+    std::unordered_map<Imsi, SessionEntry> _sessions; // Хранилище сессий
+    SessionEntry* _oldest = nullptr; // Начало списка истечения (самая старая сессия)
+    SessionEntry* _newest = nullptr; // Конец списка истечения (самая новая сессия)
     std::shared_ptr<Logger> _logger; // Логгер (может быть nullptr)
 };
\ No newline at end of file
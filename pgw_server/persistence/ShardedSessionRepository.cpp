@@ -0,0 +1,107 @@
+#include <ShardedSessionRepository.h>
+
+#include <stdexcept>
+#include <utility>
+
+ShardedSessionRepository::ShardedSessionRepository(size_t shardCount, std::shared_ptr<Logger> logger)
+    : _logger(std::move(logger))
+{
+    if (shardCount == 0) throw std::invalid_argument("shardCount must be positive");
+    
+    _shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        _shards.push_back(std::make_unique<InMemorySessionRepository>(_logger));
+    }
+    
+    if (_logger) {
+        _logger->debug("ShardedSessionRepository initialized with " + std::to_string(shardCount) + " shards");
+    }
+}
+
+bool ShardedSessionRepository::addSession(const Session& session) {
+    return shardFor(session.getImsi()).addSession(session);
+}
+
+bool ShardedSessionRepository::removeSession(const Imsi& imsi) {
+    return shardFor(imsi).removeSession(imsi);
+}
+
+bool ShardedSessionRepository::sessionExists(const Imsi& imsi) const {
+    return shardFor(imsi).sessionExists(imsi);
+}
+
+std::vector<Imsi> ShardedSessionRepository::getAllImsis() const {
+    std::vector<Imsi> imsis;
+    
+    for (const auto& shard : _shards) {
+        auto shardImsis = shard->getAllImsis();
+        imsis.insert(imsis.end(),
+                     std::make_move_iterator(shardImsis.begin()),
+                     std::make_move_iterator(shardImsis.end()));
+    }
+    
+    return imsis;
+}
+
+size_t ShardedSessionRepository::getSessionCount() const {
+    size_t count = 0;
+    
+    for (const auto& shard : _shards) {
+        count += shard->getSessionCount();
+    }
+    
+    return count;
+}
+
+void ShardedSessionRepository::clear() {
+    for (const auto& shard : _shards) {
+        shard->clear();
+    }
+}
+
+std::vector<Session> ShardedSessionRepository::getExpiredSessions(uint32_t timeoutSeconds) const {
+    std::vector<Session> expiredSessions;
+    
+    for (const auto& shard : _shards) {
+        auto shardExpired = shard->getExpiredSessions(timeoutSeconds);
+        expiredSessions.insert(expiredSessions.end(),
+                               std::make_move_iterator(shardExpired.begin()),
+                               std::make_move_iterator(shardExpired.end()));
+    }
+    
+    return expiredSessions;
+}
+
+std::vector<Imsi> ShardedSessionRepository::removeExpiredSessions(uint32_t timeoutSeconds, size_t maxCount) {
+    std::vector<Imsi> removedImsis;
+    
+    for (const auto& shard : _shards) {
+        if (removedImsis.size() >= maxCount) {
+            break;
+        }
+        auto shardRemoved = shard->removeExpiredSessions(timeoutSeconds, maxCount - removedImsis.size());
+        removedImsis.insert(removedImsis.end(), shardRemoved.begin(), shardRemoved.end());
+    }
+    
+    return removedImsis;
+}
+
+bool ShardedSessionRepository::refreshSession(const Imsi& imsi) {
+    return shardFor(imsi).refreshSession(imsi);
+}
+
+UpsertResult ShardedSessionRepository::createOrRefresh(const Imsi& imsi) {
+    return shardFor(imsi).createOrRefresh(imsi);
+}
+
+size_t ShardedSessionRepository::getShardCount() const {
+    return _shards.size();
+}
+
+InMemorySessionRepository& ShardedSessionRepository::shardFor(const Imsi& imsi) const {
+    // Перемешиваем хеш (Fibonacci hashing), чтобы номер шарда не коррелировал
+    // с номером бакета unordered_map внутри шарда, который считается от того же хеша
+    uint64_t hash = imsi.hash();
+    hash *= 0x9E3779B97F4A7C15ULL;
+    return *_shards[(hash >> 32) % _shards.size()];
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <ISessionRepository.h>
+#include <InMemorySessionRepository.h>
+#include <Session.h>
+#include <Logger.h>
+#include <string>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Шардированное потокобезопасное in-memory хранилище сессий
+ * 
+ * Разбивает сессии по хешу IMSI на N независимых шардов, каждый со своим мьютексом.
+ * Запросы к разным абонентам (UDP, HTTP /check_subscriber, SessionCleaner)
+ * не конкурируют за одну блокировку.
+ */
+class ShardedSessionRepository : public ISessionRepository {
+public:
+    /**
+     * @brief Создает шардированный репозиторий сессий
+     * @param shardCount Количество шардов
+     * @param logger Указатель на логгер (может быть nullptr)
+     * @throws std::invalid_argument если shardCount равен 0
+     */
+    explicit ShardedSessionRepository(size_t shardCount, std::shared_ptr<Logger> logger = nullptr);
+    
+    ~ShardedSessionRepository() override = default;
+
+    // Запрещаем копирование и перемещение
+    ShardedSessionRepository(const ShardedSessionRepository&) = delete;
+    ShardedSessionRepository& operator=(const ShardedSessionRepository&) = delete;
+    ShardedSessionRepository(ShardedSessionRepository&&) = delete;
+    ShardedSessionRepository& operator=(ShardedSessionRepository&&) = delete;
+
+    /**
+     * @brief Добавить сессию
+     * @param session Сессия для добавления
+     * @return true, если сессия добавлена
+     */
+    bool addSession(const Session& session) override;
+
+    /**
+     * @brief Удалить сессию по IMSI
+     * @param imsi IMSI абонента
+     * @return true, если сессия была удалена
+     */
+    bool removeSession(const Imsi& imsi) override;
+
+    /**
+     * @brief Проверить наличие сессии по IMSI
+     * @param imsi IMSI абонента
+     * @return true если сессия существует, иначе false
+     */
+    [[nodiscard]] bool sessionExists(const Imsi& imsi) const override;
+
+    /**
+     * @brief Получить все IMSI (шарды обходятся по очереди, снимок не атомарен)
+     * @return Вектор всех IMSI
+     */
+    [[nodiscard]] std::vector<Imsi> getAllImsis() const override;
+
+    /**
+     * @brief Получить количество сессий
+     * @return Количество сессий
+     */
+    [[nodiscard]] size_t getSessionCount() const override;
+    
+    /**
+     * @brief Очистить все сессии.
+     */
+    void clear() override;
+
+    /**
+     * @brief Получить все истёкшие сессии
+     * @param timeoutSeconds Таймаут в секундах
+     * @return Вектор истёкших сессий
+     */
+    [[nodiscard]] std::vector<Session> getExpiredSessions(uint32_t timeoutSeconds) const override;
+
+    /**
+     * @brief Удалить истёкшие сессии (шарды обходятся по очереди в пределах общего лимита)
+     * @param timeoutSeconds Таймаут в секундах
+     * @param maxCount Максимальное количество сессий, удаляемых за один вызов
+     * @return IMSI удалённых сессий
+     */
+    std::vector<Imsi> removeExpiredSessions(uint32_t timeoutSeconds, size_t maxCount) override;
+
+    bool refreshSession(const Imsi& imsi) override;
+    
+    /**
+     * @brief Атомарно создает сессию или обновляет существующую
+     * @param imsi IMSI абонента
+     * @return CREATED если сессия создана, REFRESHED если обновлена существующая
+     */
+    UpsertResult createOrRefresh(const Imsi& imsi) override;
+    
+    /**
+     * @brief Возвращает количество шардов
+     * @return Количество шардов
+     */
+    [[nodiscard]] size_t getShardCount() const;
+
+private:
+    /**
+     * @brief Возвращает шард, отвечающий за указанный IMSI
+     * @param imsi IMSI абонента
+     * @return Ссылка на шард
+     */
+    [[nodiscard]] InMemorySessionRepository& shardFor(const Imsi& imsi) const;
+
+    std::vector<std::unique_ptr<InMemorySessionRepository>> _shards; // Шарды со своими мьютексами
+    std::shared_ptr<Logger> _logger; // Логгер (может быть nullptr)
+};
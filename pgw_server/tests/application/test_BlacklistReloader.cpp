@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <fstream>
+#include <cstdio>
+#include "../../application/BlacklistReloader.h"
+#include "../../utils/Logger.h"
+#include "../../domain/Blacklist.h"
+
+class BlacklistReloaderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Создаем логгер для тестов
+        logger = std::make_shared<Logger>("", LogLevel::LOG_DEBUG);
+        
+        // Исходный черный список из файла
+        writeFile({imsi1});
+        blacklist = std::make_shared<Blacklist>(Blacklist::loadFromFile(filePath));
+    }
+
+    void TearDown() override {
+        std::remove(filePath.c_str());
+        std::remove(tempPath.c_str());
+    }
+
+    // Атомарно заменяет файл черного списка (запись во временный файл и rename)
+    void writeFile(const std::vector<std::string>& imsis) {
+        {
+            std::ofstream file(tempPath, std::ios::trunc);
+            for (const auto& imsi : imsis) {
+                file << imsi << "\n";
+            }
+        }
+        ASSERT_EQ(std::rename(tempPath.c_str(), filePath.c_str()), 0);
+    }
+
+    const std::string filePath = "test_reload_blacklist.txt";
+    const std::string tempPath = "test_reload_blacklist.txt.tmp";
+    const std::string imsi1 = "001010000000001";
+    const std::string imsi2 = "001010000000002";
+    std::shared_ptr<Logger> logger;
+    std::shared_ptr<Blacklist> blacklist;
+};
+
+TEST_F(BlacklistReloaderTest, Constructor) {
+    EXPECT_THROW(BlacklistReloader(nullptr, filePath, logger), std::invalid_argument);
+    EXPECT_THROW(BlacklistReloader(blacklist, filePath, nullptr), std::invalid_argument);
+    EXPECT_THROW(BlacklistReloader(blacklist, "", logger), std::invalid_argument);
+    EXPECT_NO_THROW(BlacklistReloader(blacklist, filePath, logger));
+}
+
+TEST_F(BlacklistReloaderTest, ReloadPublishesNewList) {
+    BlacklistReloader reloader(blacklist, filePath, logger, std::chrono::milliseconds(0));
+    EXPECT_TRUE(blacklist->isBlacklisted(imsi1));
+    
+    writeFile({imsi2});
+    EXPECT_EQ(reloader.reload(), 1u);
+    
+    // Тот же объект Blacklist, на который ссылаются потребители, видит новое содержимое
+    EXPECT_FALSE(blacklist->isBlacklisted(imsi1));
+    EXPECT_TRUE(blacklist->isBlacklisted(imsi2));
+}
+
+TEST_F(BlacklistReloaderTest, FailedReloadKeepsPreviousList) {
+    BlacklistReloader reloader(blacklist, filePath, logger, std::chrono::milliseconds(0));
+    
+    writeFile({imsi2, "not_an_imsi"});
+    EXPECT_THROW(reloader.reload(), std::runtime_error);
+    
+    // Прежний список сохраняется
+    EXPECT_TRUE(blacklist->isBlacklisted(imsi1));
+    EXPECT_FALSE(blacklist->isBlacklisted(imsi2));
+}
+
+TEST_F(BlacklistReloaderTest, WatcherReloadsOnFileChange) {
+    BlacklistReloader reloader(blacklist, filePath, logger, std::chrono::milliseconds(20));
+    EXPECT_TRUE(reloader.start());
+    EXPECT_FALSE(reloader.start());
+    
+    writeFile({imsi1, imsi2});
+    
+    // Ждем, пока поток наблюдения заметит замену файла
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!blacklist->isBlacklisted(imsi2) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_TRUE(blacklist->isBlacklisted(imsi1));
+    EXPECT_TRUE(blacklist->isBlacklisted(imsi2));
+    
+    reloader.stop();
+}
+
+TEST_F(BlacklistReloaderTest, WatchDisabled) {
+    // При нулевом периоде поток наблюдения не запускается
+    BlacklistReloader reloader(blacklist, filePath, logger, std::chrono::milliseconds(0));
+    EXPECT_FALSE(reloader.start());
+}
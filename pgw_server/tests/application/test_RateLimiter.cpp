@@ -2,6 +2,7 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <stdexcept>
 #include "../../application/RateLimiter.h"
 #include "../../utils/Logger.h"
 
@@ -148,3 +149,94 @@ TEST_F(RateLimiterTest, LowRateLimit) {
     // Проверяем, что запрос разрешен
     EXPECT_TRUE(limiter.allowRequest(imsi1));
 }
+
+TEST_F(RateLimiterTest, InvalidOptions) {
+    RateLimiterOptions noShards;
+    noShards.shardCount = 0;
+    EXPECT_THROW(RateLimiter(100, logger, noShards), std::invalid_argument);
+    
+    RateLimiterOptions tooFewBuckets;
+    tooFewBuckets.shardCount = 4;
+    tooFewBuckets.maxBuckets = 2;
+    EXPECT_THROW(RateLimiter(100, logger, tooFewBuckets), std::invalid_argument);
+    
+    EXPECT_THROW(RateLimiter(RateLimiter::MAX_REQUESTS_PER_MINUTE + 1, logger), std::invalid_argument);
+    EXPECT_THROW(RateLimiter(1000000000, logger), std::invalid_argument);
+}
+
+TEST_F(RateLimiterTest, MaximumLimitKeepsFullCapacity) {
+    // Емкость при максимальном лимите - 10^7 токенов: переполнение при вычислении
+    // емкости или пополнении схлопнуло бы bucket и отклоняло бы запросы
+    RateLimiter limiter(RateLimiter::MAX_REQUESTS_PER_MINUTE, nullptr);
+    
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_TRUE(limiter.allowRequest(imsi1)) << "request " << i;
+    }
+    
+    // Пополнение после паузы не переполняет счетчик токенов
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    for (int i = 0; i < 100000; ++i) {
+        ASSERT_TRUE(limiter.allowRequest(imsi1)) << "request after refill " << i;
+    }
+}
+
+TEST_F(RateLimiterTest, FractionalBucketCapacity) {
+    // Лимит 15 запросов в минуту дает емкость 1.5 токена: второй запрос отклоняется,
+    // но половина токена сохраняется и ускоряет следующее пополнение
+    RateLimiter limiter(15, logger);
+    
+    EXPECT_TRUE(limiter.allowRequest(imsi1));
+    EXPECT_FALSE(limiter.allowRequest(imsi1));
+    
+    // Пополнение 0.25 токена в секунду: через 2.1 секунды доступно 0.5 + 0.525 токена
+    std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+    EXPECT_TRUE(limiter.allowRequest(imsi1));
+    EXPECT_FALSE(limiter.allowRequest(imsi1));
+}
+
+TEST_F(RateLimiterTest, BucketCountBoundedByMaxBuckets) {
+    RateLimiterOptions options;
+    options.shardCount = 4;
+    options.maxBuckets = 64;
+    RateLimiter limiter(60, nullptr, options);
+    
+    // Поток случайных IMSI не растит таблицу сверх предела
+    for (uint64_t i = 0; i < 10000; ++i) {
+        EXPECT_TRUE(limiter.allowRequest(Imsi::fromValue(100000000000000ULL + i).value()));
+    }
+    EXPECT_LE(limiter.getBucketCount(), options.maxBuckets);
+    EXPECT_GT(limiter.getBucketCount(), 0);
+    
+    // Только что использованный bucket не вытесняется следующим новым IMSI
+    Imsi active(imsi1);
+    for (int i = 0; i < 6; ++i) {
+        EXPECT_TRUE(limiter.allowRequest(active));
+    }
+    EXPECT_TRUE(limiter.allowRequest(Imsi::fromValue(200000000000000ULL).value()));
+    EXPECT_FALSE(limiter.allowRequest(active));
+}
+
+TEST_F(RateLimiterTest, IdleBucketsEvicted) {
+    // При лимите 600 запросов в минуту пустой bucket пополняется полностью за 6 секунд
+    RateLimiter limiter(600, logger);
+    
+    for (int i = 0; i < 60; ++i) {
+        EXPECT_TRUE(limiter.allowRequest(imsi1));
+    }
+    EXPECT_FALSE(limiter.allowRequest(imsi1));
+    EXPECT_TRUE(limiter.allowRequest(imsi2));
+    EXPECT_EQ(limiter.getBucketCount(), 2);
+    
+    // Активные bucket'ы не удаляются, в том числе незадолго до времени полного пополнения
+    EXPECT_EQ(limiter.evictIdleBuckets(), 0);
+    EXPECT_EQ(limiter.evictIdleBuckets(std::chrono::steady_clock::now() + std::chrono::milliseconds(5900)), 0);
+    
+    // Простаивающие bucket'ы удаляются (момент проверки сдвинут вперед вместо ожидания),
+    // а поведение совпадает с полным bucket'ом
+    EXPECT_EQ(limiter.evictIdleBuckets(std::chrono::steady_clock::now() + std::chrono::milliseconds(6100)), 2);
+    EXPECT_EQ(limiter.getBucketCount(), 0);
+    for (int i = 0; i < 60; ++i) {
+        EXPECT_TRUE(limiter.allowRequest(imsi1));
+    }
+    EXPECT_FALSE(limiter.allowRequest(imsi1));
+}
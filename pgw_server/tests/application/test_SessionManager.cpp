@@ -111,7 +111,7 @@ TEST_F(SessionManagerTest, CreateSessionWithBlacklistedImsi) {
     SessionResult result = sessionManager->createSession(blacklistedImsi);
     
     // Проверяем, что сессия отклонена
-    EXPECT_EQ(result, SessionResult::REJECTED);
+    EXPECT_EQ(result, SessionResult::REJECTED_BLACKLIST);
     EXPECT_FALSE(sessionManager->isSessionActive(blacklistedImsi));
     EXPECT_EQ(sessionManager->getActiveSessionsCount(), 0);
 }
@@ -123,9 +123,9 @@ TEST_F(SessionManagerTest, CreateDuplicateSession) {
     // Пытаемся создать сессию с тем же IMSI
     SessionResult result2 = sessionManager->createSession(validImsi);
     
-    // Проверяем, что обе операции успешны (вторая считается успешной, т.к. сессия уже существует)
+    // Проверяем, что обе операции успешны (вторая продлевает уже существующую сессию)
     EXPECT_EQ(result1, SessionResult::CREATED);
-    EXPECT_EQ(result2, SessionResult::CREATED);
+    EXPECT_EQ(result2, SessionResult::REFRESHED);
     EXPECT_TRUE(sessionManager->isSessionActive(validImsi));
     EXPECT_EQ(sessionManager->getActiveSessionsCount(), 1);
 }
@@ -266,5 +266,5 @@ TEST_F(SessionManagerTest, RateLimiting) {
     SessionResult result2 = limitedSessionManager->createSession(validImsi);
     
     // Проверяем, что вторая сессия отклонена из-за ограничения скорости
-    EXPECT_EQ(result2, SessionResult::REJECTED);
+    EXPECT_EQ(result2, SessionResult::REJECTED_RATE_LIMIT);
 }
@@ -35,15 +35,28 @@ protected:
         file << R"({
             "udp_ip": "192.168.1.1",
             "udp_port": 9999,
+            "udp_workers": 4,
+            "udp_batch_size": 64,
+            "udp_edge_triggered": true,
+            "udp_admission_global_pps": 200000,
+            "udp_admission_source_pps": 5000,
+            "udp_response_mode": "binary",
             "session_timeout_sec": 60,
             "cleanup_interval_sec": 10,
             "cdr_file": "test_cdr.log",
+            "cdr_async": true,
+            "cdr_flush_interval_ms": 250,
             "http_port": 8888,
+            "metrics_port": 9555,
             "http_ip": "192.168.1.2",
             "graceful_shutdown_rate": 20,
             "max_requests_per_minute": 1000,
             "log_file": "test_log.log",
             "log_level": "DEBUG",
+            "log_async": true,
+            "log_overflow_policy": "drop_new",
+            "blacklist_file": "operator_blacklist.bin",
+            "blacklist_watch_interval_ms": 500,
             "blacklist": ["111111111111111", "222222222222222"]
         })";
         
@@ -129,10 +142,18 @@ TEST_F(JsonConfigAdapterTest, GetConfig) {
     // Проверяем значения конфигурации
     EXPECT_EQ(config.udp_ip, "192.168.1.1");
     EXPECT_EQ(config.udp_port, 9999);
+    EXPECT_EQ(config.udp_workers, 4);
+    EXPECT_EQ(config.udp_batch_size, 64);
+    EXPECT_TRUE(config.udp_edge_triggered);
+    EXPECT_EQ(config.udp_admission_global_pps, 200000);
+    EXPECT_EQ(config.udp_admission_source_pps, 5000);
+    EXPECT_EQ(config.udp_admission_source_slots, 65536);
+    EXPECT_EQ(config.udp_response_mode, "binary");
     EXPECT_EQ(config.session_timeout_sec, 60);
     EXPECT_EQ(config.cleanup_interval_sec, 10);
     EXPECT_EQ(config.cdr_file, "test_cdr.log");
     EXPECT_EQ(config.http_port, 8888);
+    EXPECT_EQ(config.metrics_port, 9555);
     EXPECT_EQ(config.graceful_shutdown_rate, 20);
     EXPECT_EQ(config.max_requests_per_minute, 1000);
     EXPECT_EQ(config.log_file, "test_log.log");
@@ -140,6 +161,8 @@ TEST_F(JsonConfigAdapterTest, GetConfig) {
     EXPECT_EQ(config.blacklist.size(), 2);
     EXPECT_EQ(config.blacklist[0], "111111111111111");
     EXPECT_EQ(config.blacklist[1], "222222222222222");
+    EXPECT_EQ(config.blacklist_file, "operator_blacklist.bin");
+    EXPECT_EQ(config.blacklist_watch_interval_ms, 500);
 }
 
 TEST_F(JsonConfigAdapterTest, GetString) {
@@ -152,6 +175,8 @@ TEST_F(JsonConfigAdapterTest, GetString) {
     // Проверяем получение строковых значений
     EXPECT_EQ(adapter.getString("udp_ip"), "192.168.1.1");
     EXPECT_EQ(adapter.getString("log_file"), "test_log.log");
+    EXPECT_EQ(adapter.getString("log_overflow_policy"), "drop_new");
+    EXPECT_EQ(adapter.getString("udp_response_mode"), "binary");
     EXPECT_EQ(adapter.getString("non_existent_key", "default"), "default");
 }
 
@@ -164,10 +189,31 @@ TEST_F(JsonConfigAdapterTest, GetUint) {
     
     // Проверяем получение целочисленных значений
     EXPECT_EQ(adapter.getUint("udp_port"), 9999);
+    EXPECT_EQ(adapter.getUint("udp_workers"), 4);
+    EXPECT_EQ(adapter.getUint("metrics_port"), 9555);
     EXPECT_EQ(adapter.getUint("session_timeout_sec"), 60);
+    EXPECT_EQ(adapter.getUint("cdr_flush_interval_ms"), 250);
+    EXPECT_EQ(adapter.getUint("cdr_queue_size"), 65536);
+    EXPECT_EQ(adapter.getUint("log_queue_size"), 8192);
+    EXPECT_EQ(adapter.getUint("udp_admission_source_pps"), 5000);
     EXPECT_EQ(adapter.getUint("non_existent_key", 42), 42);
 }
 
+TEST_F(JsonConfigAdapterTest, GetBool) {
+    // Создаем адаптер
+    JsonConfigAdapter adapter(tempConfigFile);
+    
+    // Загружаем конфигурацию
+    adapter.load();
+    
+    // Проверяем получение логических значений
+    EXPECT_TRUE(adapter.getBool("udp_edge_triggered"));
+    EXPECT_TRUE(adapter.getBool("cdr_async"));
+    EXPECT_TRUE(adapter.getBool("log_async"));
+    EXPECT_TRUE(adapter.getBool("non_existent_key", true));
+    EXPECT_FALSE(adapter.getBool("non_existent_key"));
+}
+
 TEST_F(JsonConfigAdapterTest, GetStringArray) {
     // Создаем адаптер
     JsonConfigAdapter adapter(tempConfigFile);
@@ -185,3 +231,15 @@ TEST_F(JsonConfigAdapterTest, GetStringArray) {
     auto emptyArray = adapter.getStringArray("non_existent_key");
     EXPECT_TRUE(emptyArray.empty());
 }
+
+TEST_F(JsonConfigAdapterTest, LoadRejectsZeroMetricsPort) {
+    std::ofstream file(tempConfigFile);
+    ASSERT_TRUE(file.is_open());
+    file << R"({"metrics_port": 0})";
+    file.close();
+    
+    JsonConfigAdapter adapter(tempConfigFile);
+    EXPECT_FALSE(adapter.load());
+    EXPECT_FALSE(adapter.isValid());
+    EXPECT_EQ(adapter.getLastError(), "Invalid metrics port: 0");
+}
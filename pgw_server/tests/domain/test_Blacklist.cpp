@@ -2,6 +2,10 @@
 #include "../../domain/Blacklist.h"
 #include <vector>
 #include <string>
+#include <fstream>
+#include <cstdio>
+#include <atomic>
+#include <thread>
 
 class BlacklistTest : public ::testing::Test {
 protected:
@@ -136,3 +140,175 @@ TEST_F(BlacklistTest, MoveAssignment) {
     EXPECT_TRUE(moved.isBlacklisted(imsi2));
     EXPECT_FALSE(moved.isBlacklisted(imsi3));
 }
+
+TEST_F(BlacklistTest, LoadFromTextFile) {
+    const std::string path = "test_blacklist.txt";
+    {
+        std::ofstream file(path);
+        file << "# Черный список оператора\n"
+             << imsi1 << "\n"
+             << "\n"
+             << "  " << imsi2 << " \r\n"
+             << imsi1 << "\n";
+    }
+    
+    Blacklist blacklist = Blacklist::loadFromFile(path);
+    
+    // Комментарии и пустые строки пропускаются, дубликаты схлопываются
+    EXPECT_EQ(blacklist.size(), 2u);
+    EXPECT_TRUE(blacklist.isBlacklisted(imsi1));
+    EXPECT_TRUE(blacklist.isBlacklisted(imsi2));
+    EXPECT_FALSE(blacklist.isBlacklisted(imsi3));
+    
+    // Строка неверного формата в файле - ошибка загрузки
+    {
+        std::ofstream file(path);
+        file << imsi1 << "\n" << "12345\n";
+    }
+    EXPECT_THROW(Blacklist::loadFromFile(path), std::runtime_error);
+    EXPECT_THROW(Blacklist::loadFromFile("non_existent_blacklist.txt"), std::runtime_error);
+    
+    std::remove(path.c_str());
+}
+
+TEST_F(BlacklistTest, BinaryFileRoundTrip) {
+    const std::string path = "test_blacklist.bin";
+    Blacklist original(testImsis);
+    original.saveBinaryFile(path);
+    
+    // Бинарный файл распознается по сигнатуре и читается целиком
+    Blacklist loaded = Blacklist::loadFromFile(path);
+    EXPECT_EQ(loaded.size(), 2u);
+    EXPECT_TRUE(loaded.isBlacklisted(imsi1));
+    EXPECT_TRUE(loaded.isBlacklisted(imsi2));
+    EXPECT_FALSE(loaded.isBlacklisted(imsi3));
+    
+    // Копия разделяет снимок и остается рабочей после уничтожения оригинала
+    Blacklist copy;
+    {
+        Blacklist temporary = Blacklist::loadFromFile(path);
+        copy = temporary;
+    }
+    EXPECT_TRUE(copy.isBlacklisted(imsi2));
+    
+    // Пустой список также сохраняется и загружается
+    Blacklist().saveBinaryFile(path);
+    EXPECT_EQ(Blacklist::loadFromFile(path).size(), 0u);
+    
+    std::remove(path.c_str());
+}
+
+TEST_F(BlacklistTest, BinaryFileRewrittenInPlaceWhileLoaded) {
+    const std::string path = "test_blacklist_in_place.bin";
+    std::vector<std::string> imsis;
+    for (uint64_t i = 0; i < 10000; ++i) {
+        imsis.push_back(Imsi::fromValue(250010000000000ULL + i * 7)->toString());
+    }
+    Blacklist(imsis).saveBinaryFile(path);
+    Blacklist loaded = Blacklist::loadFromFile(path);
+    
+    // Усечение и перезапись файла на месте не затрагивают загруженный снимок
+    // (при отображении файла в память чтение усеченных страниц завершилось бы SIGBUS)
+    std::ofstream(path, std::ios::binary | std::ios::trunc).close();
+    for (const auto& imsi : imsis) {
+        ASSERT_TRUE(loaded.isBlacklisted(imsi));
+    }
+    
+    std::ofstream(path, std::ios::trunc) << imsi3 << "\n";
+    EXPECT_TRUE(loaded.isBlacklisted(imsis.back()));
+    EXPECT_FALSE(loaded.isBlacklisted(imsi3));
+    EXPECT_EQ(loaded.size(), imsis.size());
+    
+    // saveBinaryFile заменяет файл через rename и не оставляет временного файла
+    Blacklist(testImsis).saveBinaryFile(path);
+    EXPECT_EQ(Blacklist::loadFromFile(path).size(), 2u);
+    EXPECT_FALSE(std::ifstream(path + ".tmp").is_open());
+    EXPECT_EQ(loaded.size(), imsis.size());
+    
+    std::remove(path.c_str());
+}
+
+TEST_F(BlacklistTest, LoadCorruptedBinaryFile) {
+    const std::string path = "test_blacklist_corrupted.bin";
+    
+    auto writeFile = [&path](uint64_t count, const std::vector<uint64_t>& values) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(Blacklist::BINARY_MAGIC, sizeof(Blacklist::BINARY_MAGIC));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.write(reinterpret_cast<const char*>(values.data()),
+                   static_cast<std::streamsize>(values.size() * sizeof(uint64_t)));
+    };
+    
+    // Количество записей не совпадает с размером файла
+    writeFile(3, {1, 2});
+    EXPECT_THROW(Blacklist::loadFromFile(path), std::runtime_error);
+    
+    // Записи не отсортированы
+    writeFile(2, {2, 1});
+    EXPECT_THROW(Blacklist::loadFromFile(path), std::runtime_error);
+    
+    // Значение вне диапазона IMSI
+    writeFile(1, {Imsi::MAX_VALUE + 1});
+    EXPECT_THROW(Blacklist::loadFromFile(path), std::runtime_error);
+    
+    std::remove(path.c_str());
+}
+
+TEST_F(BlacklistTest, LargeBlacklistLookups) {
+    // Большой список: все записи находятся, соседние значения вне списка - нет
+    const uint64_t base = 250010000000000ULL;
+    const size_t count = 100000;
+    std::vector<std::string> imsis;
+    imsis.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        imsis.push_back(Imsi::fromValue(base + i * 2)->toString());
+    }
+    
+    Blacklist blacklist(imsis);
+    EXPECT_EQ(blacklist.size(), count);
+    EXPECT_LT(blacklist.memoryUsage(), count * 10);
+    
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_TRUE(blacklist.isBlacklisted(*Imsi::fromValue(base + i * 2))) << i;
+        ASSERT_FALSE(blacklist.isBlacklisted(*Imsi::fromValue(base + i * 2 + 1))) << i;
+    }
+    EXPECT_FALSE(blacklist.isBlacklisted(*Imsi::fromValue(0)));
+    EXPECT_FALSE(blacklist.isBlacklisted(*Imsi::fromValue(Imsi::MAX_VALUE)));
+}
+
+TEST_F(BlacklistTest, ReplaceWhileReading) {
+    // Потоки проверяют IMSI, пока другой поток многократно публикует новые снимки:
+    // каждая проверка видит один из двух списков целиком
+    Blacklist blacklist(std::vector<std::string>{imsi1});
+    const Blacklist first(std::vector<std::string>{imsi1});
+    const Blacklist second(std::vector<std::string>{imsi2, imsi3});
+    
+    std::atomic<bool> running{true};
+    std::atomic<size_t> checks{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]() {
+            while (running.load(std::memory_order_relaxed)) {
+                size_t size = blacklist.size();
+                EXPECT_TRUE(size == 1 || size == 2);
+                EXPECT_FALSE(blacklist.isBlacklisted("999999999999999"));
+                checks.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    
+    // Дожидаемся запуска читателей, чтобы публикации шли параллельно с проверками
+    while (checks.load() == 0) {
+        std::this_thread::yield();
+    }
+    for (int i = 0; i < 1000; ++i) {
+        blacklist.replace(i % 2 ? first : second);
+    }
+    running = false;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    
+    EXPECT_TRUE(blacklist.isBlacklisted(imsi1));
+    EXPECT_FALSE(blacklist.isBlacklisted(imsi2));
+}
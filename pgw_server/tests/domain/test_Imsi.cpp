@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+#include "../../domain/Imsi.h"
+
+class ImsiTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        validImsi = "123456789012345";   // 15 цифр
+        leadingZeroImsi = "001010000000001"; // IMSI с ведущими нулями
+    }
+
+    std::string validImsi;
+    std::string leadingZeroImsi;
+};
+
+TEST_F(ImsiTest, ParseValidImsi) {
+    auto imsi = Imsi::parse(validImsi);
+    
+    ASSERT_TRUE(imsi.has_value());
+    EXPECT_EQ(imsi->value(), 123456789012345ULL);
+    EXPECT_EQ(imsi->toString(), validImsi);
+}
+
+TEST_F(ImsiTest, ParseInvalidImsi) {
+    // Неверная длина
+    EXPECT_FALSE(Imsi::parse("12345").has_value());
+    EXPECT_FALSE(Imsi::parse("1234567890123456").has_value());
+    EXPECT_FALSE(Imsi::parse("").has_value());
+    
+    // Нецифровые символы
+    EXPECT_FALSE(Imsi::parse("12345678901234a").has_value());
+    EXPECT_FALSE(Imsi::parse(" 23456789012345").has_value());
+}
+
+TEST_F(ImsiTest, ConstructorWithInvalidImsi) {
+    // Проверка, что конструктор выбрасывает исключение с некорректным IMSI
+    EXPECT_THROW(Imsi imsi("12345"), std::invalid_argument);
+    EXPECT_THROW(Imsi imsi(std::string("abcdefghijklmno")), std::invalid_argument);
+}
+
+TEST_F(ImsiTest, LeadingZerosPreserved) {
+    Imsi imsi(leadingZeroImsi);
+    
+    // Ведущие нули не хранятся в значении, но восстанавливаются в строке
+    EXPECT_EQ(imsi.value(), 1010000000001ULL);
+    EXPECT_EQ(imsi.toString(), leadingZeroImsi);
+    EXPECT_EQ(Imsi("000000000000000").toString(), "000000000000000");
+}
+
+TEST_F(ImsiTest, FromValue) {
+    auto imsi = Imsi::fromValue(Imsi::MAX_VALUE);
+    ASSERT_TRUE(imsi.has_value());
+    EXPECT_EQ(imsi->toString(), "999999999999999");
+    
+    // Значение длиннее 15 цифр отклоняется
+    EXPECT_FALSE(Imsi::fromValue(Imsi::MAX_VALUE + 1).has_value());
+}
+
+TEST_F(ImsiTest, ComparisonAndHash) {
+    Imsi a(validImsi);
+    Imsi b(validImsi);
+    Imsi c(leadingZeroImsi);
+    
+    EXPECT_EQ(a, b);
+    EXPECT_NE(a, c);
+    EXPECT_LT(c, a);
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_EQ(std::hash<Imsi>{}(a), a.hash());
+    
+    // Сравнение со строкой через неявное преобразование
+    EXPECT_EQ(a, validImsi);
+}
+
+TEST_F(ImsiTest, HashDistinguishesAdjacentImsis) {
+    // Соседние IMSI должны давать разные хеши
+    std::unordered_set<size_t> hashes;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        hashes.insert(Imsi::fromValue(100000000000000ULL + i)->hash());
+    }
+    EXPECT_EQ(hashes.size(), 1000);
+}
+
+TEST_F(ImsiTest, StreamOutput) {
+    std::ostringstream os;
+    os << Imsi(leadingZeroImsi);
+    EXPECT_EQ(os.str(), leadingZeroImsi);
+}
@@ -206,3 +206,38 @@ TEST_F(HttpServerTest, RootEndpoint) {
     // Останавливаем сервер
     httpServer->stop();
 }
+
+TEST_F(HttpServerTest, ReloadBlacklistEndpoint) {
+    // Без обработчика перезагрузки маршрут сообщает, что перезагрузка не настроена
+    EXPECT_TRUE(httpServer->start());
+    httplib::Client client("127.0.0.1", httpServer->getPort());
+    auto response = client.Get("/reload_blacklist");
+    ASSERT_TRUE(response != nullptr);
+    EXPECT_EQ(response->status, 501);
+    httpServer->stop();
+    
+    // С обработчиком возвращается количество загруженных IMSI или ошибка
+    bool fail = false;
+    HttpServer reloadServer("127.0.0.1", 8083, sessionManager, shutdownManager, logger, nullptr,
+                            [&fail]() -> size_t {
+                                if (fail) {
+                                    throw std::runtime_error("broken file");
+                                }
+                                return 42;
+                            });
+    EXPECT_TRUE(reloadServer.start());
+    httplib::Client reloadClient("127.0.0.1", reloadServer.getPort());
+    
+    response = reloadClient.Get("/reload_blacklist");
+    ASSERT_TRUE(response != nullptr);
+    EXPECT_EQ(response->status, 200);
+    EXPECT_EQ(response->body, "Blacklist reloaded: 42 items");
+    
+    fail = true;
+    response = reloadClient.Get("/reload_blacklist");
+    ASSERT_TRUE(response != nullptr);
+    EXPECT_EQ(response->status, 500);
+    EXPECT_EQ(response->body, "Blacklist reload failed: broken file");
+    
+    reloadServer.stop();
+}
@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include "../../persistence/AsyncFileCdrRepository.h"
+#include "../../utils/Logger.h"
+
+class AsyncFileCdrRepositoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Создаем временный файл для тестирования
+        tempCdrFile = "test_async_cdr_file.log";
+        
+        // Удаляем файл, если он существует
+        if (std::filesystem::exists(tempCdrFile)) {
+            std::filesystem::remove(tempCdrFile);
+        }
+        
+        // Создаем логгер для тестов
+        logger = std::make_shared<Logger>("", LogLevel::LOG_DEBUG);
+    }
+
+    void TearDown() override {
+        // Удаляем временный файл после тестов
+        if (std::filesystem::exists(tempCdrFile)) {
+            std::filesystem::remove(tempCdrFile);
+        }
+    }
+
+    // Вспомогательный метод для чтения строк файла CDR
+    std::vector<std::string> readLines() {
+        std::vector<std::string> lines;
+        std::ifstream file(tempCdrFile);
+        std::string line;
+        while (std::getline(file, line)) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+
+    std::string tempCdrFile;
+    std::shared_ptr<Logger> logger;
+};
+
+TEST_F(AsyncFileCdrRepositoryTest, ConstructorWithInvalidOptions) {
+    AsyncCdrOptions options;
+    options.flushBytes = 0;
+    EXPECT_THROW(AsyncFileCdrRepository(tempCdrFile, options), std::invalid_argument);
+    
+    options = AsyncCdrOptions{};
+    options.flushInterval = std::chrono::milliseconds(0);
+    EXPECT_THROW(AsyncFileCdrRepository(tempCdrFile, options), std::invalid_argument);
+    
+    options = AsyncCdrOptions{};
+    options.queueCapacity = 0;
+    EXPECT_THROW(AsyncFileCdrRepository(tempCdrFile, options), std::invalid_argument);
+}
+
+TEST_F(AsyncFileCdrRepositoryTest, WriteAndFlush) {
+    // Большой интервал: данные попадают в файл только благодаря flush
+    AsyncCdrOptions options;
+    options.flushInterval = std::chrono::seconds(60);
+    AsyncFileCdrRepository repo(tempCdrFile, options, logger);
+    
+    EXPECT_TRUE(repo.writeCdr("123456789012345", "create"));
+    EXPECT_TRUE(repo.writeCdr("234567890123456", "timeout", "2024-01-01 12:00:00"));
+    
+    repo.flush();
+    
+    auto lines = readLines();
+    ASSERT_EQ(lines.size(), 2);
+    
+    // Формат строки совпадает с FileCdrRepository: timestamp,IMSI,action
+    EXPECT_EQ(lines[0].size(), std::string("YYYY-MM-DD HH:MM:SS,123456789012345,create").size());
+    EXPECT_NE(lines[0].find(",123456789012345,create"), std::string::npos);
+    EXPECT_EQ(lines[1], "2024-01-01 12:00:00,234567890123456,timeout");
+}
+
+TEST_F(AsyncFileCdrRepositoryTest, FlushByInterval) {
+    AsyncCdrOptions options;
+    options.flushInterval = std::chrono::milliseconds(20);
+    AsyncFileCdrRepository repo(tempCdrFile, options, logger);
+    
+    EXPECT_TRUE(repo.writeCdr("123456789012345", "create"));
+    
+    // Запись должна появиться в файле без явного flush
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_EQ(readLines().size(), 1);
+}
+
+TEST_F(AsyncFileCdrRepositoryTest, DestructorDrainsQueue) {
+    {
+        AsyncCdrOptions options;
+        options.flushInterval = std::chrono::seconds(60);
+        AsyncFileCdrRepository repo(tempCdrFile, options, logger);
+        
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_TRUE(repo.writeCdr("123456789012345", "create", "2024-01-01 12:00:00"));
+        }
+    }
+    
+    // После уничтожения все принятые записи должны быть в файле
+    EXPECT_EQ(readLines().size(), 100);
+}
+
+TEST_F(AsyncFileCdrRepositoryTest, ConcurrentWritersWithDrops) {
+    // Крошечная очередь без ожидания: часть записей отбрасывается,
+    // но каждая принятая запись должна попасть в файл
+    AsyncCdrOptions options;
+    options.queueCapacity = 2;
+    options.maxEnqueueWait = std::chrono::microseconds(0);
+    AsyncFileCdrRepository repo(tempCdrFile, options);
+    
+    const int threadCount = 4;
+    const int recordsPerThread = 2000;
+    std::atomic<int> accepted{0};
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&repo, &accepted]() {
+            for (int i = 0; i < recordsPerThread; ++i) {
+                if (repo.writeCdr("123456789012345", "create", "2024-01-01 12:00:00")) {
+                    accepted++;
+                }
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    repo.flush();
+    
+    EXPECT_EQ(readLines().size(), static_cast<size_t>(accepted.load()));
+    EXPECT_EQ(repo.getDroppedCount() + static_cast<uint64_t>(accepted.load()),
+              static_cast<uint64_t>(threadCount * recordsPerThread));
+    EXPECT_EQ(repo.getDroppedCount() > 0, repo.getBackpressureCount() > 0);
+}
+
+TEST_F(AsyncFileCdrRepositoryTest, BackpressureWakesWriter) {
+    // Маленькая очередь и долгий интервал сброса: заполнение очереди должно будить
+    // поток записи сразу, иначе производители не дождутся места и начнут терять записи
+    AsyncCdrOptions options;
+    options.queueCapacity = 4;
+    options.flushInterval = std::chrono::seconds(60);
+    options.maxEnqueueWait = std::chrono::milliseconds(500);
+    AsyncFileCdrRepository repo(tempCdrFile, options);
+    
+    const int threadCount = 4;
+    const int recordsPerThread = 2000;
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&repo]() {
+            for (int i = 0; i < recordsPerThread; ++i) {
+                repo.writeCdr("123456789012345", "create", "2024-01-01 12:00:00");
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    repo.flush();
+    
+    EXPECT_EQ(repo.getDroppedCount(), 0);
+    EXPECT_EQ(readLines().size(), static_cast<size_t>(threadCount * recordsPerThread));
+}
+
+TEST_F(AsyncFileCdrRepositoryTest, WriteToInvalidPath) {
+    // Создаем репозиторий с некорректным путем
+    AsyncFileCdrRepository repo("/invalid/path/to/file.log", AsyncCdrOptions{}, logger);
+    
+    // Проверяем, что запись не принимается
+    EXPECT_FALSE(repo.writeCdr("123456789012345", "create"));
+}
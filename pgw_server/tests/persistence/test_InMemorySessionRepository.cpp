@@ -2,6 +2,8 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <atomic>
+#include <vector>
 #include "../../persistence/InMemorySessionRepository.h"
 #include "../../domain/Session.h"
 #include "../../utils/Logger.h"
@@ -194,3 +196,110 @@ TEST_F(InMemorySessionRepositoryTest, GetExpiredSessions) {
     expiredSessions = repository->getExpiredSessions(10);
     EXPECT_EQ(expiredSessions.size(), 0);
 }
+
+TEST_F(InMemorySessionRepositoryTest, ExpiryOrderIgnoresNonMonotonicWallTime) {
+    // Сессия с более ранним системным временем добавляется последней,
+    // как после перевода часов назад
+    Session olderSession(imsi2);
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    
+    repository->addSession(Session(imsi1));
+    repository->addSession(olderSession);
+    
+    // Таймаут отсчитывается от момента добавления в репозиторий, а не от системного времени
+    EXPECT_TRUE(repository->getExpiredSessions(1).empty());
+    EXPECT_TRUE(repository->removeExpiredSessions(1, 10).empty());
+    
+    // Порядок истечения совпадает с порядком активности
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    EXPECT_EQ(repository->createOrRefresh(imsi1), UpsertResult::REFRESHED);
+    
+    auto removedImsis = repository->removeExpiredSessions(1, 10);
+    ASSERT_EQ(removedImsis.size(), 1);
+    EXPECT_EQ(removedImsis[0], imsi2);
+    EXPECT_TRUE(repository->sessionExists(imsi1));
+}
+
+TEST_F(InMemorySessionRepositoryTest, RemoveExpiredSessions) {
+    repository->addSession(Session(imsi1));
+    repository->addSession(Session(imsi2));
+    
+    // Ждем 2 секунды и обновляем первую сессию
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    EXPECT_TRUE(repository->refreshSession(imsi1));
+    
+    // Удаляется только необновленная сессия
+    auto removedImsis = repository->removeExpiredSessions(1, 10);
+    ASSERT_EQ(removedImsis.size(), 1);
+    EXPECT_EQ(removedImsis[0], imsi2);
+    EXPECT_TRUE(repository->sessionExists(imsi1));
+    EXPECT_FALSE(repository->sessionExists(imsi2));
+    EXPECT_EQ(repository->getSessionCount(), 1);
+}
+
+TEST_F(InMemorySessionRepositoryTest, RemoveExpiredSessionsRespectsMaxCount) {
+    repository->addSession(Session(imsi1));
+    repository->addSession(Session(imsi2));
+    repository->addSession(Session("345678901234567"));
+    
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    
+    // За один вызов удаляется не больше maxCount самых старых сессий
+    auto removedImsis = repository->removeExpiredSessions(1, 2);
+    ASSERT_EQ(removedImsis.size(), 2);
+    EXPECT_EQ(removedImsis[0], imsi1);
+    EXPECT_EQ(removedImsis[1], imsi2);
+    EXPECT_EQ(repository->getSessionCount(), 1);
+    
+    // Следующий вызов удаляет оставшуюся
+    EXPECT_EQ(repository->removeExpiredSessions(1, 2).size(), 1);
+    EXPECT_EQ(repository->getSessionCount(), 0);
+    
+    // Репозиторий остается работоспособным после удаления всех записей
+    EXPECT_EQ(repository->createOrRefresh(imsi1), UpsertResult::CREATED);
+    EXPECT_TRUE(repository->removeSession(imsi1));
+    EXPECT_TRUE(repository->removeExpiredSessions(0, 10).empty());
+}
+
+TEST_F(InMemorySessionRepositoryTest, CreateOrRefresh) {
+    // Первый вызов создает сессию
+    EXPECT_EQ(repository->createOrRefresh(imsi1), UpsertResult::CREATED);
+    EXPECT_TRUE(repository->sessionExists(imsi1));
+    EXPECT_EQ(repository->getSessionCount(), 1);
+    
+    // Ждем 2 секунды, чтобы сессия успела истечь с таймаутом 1 секунда
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    
+    // Повторный вызов обновляет существующую сессию
+    EXPECT_EQ(repository->createOrRefresh(imsi1), UpsertResult::REFRESHED);
+    EXPECT_EQ(repository->getSessionCount(), 1);
+    
+    // Проверяем, что время сессии обновлено
+    EXPECT_TRUE(repository->getExpiredSessions(1).empty());
+}
+
+TEST_F(InMemorySessionRepositoryTest, CreateOrRefreshConcurrent) {
+    // Репозиторий без логгера, чтобы потоки конкурировали только за мьютекс
+    InMemorySessionRepository repo;
+    const int threadCount = 8;
+    std::atomic<int> createdCount{0};
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&repo, &createdCount, this]() {
+            for (int i = 0; i < 100; ++i) {
+                if (repo.createOrRefresh(imsi1) == UpsertResult::CREATED) {
+                    createdCount++;
+                }
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    // Сессия создана ровно один раз, остальные вызовы ее обновили
+    EXPECT_EQ(createdCount.load(), 1);
+    EXPECT_EQ(repo.getSessionCount(), 1);
+}
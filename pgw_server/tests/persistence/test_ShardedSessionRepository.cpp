@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+#include "../../persistence/ShardedSessionRepository.h"
+#include "../../domain/Session.h"
+#include "../../utils/Logger.h"
+
+class ShardedSessionRepositoryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Создаем тестовые IMSI
+        for (int i = 0; i < 100; ++i) {
+            std::string suffix = std::to_string(i);
+            imsis.push_back("00101" + std::string(10 - suffix.size(), '0') + suffix);
+        }
+        
+        // Создаем логгер для тестов
+        logger = std::make_shared<Logger>("", LogLevel::LOG_DEBUG);
+        
+        // Создаем репозиторий
+        repository = std::make_unique<ShardedSessionRepository>(8, logger);
+    }
+
+    void TearDown() override {
+        // Очищаем репозиторий после каждого теста
+        repository->clear();
+    }
+
+    std::vector<std::string> imsis;
+    std::shared_ptr<Logger> logger;
+    std::unique_ptr<ShardedSessionRepository> repository;
+};
+
+TEST_F(ShardedSessionRepositoryTest, ConstructorWithZeroShards) {
+    // Проверяем, что нулевое количество шардов отклоняется
+    EXPECT_THROW(ShardedSessionRepository repo(0), std::invalid_argument);
+}
+
+TEST_F(ShardedSessionRepositoryTest, GetShardCount) {
+    EXPECT_EQ(repository->getShardCount(), 8);
+}
+
+TEST_F(ShardedSessionRepositoryTest, AddAndRemoveSessions) {
+    // Добавляем сессии, которые распределятся по разным шардам
+    for (const auto& imsi : imsis) {
+        EXPECT_TRUE(repository->addSession(Session(imsi)));
+    }
+    EXPECT_EQ(repository->getSessionCount(), imsis.size());
+    
+    // Повторное добавление отклоняется шардом, которому принадлежит IMSI
+    EXPECT_FALSE(repository->addSession(Session(imsis[0])));
+    
+    for (const auto& imsi : imsis) {
+        EXPECT_TRUE(repository->sessionExists(imsi));
+        EXPECT_TRUE(repository->removeSession(imsi));
+        EXPECT_FALSE(repository->sessionExists(imsi));
+    }
+    EXPECT_EQ(repository->getSessionCount(), 0);
+}
+
+TEST_F(ShardedSessionRepositoryTest, RefreshSession) {
+    // Обновление несуществующей сессии возвращает false
+    EXPECT_FALSE(repository->refreshSession(imsis[0]));
+    
+    repository->addSession(Session(imsis[0]));
+    EXPECT_TRUE(repository->refreshSession(imsis[0]));
+}
+
+TEST_F(ShardedSessionRepositoryTest, CreateOrRefresh) {
+    for (const auto& imsi : imsis) {
+        EXPECT_EQ(repository->createOrRefresh(imsi), UpsertResult::CREATED);
+    }
+    for (const auto& imsi : imsis) {
+        EXPECT_EQ(repository->createOrRefresh(imsi), UpsertResult::REFRESHED);
+    }
+    EXPECT_EQ(repository->getSessionCount(), imsis.size());
+}
+
+TEST_F(ShardedSessionRepositoryTest, GetAllImsisFromAllShards) {
+    for (const auto& imsi : imsis) {
+        repository->addSession(Session(imsi));
+    }
+    
+    // Собираем IMSI со всех шардов и сравниваем без учета порядка
+    auto allImsis = repository->getAllImsis();
+    std::sort(allImsis.begin(), allImsis.end());
+    
+    std::vector<Imsi> expected(imsis.begin(), imsis.end());
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(allImsis, expected);
+}
+
+TEST_F(ShardedSessionRepositoryTest, Clear) {
+    for (const auto& imsi : imsis) {
+        repository->addSession(Session(imsi));
+    }
+    
+    repository->clear();
+    
+    EXPECT_EQ(repository->getSessionCount(), 0);
+    EXPECT_TRUE(repository->getAllImsis().empty());
+}
+
+TEST_F(ShardedSessionRepositoryTest, GetExpiredSessions) {
+    for (const auto& imsi : imsis) {
+        repository->addSession(Session(imsi));
+    }
+    
+    // Сразу после создания сессии не истекли
+    EXPECT_TRUE(repository->getExpiredSessions(10).empty());
+    
+    // Ждем 2 секунды
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    
+    // С таймаутом 1 секунда истекли сессии из всех шардов
+    EXPECT_EQ(repository->getExpiredSessions(1).size(), imsis.size());
+}
+
+TEST_F(ShardedSessionRepositoryTest, RemoveExpiredSessions) {
+    for (const auto& imsi : imsis) {
+        repository->addSession(Session(imsi));
+    }
+    
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    
+    // Общий лимит соблюдается при обходе всех шардов
+    EXPECT_EQ(repository->removeExpiredSessions(1, 30).size(), 30);
+    EXPECT_EQ(repository->getSessionCount(), imsis.size() - 30);
+    
+    EXPECT_EQ(repository->removeExpiredSessions(1, imsis.size()).size(), imsis.size() - 30);
+    EXPECT_EQ(repository->getSessionCount(), 0);
+}
+
+TEST_F(ShardedSessionRepositoryTest, ConcurrentAccess) {
+    // Репозиторий без логгера, чтобы потоки конкурировали только за шарды
+    ShardedSessionRepository repo(4);
+    const int threadCount = 8;
+    const int sessionsPerThread = 500;
+    
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&repo, t]() {
+            for (int i = 0; i < sessionsPerThread; ++i) {
+                std::string suffix = std::to_string(t * sessionsPerThread + i);
+                std::string imsi = "00101" + std::string(10 - suffix.size(), '0') + suffix;
+                repo.addSession(Session(imsi));
+                repo.refreshSession(imsi);
+                repo.sessionExists(imsi);
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(repo.getSessionCount(), static_cast<size_t>(threadCount * sessionsPerThread));
+}
@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include "../AppBootstrap.h"
+
+class AppBootstrapTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::filesystem::remove(configPath);
+    }
+
+    // Создает файл конфигурации с заданным содержимым
+    void writeConfig(const std::string& content) const {
+        std::ofstream file(configPath);
+        ASSERT_TRUE(file.is_open());
+        file << content;
+    }
+
+    std::string configPath = "test_bootstrap_config.json";
+};
+
+TEST_F(AppBootstrapTest, InvalidResponseModeRejectsStartup) {
+    writeConfig(R"({"udp_response_mode": "xml", "log_file": ""})");
+    
+    AppBootstrap app;
+    EXPECT_THROW(app.initialize(configPath), std::runtime_error);
+}
+
+TEST_F(AppBootstrapTest, InvalidBatchSizeRejectsStartup) {
+    writeConfig(R"({"udp_batch_size": 5000, "log_file": ""})");
+    
+    AppBootstrap app;
+    EXPECT_THROW(app.initialize(configPath), std::runtime_error);
+}
+
+TEST_F(AppBootstrapTest, MissingConfigRejectsStartup) {
+    AppBootstrap app;
+    EXPECT_THROW(app.initialize("non_existent_config.json"), std::runtime_error);
+}
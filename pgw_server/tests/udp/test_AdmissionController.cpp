@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <atomic>
+#include "../../udp/AdmissionController.h"
+
+class AdmissionControllerTest : public ::testing::Test {
+protected:
+    // Подсчитывает допущенные пакеты из серии от одного источника
+    static size_t admitSeries(AdmissionController& controller, uint32_t source, size_t count) {
+        size_t admitted = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (controller.admit(source) == AdmissionResult::ADMITTED) {
+                ++admitted;
+            }
+        }
+        return admitted;
+    }
+};
+
+TEST_F(AdmissionControllerTest, InvalidOptions) {
+    AdmissionOptions options;
+    options.sourceSlots = 0;
+    EXPECT_THROW(AdmissionController{options}, std::invalid_argument);
+}
+
+TEST_F(AdmissionControllerTest, DisabledByDefault) {
+    // Без бюджетов допускается любой поток
+    AdmissionController controller(AdmissionOptions{});
+    EXPECT_FALSE(controller.isEnabled());
+    EXPECT_EQ(admitSeries(controller, 0x0100007F, 10000), 10000u);
+}
+
+TEST_F(AdmissionControllerTest, SourceBudgetAllowsBurstThenDrops) {
+    // 1000 пакетов в секунду: всплеск 100 пакетов, далее один пакет в миллисекунду
+    AdmissionOptions options;
+    options.sourcePacketsPerSecond = 1000;
+    AdmissionController controller(options);
+    
+    size_t admitted = admitSeries(controller, 0x0100007F, 1000);
+    EXPECT_GE(admitted, 100u);
+    EXPECT_LT(admitted, 200u);
+    EXPECT_EQ(controller.admit(0x0100007F), AdmissionResult::DROPPED_SOURCE);
+    
+    // Другой источник имеет собственный бюджет
+    EXPECT_EQ(controller.admit(0x0200007F), AdmissionResult::ADMITTED);
+    
+    // Бюджет восстанавливается со временем
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_GE(admitSeries(controller, 0x0100007F, 100), 100u);
+}
+
+TEST_F(AdmissionControllerTest, GlobalBudgetSharedBetweenSources) {
+    // Общий бюджет 100 пакетов в секунду (всплеск 10) распределяется между всеми источниками
+    AdmissionOptions options;
+    options.globalPacketsPerSecond = 100;
+    AdmissionController controller(options);
+    
+    size_t admitted = 0;
+    size_t droppedGlobal = 0;
+    for (uint32_t source = 1; source <= 100; ++source) {
+        AdmissionResult result = controller.admit(source);
+        admitted += result == AdmissionResult::ADMITTED;
+        droppedGlobal += result == AdmissionResult::DROPPED_GLOBAL;
+    }
+    EXPECT_GE(admitted, 10u);
+    EXPECT_LT(admitted, 20u);
+    EXPECT_EQ(admitted + droppedGlobal, 100u);
+}
+
+TEST_F(AdmissionControllerTest, SourceDropDoesNotConsumeGlobalBudget) {
+    // Флуд одного источника отсекается по его бюджету и не вытесняет остальных
+    AdmissionOptions options;
+    options.globalPacketsPerSecond = 100;
+    options.sourcePacketsPerSecond = 10;
+    AdmissionController controller(options);
+    
+    size_t admitted = admitSeries(controller, 0x0100007F, 1000);
+    EXPECT_LT(admitted, 5u);
+    
+    for (uint32_t source = 2; source < 8; ++source) {
+        EXPECT_EQ(controller.admit(source), AdmissionResult::ADMITTED) << "source " << source;
+    }
+}
+
+TEST_F(AdmissionControllerTest, ConcurrentAdmissionRespectsGlobalBudget) {
+    // Параллельные потоки не превышают общий бюджет за счет гонок CAS
+    AdmissionOptions options;
+    options.globalPacketsPerSecond = 1000;
+    AdmissionController controller(options);
+    
+    std::atomic<size_t> admitted{0};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&controller, &admitted, t]() {
+            for (size_t i = 0; i < 10000; ++i) {
+                if (controller.admit(t + 1) == AdmissionResult::ADMITTED) {
+                    admitted.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    
+    // Всплеск 100 пакетов плюс один пакет в миллисекунду за время работы потоков
+    EXPECT_GE(admitted.load(), 100u);
+    EXPECT_LE(admitted.load(), 100u + static_cast<size_t>(elapsedMs) + 1);
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <vector>
+#include "../../udp/BcdImsiDecoder.h"
+
+class BcdImsiDecoderTest : public ::testing::Test {
+protected:
+    // Кодирует IMSI в пакет: 4 байта заголовка, BCD с заполнителем F в последнем полубайте
+    static std::string encode(const std::string& imsi) {
+        std::string packet(BcdImsiDecoder::HEADER_SIZE, '\x01');
+        for (size_t i = 0; i < imsi.size(); i += 2) {
+            uint8_t low = imsi[i] - '0';
+            uint8_t high = i + 1 < imsi.size() ? imsi[i + 1] - '0' : 0x0F;
+            packet.push_back(static_cast<char>(low | (high << 4)));
+        }
+        return packet;
+    }
+
+    // Сверяет быстрый декодер с эталонным
+    static void expectSameResult(const std::string& packet) {
+        auto fast = BcdImsiDecoder::decode(packet.data(), packet.size());
+        auto scalar = BcdImsiDecoder::decodeScalar(packet.data(), packet.size());
+        ASSERT_EQ(fast.has_value(), scalar.has_value()) << testing::PrintToString(packet);
+        if (fast) {
+            ASSERT_EQ(fast->value(), scalar->value()) << testing::PrintToString(packet);
+        }
+    }
+};
+
+TEST_F(BcdImsiDecoderTest, DecodeValidPacket) {
+    std::string packet = encode("250011234567890");
+    ASSERT_EQ(packet.size(), BcdImsiDecoder::MIN_PACKET_SIZE);
+
+    auto imsi = BcdImsiDecoder::decode(packet.data(), packet.size());
+    ASSERT_TRUE(imsi.has_value());
+    EXPECT_EQ(imsi->toString(), "250011234567890");
+
+    // Граничные значения и хвост после IMSI
+    EXPECT_EQ(BcdImsiDecoder::decode(encode("000000000000000").data(), 12)->value(), 0u);
+    EXPECT_EQ(BcdImsiDecoder::decode(encode("999999999999999").data(), 12)->value(), Imsi::MAX_VALUE);
+    packet += "trailing";
+    EXPECT_EQ(BcdImsiDecoder::decode(packet.data(), packet.size())->toString(), "250011234567890");
+}
+
+TEST_F(BcdImsiDecoderTest, RejectInvalidPackets) {
+    std::string packet = encode("250011234567890");
+
+    // Короткий пакет
+    EXPECT_FALSE(BcdImsiDecoder::decode(packet.data(), packet.size() - 1).has_value());
+    EXPECT_FALSE(BcdImsiDecoder::decode(packet.data(), 0).has_value());
+
+    // Недопустимая цифра в каждом из 15 полубайтов
+    for (size_t nibble = 0; nibble < Imsi::LENGTH; ++nibble) {
+        std::string corrupted = packet;
+        char& byte = corrupted[BcdImsiDecoder::HEADER_SIZE + nibble / 2];
+        byte = static_cast<char>(nibble % 2 ? (byte & 0x0F) | 0xA0 : (byte & 0xF0) | 0x0B);
+        EXPECT_FALSE(BcdImsiDecoder::decode(corrupted.data(), corrupted.size()).has_value()) << nibble;
+    }
+
+    // Старший полубайт последнего байта не проверяется
+    packet[BcdImsiDecoder::MIN_PACKET_SIZE - 1] = static_cast<char>(0xC0);
+    EXPECT_TRUE(BcdImsiDecoder::decode(packet.data(), packet.size()).has_value());
+}
+
+TEST_F(BcdImsiDecoderTest, FuzzAgainstScalarDecoder) {
+    std::mt19937_64 random(20240601);
+    std::uniform_int_distribution<int> lengthDistribution(0, 20);
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+    std::uniform_int_distribution<int> digitDistribution(0, 9);
+    std::uniform_int_distribution<int> modeDistribution(0, 2);
+
+    for (int iteration = 0; iteration < 200000; ++iteration) {
+        std::string packet(lengthDistribution(random), '\0');
+        int mode = modeDistribution(random);
+        for (size_t i = 0; i < packet.size(); ++i) {
+            if (mode == 0 || i < BcdImsiDecoder::HEADER_SIZE) {
+                // Произвольные байты
+                packet[i] = static_cast<char>(byteDistribution(random));
+            } else {
+                // Корректные цифры, в режиме 2 - с одним испорченным полубайтом
+                packet[i] = static_cast<char>(digitDistribution(random) | (digitDistribution(random) << 4));
+            }
+        }
+        if (mode == 2 && packet.size() > BcdImsiDecoder::HEADER_SIZE) {
+            size_t position = BcdImsiDecoder::HEADER_SIZE +
+                              random() % (packet.size() - BcdImsiDecoder::HEADER_SIZE);
+            packet[position] = static_cast<char>(packet[position] | (random() % 2 ? 0xF0 : 0x0F));
+        }
+        expectSameResult(packet);
+    }
+}
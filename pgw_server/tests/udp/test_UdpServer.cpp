@@ -318,3 +318,433 @@ TEST_F(UdpServerTest, HandleMultipleSessions) {
     // Останавливаем сервер
     udpServer->stop();
 }
+
+TEST_F(UdpServerTest, ConstructorWithZeroWorkers) {
+    // Проверяем, что конструктор выбрасывает исключение при нулевом количестве рабочих потоков
+    UdpServerOptions options;
+    options.workerCount = 0;
+    EXPECT_THROW({
+        UdpServer server("127.0.0.1", 9002, sessionManager, logger, options);
+    }, std::invalid_argument);
+}
+
+// Этот тест проверяет работу нескольких рабочих потоков с SO_REUSEPORT
+TEST_F(UdpServerTest, HandleSessionsWithMultipleWorkers) {
+    UdpServerOptions options;
+    options.workerCount = 4;
+    auto multiWorkerServer = std::make_unique<UdpServer>(
+        "127.0.0.1", 9003, sessionManager, logger, options);
+    
+    // Запускаем сервер
+    ASSERT_TRUE(multiWorkerServer->start());
+    
+    // Настраиваем адрес сервера
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(9003);
+    inet_pton(AF_INET, "127.0.0.1", &(serverAddr.sin_addr));
+    
+    // Отправляем запросы с разных клиентских сокетов, чтобы ядро распределило их по рабочим потокам
+    std::vector<std::string> imsis = {
+        "100000000000001",
+        "100000000000002",
+        "100000000000003",
+        "100000000000004",
+        "100000000000005",
+        "100000000000006",
+        "100000000000007",
+        "100000000000008"
+    };
+    
+    for (const auto& imsi : imsis) {
+        int clientSocket = socket(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_GE(clientSocket, 0);
+        
+        struct timeval timeout{1, 0};
+        setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        
+        auto bcdData = createBcdImsi(imsi);
+        ssize_t bytesSent = sendto(clientSocket, bcdData.data(), bcdData.size(), 0,
+               (struct sockaddr*)&serverAddr, sizeof(serverAddr));
+        ASSERT_GT(bytesSent, 0);
+        
+        // Каждый рабочий поток отвечает со своего сокета на тот же адрес
+        char response[64];
+        ssize_t bytesReceived = recv(clientSocket, response, sizeof(response), 0);
+        ASSERT_GT(bytesReceived, 0);
+        EXPECT_EQ(std::string(response, bytesReceived), "created");
+        
+        close(clientSocket);
+    }
+    
+    // Проверяем, что все сессии были созданы
+    for (const auto& imsi : imsis) {
+        EXPECT_TRUE(sessionRepo->sessionExists(imsi)) << "Сессия для IMSI " << imsi << " не создана";
+    }
+    EXPECT_EQ(sessionRepo->getSessionCount(), imsis.size());
+    
+    // Останавливаем сервер
+    multiWorkerServer->stop();
+    EXPECT_FALSE(multiWorkerServer->isRunning());
+}
+
+TEST_F(UdpServerTest, ConstructorWithInvalidBatchSize) {
+    // Проверяем, что конструктор отклоняет размер пакета вне допустимого диапазона
+    UdpServerOptions options;
+    options.batchSize = 0;
+    EXPECT_THROW({
+        UdpServer server("127.0.0.1", 9002, sessionManager, logger, options);
+    }, std::invalid_argument);
+    
+    options.batchSize = UdpServer::MAX_BATCH_SIZE + 1;
+    EXPECT_THROW({
+        UdpServer server("127.0.0.1", 9002, sessionManager, logger, options);
+    }, std::invalid_argument);
+}
+
+// Этот тест проверяет пакетную обработку датаграмм через recvmmsg/sendmmsg
+TEST_F(UdpServerTest, HandleSessionsInBatchMode) {
+    UdpServerOptions options;
+    options.batchSize = 16;
+    auto batchServer = std::make_unique<UdpServer>(
+        "127.0.0.1", 9004, sessionManager, logger, options);
+    
+    // Запускаем сервер
+    ASSERT_TRUE(batchServer->start());
+    
+    int clientSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(clientSocket, 0);
+    
+    struct timeval timeout{1, 0};
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    // Настраиваем адрес сервера
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(9004);
+    inet_pton(AF_INET, "127.0.0.1", &(serverAddr.sin_addr));
+    
+    // Отправляем серию запросов без ожидания, чтобы сервер прочитал их пачкой,
+    // последний пакет некорректный и должен быть отклонен
+    const size_t validCount = 20;
+    for (size_t i = 0; i < validCount; ++i) {
+        std::string imsi = "2000000000000" + std::to_string(10 + i);
+        auto bcdData = createBcdImsi(imsi);
+        ASSERT_GT(sendto(clientSocket, bcdData.data(), bcdData.size(), 0,
+                         (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+    }
+    std::vector<uint8_t> invalidPacket = {0x01, 0x02, 0x03};
+    ASSERT_GT(sendto(clientSocket, invalidPacket.data(), invalidPacket.size(), 0,
+                     (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+    
+    // Получаем ответ на каждый запрос
+    size_t created = 0;
+    size_t rejected = 0;
+    for (size_t i = 0; i < validCount + 1; ++i) {
+        char response[64];
+        ssize_t bytesReceived = recv(clientSocket, response, sizeof(response), 0);
+        ASSERT_GT(bytesReceived, 0);
+        std::string text(response, bytesReceived);
+        if (text == "created") {
+            ++created;
+        } else if (text == "rejected") {
+            ++rejected;
+        }
+    }
+    EXPECT_EQ(created, validCount);
+    EXPECT_EQ(rejected, 1);
+    EXPECT_EQ(sessionRepo->getSessionCount(), validCount);
+    
+    close(clientSocket);
+    batchServer->stop();
+}
+
+TEST_F(UdpServerTest, BatchModeDropsTruncatedDatagrams) {
+    UdpServerOptions options;
+    options.batchSize = 8;
+    auto batchServer = std::make_unique<UdpServer>(
+        "127.0.0.1", 9008, sessionManager, logger, options);
+    ASSERT_TRUE(batchServer->start());
+    
+    int clientSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(clientSocket, 0);
+    
+    struct timeval timeout{0, 300000};
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(9008);
+    inet_pton(AF_INET, "127.0.0.1", &(serverAddr.sin_addr));
+    
+    // Корректный запрос, дополненный до размера больше слота пачки, обрезается ядром
+    auto oversized = createBcdImsi("700000000000001");
+    oversized.resize(UdpServer::BATCH_SLOT_SIZE * 2, 0xFF);
+    auto valid = createBcdImsi("700000000000002");
+    ASSERT_GT(sendto(clientSocket, oversized.data(), oversized.size(), 0,
+                     (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+    ASSERT_GT(sendto(clientSocket, valid.data(), valid.size(), 0,
+                     (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+    
+    // Ответ приходит только на корректный запрос
+    char response[64];
+    ssize_t bytesReceived = recv(clientSocket, response, sizeof(response), 0);
+    ASSERT_GT(bytesReceived, 0);
+    EXPECT_EQ(std::string(response, bytesReceived), "created");
+    EXPECT_LT(recv(clientSocket, response, sizeof(response), 0), 0);
+    EXPECT_EQ(sessionRepo->getSessionCount(), 1);
+    EXPECT_FALSE(sessionRepo->sessionExists(std::string("700000000000001")));
+    
+    close(clientSocket);
+    batchServer->stop();
+}
+
+TEST_F(UdpServerTest, SingleModeDropsOversizedDatagrams) {
+    // Буфер одиночного режима больше слота пачки, но граница длины та же
+    UdpServerOptions options;
+    options.batchSize = 1;
+    auto singleServer = std::make_unique<UdpServer>(
+        "127.0.0.1", 9009, sessionManager, logger, options);
+    ASSERT_TRUE(singleServer->start());
+    
+    int clientSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(clientSocket, 0);
+    
+    struct timeval timeout{0, 300000};
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(9009);
+    inet_pton(AF_INET, "127.0.0.1", &(serverAddr.sin_addr));
+    
+    // Корректный запрос, дополненный до размера больше слота пачки, отбрасывается
+    auto oversized = createBcdImsi("710000000000001");
+    oversized.resize(UdpServer::BATCH_SLOT_SIZE * 2, 0xFF);
+    auto valid = createBcdImsi("710000000000002");
+    ASSERT_GT(sendto(clientSocket, oversized.data(), oversized.size(), 0,
+                     (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+    ASSERT_GT(sendto(clientSocket, valid.data(), valid.size(), 0,
+                     (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+    
+    // Ответ приходит только на корректный запрос
+    char response[64];
+    ssize_t bytesReceived = recv(clientSocket, response, sizeof(response), 0);
+    ASSERT_GT(bytesReceived, 0);
+    EXPECT_EQ(std::string(response, bytesReceived), "created");
+    EXPECT_LT(recv(clientSocket, response, sizeof(response), 0), 0);
+    EXPECT_EQ(sessionRepo->getSessionCount(), 1);
+    EXPECT_FALSE(sessionRepo->sessionExists(std::string("710000000000001")));
+    
+    close(clientSocket);
+    singleServer->stop();
+}
+
+// Этот тест проверяет режим EPOLLET: все датаграммы серии должны быть вычитаны за одно пробуждение
+TEST_F(UdpServerTest, HandleSessionsInEdgeTriggeredMode) {
+    for (size_t batchSize : {static_cast<size_t>(1), static_cast<size_t>(8)}) {
+        sessionRepo->clear();
+        
+        UdpServerOptions options;
+        options.edgeTriggered = true;
+        options.batchSize = batchSize;
+        auto edgeServer = std::make_unique<UdpServer>(
+            "127.0.0.1", 9005, sessionManager, logger, options);
+        ASSERT_TRUE(edgeServer->start());
+        
+        int clientSocket = socket(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_GE(clientSocket, 0);
+        
+        struct timeval timeout{1, 0};
+        setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        
+        struct sockaddr_in serverAddr;
+        memset(&serverAddr, 0, sizeof(serverAddr));
+        serverAddr.sin_family = AF_INET;
+        serverAddr.sin_port = htons(9005);
+        inet_pton(AF_INET, "127.0.0.1", &(serverAddr.sin_addr));
+        
+        // Отправляем серию запросов без ожидания ответов
+        const size_t count = 30;
+        for (size_t i = 0; i < count; ++i) {
+            std::string imsi = "3000000000000" + std::to_string(10 + i);
+            auto bcdData = createBcdImsi(imsi);
+            ASSERT_GT(sendto(clientSocket, bcdData.data(), bcdData.size(), 0,
+                             (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+        }
+        
+        // Каждый запрос должен получить ответ
+        for (size_t i = 0; i < count; ++i) {
+            char response[64];
+            ssize_t bytesReceived = recv(clientSocket, response, sizeof(response), 0);
+            ASSERT_GT(bytesReceived, 0) << "batch size " << batchSize << ", response " << i;
+            EXPECT_EQ(std::string(response, bytesReceived), "created");
+        }
+        EXPECT_EQ(sessionRepo->getSessionCount(), count);
+        
+        close(clientSocket);
+        edgeServer->stop();
+        EXPECT_FALSE(edgeServer->isRunning());
+    }
+}
+
+TEST_F(UdpServerTest, RestartAfterStop) {
+    // Проверяем, что после остановки ресурсы (сокеты, epoll, eventfd) освобождаются и сервер можно запустить снова
+    ASSERT_TRUE(udpServer->start());
+    udpServer->stop();
+    ASSERT_TRUE(udpServer->start());
+    EXPECT_TRUE(udpServer->isRunning());
+    udpServer->stop();
+    EXPECT_FALSE(udpServer->isRunning());
+}
+
+TEST_F(UdpServerTest, AdmissionControlDropsExcessPacketsSilently) {
+    // Бюджет источника 10 пакетов в секунду (всплеск 1): серия из 30 пакетов почти целиком отбрасывается
+    UdpServerOptions options;
+    options.admission.sourcePacketsPerSecond = 10;
+    auto limitedServer = std::make_unique<UdpServer>(
+        "127.0.0.1", 9006, sessionManager, logger, options);
+    ASSERT_TRUE(limitedServer->start());
+    
+    int clientSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(clientSocket, 0);
+    
+    struct timeval timeout{0, 300000};
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(9006);
+    inet_pton(AF_INET, "127.0.0.1", &(serverAddr.sin_addr));
+    
+    const size_t count = 30;
+    for (size_t i = 0; i < count; ++i) {
+        std::string imsi = "4000000000000" + std::to_string(10 + i);
+        auto bcdData = createBcdImsi(imsi);
+        ASSERT_GT(sendto(clientSocket, bcdData.data(), bcdData.size(), 0,
+                         (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+    }
+    
+    // Отброшенные пакеты остаются без ответа и не доходят до SessionManager
+    size_t responses = 0;
+    char response[64];
+    while (recv(clientSocket, response, sizeof(response), 0) > 0) {
+        ++responses;
+    }
+    EXPECT_GE(responses, 1u);
+    EXPECT_LT(responses, count);
+    EXPECT_EQ(sessionRepo->getSessionCount(), responses);
+    
+    close(clientSocket);
+    limitedServer->stop();
+}
+
+TEST_F(UdpServerTest, BinaryResponseModeEchoesHeader) {
+    // Бинарный ответ: заголовок запроса без изменений и код результата, в одиночном и пакетном режимах
+    blacklist->setBlacklist({"500000000000099"});
+    for (size_t batchSize : {static_cast<size_t>(1), static_cast<size_t>(8)}) {
+        sessionRepo->clear();
+        
+        UdpServerOptions options;
+        options.batchSize = batchSize;
+        options.responseMode = UdpResponseMode::BINARY;
+        auto binaryServer = std::make_unique<UdpServer>(
+            "127.0.0.1", 9007, sessionManager, logger, options);
+        ASSERT_TRUE(binaryServer->start());
+        
+        int clientSocket = socket(AF_INET, SOCK_DGRAM, 0);
+        ASSERT_GE(clientSocket, 0);
+        
+        struct timeval timeout{1, 0};
+        setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        
+        struct sockaddr_in serverAddr;
+        memset(&serverAddr, 0, sizeof(serverAddr));
+        serverAddr.sin_family = AF_INET;
+        serverAddr.sin_port = htons(9007);
+        inet_pton(AF_INET, "127.0.0.1", &(serverAddr.sin_addr));
+        
+        // Запрос с заданным заголовком и ожидаемый ответ
+        auto makeRequest = [](const std::string& imsi, uint8_t id) {
+            auto packet = createBcdImsi(imsi);
+            packet[1] = 0xAA;
+            packet[2] = 0xBB;
+            packet[3] = id;
+            return packet;
+        };
+        std::vector<std::pair<std::vector<uint8_t>, ResponseCode>> requests = {
+            {makeRequest("500000000000001", 1), ResponseCode::CREATED},
+            {makeRequest("500000000000001", 2), ResponseCode::REFRESHED},
+            {makeRequest("500000000000099", 3), ResponseCode::REJECTED_BLACKLIST},
+            {{0x01, 0xAA, 0xBB, 4, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}, ResponseCode::INVALID_REQUEST},
+            {{0x01, 0x02}, ResponseCode::INVALID_REQUEST},
+        };
+        
+        for (const auto& [request, code] : requests) {
+            ASSERT_GT(sendto(clientSocket, request.data(), request.size(), 0,
+                             (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+        }
+        
+        for (const auto& [request, code] : requests) {
+            uint8_t response[64];
+            ssize_t bytesReceived = recv(clientSocket, response, sizeof(response), 0);
+            ASSERT_EQ(bytesReceived, static_cast<ssize_t>(UdpServer::BINARY_RESPONSE_SIZE))
+                << "batch size " << batchSize;
+            
+            // Пакет короче заголовка получает нулевой заголовок
+            std::vector<uint8_t> header(UdpServer::RESPONSE_HEADER_SIZE, 0);
+            if (request.size() >= UdpServer::RESPONSE_HEADER_SIZE) {
+                header.assign(request.begin(), request.begin() + UdpServer::RESPONSE_HEADER_SIZE);
+            }
+            EXPECT_EQ(std::vector<uint8_t>(response, response + UdpServer::RESPONSE_HEADER_SIZE), header);
+            EXPECT_EQ(response[UdpServer::RESPONSE_HEADER_SIZE], static_cast<uint8_t>(code));
+        }
+        
+        close(clientSocket);
+        binaryServer->stop();
+    }
+}
+
+TEST_F(UdpServerTest, CorrelatedHeaderEchoedInTextMode) {
+    // Заголовок версии 2 повторяется перед текстовым ответом, версии 1 - нет
+    ASSERT_TRUE(udpServer->start());
+    
+    int clientSocket = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(clientSocket, 0);
+    
+    struct timeval timeout{1, 0};
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(9001);
+    inet_pton(AF_INET, "127.0.0.1", &(serverAddr.sin_addr));
+    
+    auto correlated = createBcdImsi("600000000000001");
+    correlated[0] = UdpServer::HEADER_VERSION_CORRELATED;
+    correlated[1] = 0x12;
+    correlated[2] = 0x34;
+    correlated[3] = 0x56;
+    auto legacy = createBcdImsi("600000000000002");
+    
+    char response[64];
+    ASSERT_GT(sendto(clientSocket, correlated.data(), correlated.size(), 0,
+                     (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+    ssize_t bytesReceived = recv(clientSocket, response, sizeof(response), 0);
+    ASSERT_GT(bytesReceived, 0);
+    EXPECT_EQ(std::string(response, bytesReceived), std::string("\x02\x12\x34\x56", 4) + "created");
+    
+    ASSERT_GT(sendto(clientSocket, legacy.data(), legacy.size(), 0,
+                     (struct sockaddr*)&serverAddr, sizeof(serverAddr)), 0);
+    bytesReceived = recv(clientSocket, response, sizeof(response), 0);
+    ASSERT_GT(bytesReceived, 0);
+    EXPECT_EQ(std::string(response, bytesReceived), "created");
+    
+    close(clientSocket);
+}
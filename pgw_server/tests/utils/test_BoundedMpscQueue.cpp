@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include "../../utils/BoundedMpscQueue.h"
+
+TEST(BoundedMpscQueueTest, CapacityRoundedToPowerOfTwo) {
+    BoundedMpscQueue<int> queue(5);
+    EXPECT_EQ(queue.capacity(), 8);
+    
+    // Нулевая емкость недопустима
+    EXPECT_THROW(BoundedMpscQueue<int> invalid(0), std::invalid_argument);
+}
+
+TEST(BoundedMpscQueueTest, FifoOrderAndFullQueue) {
+    BoundedMpscQueue<int> queue(4);
+    
+    for (int i = 0; i < 4; ++i) {
+        int value = i;
+        EXPECT_TRUE(queue.tryPush(value));
+    }
+    
+    // Очередь заполнена: элемент не добавляется и остается у вызывающего
+    int extra = 42;
+    EXPECT_FALSE(queue.tryPush(extra));
+    EXPECT_EQ(extra, 42);
+    
+    for (int i = 0; i < 4; ++i) {
+        auto value = queue.tryPop();
+        ASSERT_TRUE(value.has_value());
+        EXPECT_EQ(*value, i);
+    }
+    
+    EXPECT_FALSE(queue.tryPop().has_value());
+    
+    // После освобождения места очередь снова принимает элементы
+    EXPECT_TRUE(queue.tryPush(extra));
+    EXPECT_EQ(queue.tryPop().value(), 42);
+}
+
+TEST(BoundedMpscQueueTest, MultipleProducersSingleConsumer) {
+    BoundedMpscQueue<int> queue(64);
+    const int producerCount = 4;
+    const int itemsPerProducer = 10000;
+    
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < itemsPerProducer; ++i) {
+                int value = p * itemsPerProducer + i;
+                while (!queue.tryPush(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    
+    // Потребитель должен получить каждый элемент ровно один раз,
+    // причем элементы одного производителя - в порядке добавления
+    std::vector<int> received(producerCount * itemsPerProducer, 0);
+    std::vector<int> lastFromProducer(producerCount, -1);
+    int total = 0;
+    while (total < producerCount * itemsPerProducer) {
+        auto value = queue.tryPop();
+        if (!value) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = *value / itemsPerProducer;
+        EXPECT_GT(*value, lastFromProducer[producer]);
+        lastFromProducer[producer] = *value;
+        received[*value]++;
+        total++;
+    }
+    
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    
+    for (int count : received) {
+        EXPECT_EQ(count, 1);
+    }
+    EXPECT_FALSE(queue.tryPop().has_value());
+}
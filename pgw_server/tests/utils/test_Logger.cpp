@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include "../../utils/Logger.h"
+#include "../../utils/ServerMetrics.h"
 #include <fstream>
 #include <filesystem>
 #include <string>
@@ -95,3 +96,151 @@ TEST_F(LoggerTest, FlushMethod) {
     // Проверяем, что логгер остается в рабочем состоянии
     EXPECT_TRUE(logger.isHealthy());
 }
+
+TEST_F(LoggerTest, IsEnabledFollowsLogLevel) {
+    Logger logger(tempLogFile, LogLevel::WARN);
+    
+    EXPECT_FALSE(logger.isEnabled(LogLevel::LOG_DEBUG));
+    EXPECT_FALSE(logger.isEnabled(LogLevel::INFO));
+    EXPECT_TRUE(logger.isEnabled(LogLevel::WARN));
+    EXPECT_TRUE(logger.isEnabled(LogLevel::CRITICAL));
+    
+    logger.setLogLevel(LogLevel::LOG_DEBUG);
+    EXPECT_TRUE(logger.isEnabled(LogLevel::LOG_DEBUG));
+}
+
+TEST_F(LoggerTest, MacrosEvaluateArgumentsLazily) {
+    auto logger = std::make_shared<Logger>(tempLogFile, LogLevel::WARN);
+    int evaluations = 0;
+    auto expensive = [&evaluations]() {
+        ++evaluations;
+        return std::string("value");
+    };
+    
+    // Отключенный уровень не вычисляет аргументы
+    PGW_LOG_DEBUG(logger, "Debug {}", expensive());
+    PGW_LOG_INFO(logger, "Info {}", expensive());
+    EXPECT_EQ(evaluations, 0);
+    
+    // Включенный уровень форматирует и пишет сообщение
+    PGW_LOG_WARN(logger, "Warn {} {}", expensive(), 42);
+    EXPECT_EQ(evaluations, 1);
+    logger->flush();
+    
+    std::ifstream file(tempLogFile);
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("Warn value 42"), std::string::npos);
+    EXPECT_EQ(content.find("Debug value"), std::string::npos);
+    
+    // Нулевой логгер допустим
+    std::shared_ptr<Logger> nullLogger;
+    PGW_LOG_ERROR(nullLogger, "Error {}", expensive());
+    EXPECT_EQ(evaluations, 1);
+    EXPECT_TRUE(logger->isHealthy());
+}
+
+namespace {
+
+/**
+ * @brief Считает строки файла, содержащие подстроку
+ * @param path Путь к файлу
+ * @param needle Подстрока
+ * @return Количество строк
+ */
+size_t countLinesContaining(const std::string& path, const std::string& needle) {
+    std::ifstream file(path);
+    std::string line;
+    size_t count = 0;
+    while (std::getline(file, line)) {
+        if (line.find(needle) != std::string::npos) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_F(LoggerTest, OverflowPolicyConversion) {
+    EXPECT_EQ(Logger::stringToOverflowPolicy("block"), LogOverflowPolicy::BLOCK);
+    EXPECT_EQ(Logger::stringToOverflowPolicy("drop_oldest"), LogOverflowPolicy::DROP_OLDEST);
+    EXPECT_EQ(Logger::stringToOverflowPolicy("drop_new"), LogOverflowPolicy::DROP_NEW);
+    EXPECT_EQ(Logger::stringToOverflowPolicy("invalid"), LogOverflowPolicy::BLOCK);
+    EXPECT_EQ(Logger::overflowPolicyToString(LogOverflowPolicy::DROP_OLDEST), "drop_oldest");
+    
+    // Нулевая емкость очереди недопустима в асинхронном режиме
+    LoggerOptions options;
+    options.async = true;
+    options.queueSize = 0;
+    EXPECT_THROW(Logger logger(tempLogFile, LogLevel::INFO, options), std::invalid_argument);
+}
+
+TEST_F(LoggerTest, AsyncBlockPolicyKeepsAllMessages) {
+    constexpr size_t MESSAGE_COUNT = 2000;
+    LoggerOptions options;
+    options.async = true;
+    options.queueSize = 4;
+    options.overflowPolicy = LogOverflowPolicy::BLOCK;
+    
+    {
+        Logger logger(tempLogFile, LogLevel::INFO, options);
+        for (size_t i = 0; i < MESSAGE_COUNT; ++i) {
+            logger.logf(LogLevel::INFO, "flood message {}", i);
+        }
+        EXPECT_EQ(logger.getDroppedCount(), 0);
+    }
+    
+    // Деструктор дожидается записи всей очереди
+    EXPECT_EQ(countLinesContaining(tempLogFile, "flood message"), MESSAGE_COUNT);
+}
+
+TEST_F(LoggerTest, AsyncDropPoliciesAccountForEveryMessage) {
+    constexpr size_t MESSAGE_COUNT = 2000;
+    constexpr size_t SERVICE_MESSAGES = 3; // Сообщения о запуске логгера, которые тоже могут быть вытеснены
+    
+    for (auto policy : {LogOverflowPolicy::DROP_OLDEST, LogOverflowPolicy::DROP_NEW}) {
+        LoggerOptions options;
+        options.async = true;
+        options.queueSize = 4;
+        options.overflowPolicy = policy;
+        
+        uint64_t dropped = 0;
+        {
+            Logger logger(tempLogFile, LogLevel::INFO, options);
+            for (size_t i = 0; i < MESSAGE_COUNT; ++i) {
+                logger.info("flood message " + std::to_string(i));
+            }
+            dropped = logger.getDroppedCount();
+        }
+        
+        // Каждое сообщение либо записано, либо учтено как потерянное
+        SCOPED_TRACE(Logger::overflowPolicyToString(policy));
+        EXPECT_GT(dropped, 0);
+        size_t accounted = countLinesContaining(tempLogFile, "flood message") + dropped;
+        EXPECT_GE(accounted, MESSAGE_COUNT);
+        EXPECT_LE(accounted, MESSAGE_COUNT + SERVICE_MESSAGES);
+    }
+}
+
+TEST_F(LoggerTest, DroppedMetricGrowsWhileQueueSaturated) {
+    constexpr size_t MESSAGE_COUNT = 2000;
+    ServerMetrics::init(9102);
+    
+    for (auto policy : {LogOverflowPolicy::DROP_OLDEST, LogOverflowPolicy::DROP_NEW}) {
+        LoggerOptions options;
+        options.async = true;
+        options.queueSize = 4;
+        options.overflowPolicy = policy;
+        
+        // Метрика проверяется до flush и деструктора, то есть во время переполнения
+        uint64_t before = ServerMetrics::getLogDropped();
+        Logger logger(tempLogFile, LogLevel::INFO, options);
+        for (size_t i = 0; i < MESSAGE_COUNT; ++i) {
+            logger.info("flood message " + std::to_string(i));
+        }
+        
+        SCOPED_TRACE(Logger::overflowPolicyToString(policy));
+        EXPECT_GT(ServerMetrics::getLogDropped(), before);
+        EXPECT_LE(ServerMetrics::getLogDropped() - before, logger.getDroppedCount());
+    }
+}
@@ -1,30 +1,131 @@
 #include <gtest/gtest.h>
-#include "utils/ServerMetrics.h"
+#include "../../utils/ServerMetrics.h"
 #include <thread>
 #include <chrono>
 
 class ServerMetricsTest : public ::testing::Test {
 protected:
     void SetUp() override {
+        // Накопленное потоком в прошлых тестах выгружается до пересоздания гистограмм
+        ServerMetrics::flushThreadLatency();
         ServerMetrics::init(9102);
     }
 
-    void TearDown() override {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    /**
+     * @brief Возвращает накопленный счетчик корзины с заданной верхней границей
+     */
+    static uint64_t cumulativeCount(const prometheus::ClientMetric::Histogram& histogram, double upperBound) {
+        for (const auto& bucket : histogram.bucket) {
+            if (bucket.upper_bound == upperBound) {
+                return bucket.cumulative_count;
+            }
+        }
+        ADD_FAILURE() << "No bucket with upper bound " << upperBound;
+        return 0;
     }
 };
 
+TEST(ServerMetricsBeforeInitTest, StageTimerRecordsNothing) {
+    // Тест имеет смысл только в процессе, где метрики еще не инициализированы
+    if (ServerMetrics::latencyEnabled()) {
+        GTEST_SKIP() << "ServerMetrics already initialized in this process";
+    }
+
+    StageTimer timer;
+    timer.mark(LatencyStage::DECODE);
+    timer.finishRequest();
+    ServerMetrics::observeStageLatency(LatencyStage::CDR, std::chrono::microseconds(10));
+    ServerMetrics::flushThreadLatency();
+
+    EXPECT_EQ(ServerMetrics::getStageLatency(LatencyStage::DECODE).sample_count, 0u);
+    EXPECT_EQ(ServerMetrics::getStageLatency(LatencyStage::CDR).sample_count, 0u);
+    EXPECT_EQ(ServerMetrics::getRequestLatency().sample_count, 0u);
+}
+
 TEST_F(ServerMetricsTest, IncRequestsProcessed) {
-    ASSERT_NO_THROW(ServerMetrics::incRequestsProcessed());
+    ASSERT_NO_THROW(ServerMetrics::incProcessedRequests());
 }
 
 TEST_F(ServerMetricsTest, IncRequestsRejected) {
-    ASSERT_NO_THROW(ServerMetrics::incRequestsRejected());
+    ASSERT_NO_THROW(ServerMetrics::incRejectedRequests());
+}
+
+TEST_F(ServerMetricsTest, StageTimerRecordsIntoStageSeries) {
+    ASSERT_TRUE(ServerMetrics::latencyEnabled());
+
+    StageTimer timer;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    timer.mark(LatencyStage::CDR);
+    timer.finishRequest();
+
+    // До выгрузки наблюдения остаются в счетчиках потока
+    EXPECT_EQ(ServerMetrics::getStageLatency(LatencyStage::CDR).sample_count, 0u);
+    ServerMetrics::flushThreadLatency();
+
+    auto cdr = ServerMetrics::getStageLatency(LatencyStage::CDR);
+    EXPECT_EQ(cdr.sample_count, 1u);
+    EXPECT_GE(cdr.sample_sum, 0.002);
+    EXPECT_EQ(ServerMetrics::getStageLatency(LatencyStage::DECODE).sample_count, 0u);
+
+    auto request = ServerMetrics::getRequestLatency();
+    EXPECT_EQ(request.sample_count, 1u);
+    EXPECT_DOUBLE_EQ(request.sample_sum, cdr.sample_sum);
+}
+
+TEST_F(ServerMetricsTest, ValueOnBoundLandsInThatBucket) {
+    // Корзины Prometheus - le: значение, равное границе, попадает в корзину этой границы
+    ServerMetrics::observeStageLatency(LatencyStage::BLACKLIST, std::chrono::nanoseconds(5000));
+    ServerMetrics::observeStageLatency(LatencyStage::RATE_LIMIT, std::chrono::nanoseconds(5001));
+    ServerMetrics::flushThreadLatency();
+
+    auto onBound = ServerMetrics::getStageLatency(LatencyStage::BLACKLIST);
+    EXPECT_EQ(cumulativeCount(onBound, 2.5e-6), 0u);
+    EXPECT_EQ(cumulativeCount(onBound, 5e-6), 1u);
+
+    auto aboveBound = ServerMetrics::getStageLatency(LatencyStage::RATE_LIMIT);
+    EXPECT_EQ(cumulativeCount(aboveBound, 5e-6), 0u);
+    EXPECT_EQ(cumulativeCount(aboveBound, 1e-5), 1u);
+
+    // Значение больше последней границы учитывается только в корзине +Inf
+    ServerMetrics::observeStageLatency(LatencyStage::SESSION_STORE, std::chrono::seconds(2));
+    ServerMetrics::flushThreadLatency();
+    auto overflow = ServerMetrics::getStageLatency(LatencyStage::SESSION_STORE);
+    EXPECT_EQ(cumulativeCount(overflow, 1.0), 0u);
+    EXPECT_EQ(overflow.sample_count, 1u);
+}
+
+TEST_F(ServerMetricsTest, BatchCountMultipliesObservation) {
+    // Пачка из 32 ответов: каждый учитывается с длительностью пачки
+    const auto start = std::chrono::steady_clock::now();
+    ServerMetrics::observeStageLatency(LatencyStage::RESPONSE, std::chrono::microseconds(1), 32);
+    ServerMetrics::observeRequestLatency(start, start + std::chrono::microseconds(10), 32);
+    ServerMetrics::flushThreadLatency();
+
+    auto response = ServerMetrics::getStageLatency(LatencyStage::RESPONSE);
+    EXPECT_EQ(response.sample_count, 32u);
+    EXPECT_NEAR(response.sample_sum, 32e-6, 1e-12);
+    EXPECT_EQ(cumulativeCount(response, 1e-6), 32u);
+
+    auto request = ServerMetrics::getRequestLatency();
+    EXPECT_EQ(request.sample_count, 32u);
+    EXPECT_NEAR(request.sample_sum, 320e-6, 1e-12);
+    EXPECT_EQ(cumulativeCount(request, 1e-5), 32u);
+}
+
+TEST_F(ServerMetricsTest, FlushesAfterObservationLimit) {
+    // Выгрузка без явного вызова после FLUSH_OBSERVATIONS наблюдений потока
+    for (uint32_t i = 0; i < ServerMetrics::FLUSH_OBSERVATIONS; ++i) {
+        ServerMetrics::observeStageLatency(LatencyStage::ADMISSION, std::chrono::nanoseconds(100));
+    }
+    EXPECT_EQ(ServerMetrics::getStageLatency(LatencyStage::ADMISSION).sample_count,
+              ServerMetrics::FLUSH_OBSERVATIONS);
 }
 
-TEST_F(ServerMetricsTest, SetActiveSessions) {
-    // Проверяем различные значения
-    ASSERT_NO_THROW(ServerMetrics::setActiveSessions(0));
-    ASSERT_NO_THROW(ServerMetrics::setActiveSessions(100));
-    ASSERT_NO_THROW(ServerMetrics::setActiveSessions(1000000));
-}
\ No newline at end of file
+TEST_F(ServerMetricsTest, FlushesOnThreadExit) {
+    // Поток, завершившийся без явной выгрузки, отдает накопленное в деструкторе
+    std::thread worker([]() {
+        ServerMetrics::observeStageLatency(LatencyStage::SESSION, std::chrono::microseconds(3));
+    });
+    worker.join();
+    EXPECT_EQ(ServerMetrics::getStageLatency(LatencyStage::SESSION).sample_count, 1u);
+}
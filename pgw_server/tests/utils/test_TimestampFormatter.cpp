@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include "../../utils/TimestampFormatter.h"
+
+namespace {
+
+/**
+ * @brief Эталонное форматирование через std::put_time
+ * @param time Время
+ * @return Строка YYYY-MM-DD HH:MM:SS
+ */
+std::string referenceTimestamp(std::chrono::system_clock::time_point time) {
+    auto timeT = std::chrono::system_clock::to_time_t(
+        std::chrono::floor<std::chrono::seconds>(time));
+    std::tm localTime{};
+    localtime_r(&timeT, &localTime);
+    
+    std::stringstream ss;
+    ss << std::put_time(&localTime, "%Y-%m-%d %H:%M:%S");
+    return ss.str();
+}
+
+} // namespace
+
+class TimestampFormatterTest : public ::testing::Test {
+protected:
+    // Фиксированный момент времени с дробной частью 123456 мкс
+    std::chrono::system_clock::time_point _time =
+        std::chrono::system_clock::time_point(std::chrono::seconds(1700000000)) +
+        std::chrono::microseconds(123456);
+};
+
+TEST_F(TimestampFormatterTest, MatchesPutTimeForSeconds) {
+    TimestampFormatter formatter;
+    
+    EXPECT_EQ(formatter.toString(_time), referenceTimestamp(_time));
+    
+    // Проверяем диапазон секунд, включая смену суток и года
+    auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1703980000));
+    for (int i = 0; i < 200000; i += 997) {
+        auto time = start + std::chrono::seconds(i);
+        EXPECT_EQ(formatter.toString(time), referenceTimestamp(time));
+    }
+}
+
+TEST_F(TimestampFormatterTest, FractionalPrecision) {
+    TimestampFormatter millis(TimestampPrecision::MILLISECONDS);
+    TimestampFormatter micros(TimestampPrecision::MICROSECONDS);
+    
+    std::string prefix = referenceTimestamp(_time);
+    EXPECT_EQ(millis.toString(_time), prefix + ".123");
+    EXPECT_EQ(micros.toString(_time), prefix + ".123456");
+    
+    // Ведущие нули в дробной части сохраняются
+    auto early = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000)) +
+                 std::chrono::microseconds(7);
+    EXPECT_EQ(millis.toString(early), prefix + ".000");
+    EXPECT_EQ(micros.toString(early), prefix + ".000007");
+    
+    EXPECT_EQ(TimestampFormatter::lengthFor(TimestampPrecision::SECONDS), 19);
+    EXPECT_EQ(TimestampFormatter::lengthFor(TimestampPrecision::MICROSECONDS), TimestampFormatter::MAX_LENGTH);
+}
+
+TEST_F(TimestampFormatterTest, CachedPrefixUpdatesOnSecondChange) {
+    TimestampFormatter formatter(TimestampPrecision::MILLISECONDS);
+    
+    // Несколько меток в пределах одной секунды используют кэш
+    auto first = formatter.toString(_time);
+    auto sameSecond = formatter.toString(_time + std::chrono::milliseconds(500));
+    EXPECT_EQ(first.substr(0, 19), sameSecond.substr(0, 19));
+    EXPECT_EQ(sameSecond.substr(19), ".623");
+    
+    // Переход к следующей секунде пересчитывает префикс
+    auto next = _time + std::chrono::seconds(1);
+    EXPECT_EQ(formatter.toString(next), referenceTimestamp(next) + ".123");
+    
+    // Возврат к предыдущей секунде тоже корректен
+    EXPECT_EQ(formatter.toString(_time), first);
+}
+
+TEST_F(TimestampFormatterTest, AppendWritesIntoExistingBuffer) {
+    TimestampFormatter formatter;
+    
+    std::string buffer = "prefix:";
+    formatter.append(_time, buffer);
+    buffer += ",001010123456789,create";
+    
+    EXPECT_EQ(buffer, "prefix:" + referenceTimestamp(_time) + ",001010123456789,create");
+    
+    char raw[TimestampFormatter::MAX_LENGTH];
+    EXPECT_EQ(formatter.format(_time, raw), 19);
+    EXPECT_EQ(std::string(raw, 19), referenceTimestamp(_time));
+}
@@ -0,0 +1,79 @@
+#include <AdmissionController.h>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+AdmissionController::AdmissionController(const AdmissionOptions& options)
+    : _globalLimit(makeLimit(options.globalPacketsPerSecond)),
+      _sourceLimit(makeLimit(options.sourcePacketsPerSecond)),
+      _sourceMask(0)
+{
+    if (options.sourceSlots == 0) throw std::invalid_argument("sourceSlots must be positive");
+
+    // Округляем до степени двойки, чтобы индекс вычислялся маской
+    size_t slots = 1;
+    while (slots < options.sourceSlots) {
+        slots <<= 1;
+    }
+    _sourceMask = slots - 1;
+
+    if (_sourceLimit.intervalNs > 0) {
+        _sourceSlots = std::make_unique<std::atomic<int64_t>[]>(slots);
+    }
+}
+
+AdmissionResult AdmissionController::admit(uint32_t sourceAddress) {
+    if (!isEnabled()) {
+        return AdmissionResult::ADMITTED;
+    }
+
+    int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // Сначала бюджет источника: превысивший его клиент не расходует общий бюджет
+    if (_sourceSlots) {
+        uint64_t hash = static_cast<uint64_t>(sourceAddress) * 0x9E3779B97F4A7C15ULL;
+        auto& slot = _sourceSlots[(hash >> 32) & _sourceMask];
+        if (!conform(slot, _sourceLimit, nowNs)) {
+            return AdmissionResult::DROPPED_SOURCE;
+        }
+    }
+
+    if (_globalLimit.intervalNs > 0 && !conform(_globalSlot.theoreticalArrivalNs, _globalLimit, nowNs)) {
+        return AdmissionResult::DROPPED_GLOBAL;
+    }
+
+    return AdmissionResult::ADMITTED;
+}
+
+bool AdmissionController::isEnabled() const {
+    return _globalLimit.intervalNs > 0 || _sourceLimit.intervalNs > 0;
+}
+
+AdmissionController::Limit AdmissionController::makeLimit(uint32_t packetsPerSecond) {
+    Limit limit;
+    if (packetsPerSecond == 0) {
+        return limit;
+    }
+
+    // Всплеск - 1/10 секундного бюджета, но не меньше одного пакета
+    int64_t burst = std::max<int64_t>(packetsPerSecond / 10, 1);
+    limit.intervalNs = std::max<int64_t>(1000000000LL / packetsPerSecond, 1);
+    limit.toleranceNs = (burst - 1) * limit.intervalNs;
+    return limit;
+}
+
+bool AdmissionController::conform(std::atomic<int64_t>& state, const Limit& limit, int64_t nowNs) {
+    int64_t arrival = state.load(std::memory_order_relaxed);
+
+    while (true) {
+        // Простаивающее состояние не накапливает кредит сверх допустимого всплеска
+        int64_t base = std::max(arrival, nowNs);
+        if (base - nowNs > limit.toleranceNs) {
+            return false;
+        }
+        if (state.compare_exchange_weak(arrival, base + limit.intervalNs, std::memory_order_relaxed)) {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief Параметры допуска пакетов до обработки
+ *
+ * Допустимый всплеск каждого ограничения равен 1/10 секундного бюджета,
+ * но не меньше одного пакета (как в RateLimiter).
+ */
+struct AdmissionOptions {
+    uint32_t globalPacketsPerSecond = 0;   // Общий бюджет пакетов в секунду на сервер (0 - без ограничения)
+    uint32_t sourcePacketsPerSecond = 0;   // Бюджет пакетов в секунду на IP-адрес источника (0 - без ограничения)
+    size_t sourceSlots = 65536;            // Количество слотов таблицы источников (округляется до степени двойки)
+};
+
+/**
+ * @brief Результат проверки допуска пакета
+ */
+enum class AdmissionResult {
+    ADMITTED,           // Пакет допущен к обработке
+    DROPPED_SOURCE,     // Превышен бюджет IP-адреса источника
+    DROPPED_GLOBAL      // Превышен общий бюджет сервера
+};
+
+/**
+ * @brief Ранний допуск UDP-пакетов до декодирования
+ *
+ * Выполняется до разбора BCD и обращения к RateLimiter, поэтому поток
+ * пакетов со случайными IMSI от одного клиента отсекается, не создавая
+ * bucket'ов и сессий. Оба ограничения реализованы как GCRA (token bucket
+ * во временной форме): состояние - одно атомарное "теоретическое время
+ * прибытия", обновляемое CAS без блокировок.
+ *
+ * Источники хешируются в таблицу фиксированного размера без хранения
+ * адресов: память не зависит от числа клиентов, а редкие коллизии
+ * делят один бюджет между двумя адресами.
+ */
+class AdmissionController {
+public:
+    /**
+     * @brief Создает контроллер допуска
+     * @param options Параметры ограничений
+     * @throws std::invalid_argument если sourceSlots равно 0
+     */
+    explicit AdmissionController(const AdmissionOptions& options);
+
+    ~AdmissionController() = default;
+
+    // Запрещаем копирование и перемещение
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+    AdmissionController(AdmissionController&&) = delete;
+    AdmissionController& operator=(AdmissionController&&) = delete;
+
+    /**
+     * @brief Проверяет, можно ли обработать пакет от источника
+     * @param sourceAddress IPv4-адрес источника (в сетевом порядке байт, как в sockaddr_in)
+     * @return Результат проверки
+     */
+    [[nodiscard]] AdmissionResult admit(uint32_t sourceAddress);
+
+    /**
+     * @brief Проверяет, включено ли хотя бы одно ограничение
+     * @return true если пакеты могут отбрасываться, иначе false
+     */
+    [[nodiscard]] bool isEnabled() const;
+
+private:
+    /**
+     * @brief Параметры GCRA для одного ограничения
+     */
+    struct Limit {
+        int64_t intervalNs = 0;     // Интервал между пакетами при равномерном потоке, нс
+        int64_t toleranceNs = 0;    // Допустимое опережение графика (всплеск), нс
+    };
+
+    /**
+     * @brief Слот состояния, выровненный по кэш-линии
+     */
+    struct alignas(64) Slot {
+        std::atomic<int64_t> theoreticalArrivalNs{0}; // Теоретическое время прибытия следующего пакета
+    };
+
+    /**
+     * @brief Строит параметры GCRA по бюджету в секунду
+     * @param packetsPerSecond Бюджет пакетов в секунду (0 - без ограничения)
+     * @return Параметры ограничения
+     */
+    static Limit makeLimit(uint32_t packetsPerSecond);
+
+    /**
+     * @brief Выполняет шаг GCRA над состоянием
+     * @param state Теоретическое время прибытия
+     * @param limit Параметры ограничения
+     * @param nowNs Текущее время, нс
+     * @return true если пакет укладывается в бюджет
+     */
+    static bool conform(std::atomic<int64_t>& state, const Limit& limit, int64_t nowNs);
+
+    Limit _globalLimit;                             // Общее ограничение
+    Limit _sourceLimit;                             // Ограничение на источник
+    Slot _globalSlot;                               // Состояние общего ограничения
+    std::unique_ptr<std::atomic<int64_t>[]> _sourceSlots; // Состояния источников
+    size_t _sourceMask;                             // Маска индекса слота источника
+};
@@ -0,0 +1,86 @@
+#include <BcdImsiDecoder.h>
+#include <bit>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t LOW_NIBBLES = 0x0F0F0F0F0F0F0F0FULL;    // Младшие полубайты всех байтов
+constexpr uint64_t DIGIT_OVERFLOW = 0x0606060606060606ULL; // Прибавка, переносящая цифры 10..15 в бит 4
+constexpr uint64_t OVERFLOW_BITS = 0x1010101010101010ULL;  // Биты 4 всех байтов
+constexpr uint64_t IGNORED_NIBBLE = 0xF0ULL << 56;         // Старший полубайт последнего байта (после 15-й цифры)
+
+} // namespace
+
+std::optional<Imsi> BcdImsiDecoder::decode(const char* buffer, size_t length) noexcept {
+    if (length < MIN_PACKET_SIZE) {
+        return std::nullopt;
+    }
+
+    uint64_t word;
+    std::memcpy(&word, buffer + HEADER_SIZE, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) {
+        word = __builtin_bswap64(word);
+    }
+    // Байт i пакета - байт i слова; полубайт после 15-й цифры не участвует
+    word &= ~IGNORED_NIBBLE;
+
+    // Цифра больше 9 после прибавки 6 устанавливает бит 4 своего байта; переносов между байтами нет
+    const uint64_t low = word & LOW_NIBBLES;
+    const uint64_t high = (word >> 4) & LOW_NIBBLES;
+    if (((low + DIGIT_OVERFLOW) | (high + DIGIT_OVERFLOW)) & OVERFLOW_BITS) {
+        return std::nullopt;
+    }
+
+    // Меняем полубайты местами и разворачиваем байты: получаем 16 BCD-цифр
+    // d0 d1 ... d14 0 от старшей к младшей, сдвигом убираем нулевую 16-ю цифру
+    uint64_t bcd = __builtin_bswap64((low << 4) | high) >> 4;
+
+    // Попарно складываем соседние поля: 16 цифр -> 8 чисел до 99 -> 4 до 9999 -> 2 до 99999999
+    bcd = ((bcd >> 4) & LOW_NIBBLES) * 10 + (bcd & LOW_NIBBLES);
+    bcd = ((bcd >> 8) & 0x00FF00FF00FF00FFULL) * 100 + (bcd & 0x00FF00FF00FF00FFULL);
+    bcd = ((bcd >> 16) & 0x0000FFFF0000FFFFULL) * 10000 + (bcd & 0x0000FFFF0000FFFFULL);
+    const uint64_t value = (bcd >> 32) * 100000000ULL + (bcd & 0xFFFFFFFFULL);
+
+    return Imsi::fromValue(value);
+}
+
+std::optional<Imsi> BcdImsiDecoder::decodeScalar(const char* buffer, size_t length) noexcept {
+    if (length < HEADER_SIZE + IMSI_BYTES / 2) {
+        return std::nullopt;
+    }
+
+    // Каждый байт содержит две цифры: младший полубайт, затем старший
+    uint64_t value = 0;
+    size_t digits = 0;
+
+    for (size_t i = HEADER_SIZE; i < length && digits < Imsi::LENGTH; i++) {
+        auto byte = static_cast<uint8_t>(buffer[i]);
+
+        uint8_t digit1 = byte & 0x0F;
+        if (digit1 > 9) {
+            return std::nullopt;
+        }
+        value = value * 10 + digit1;
+        ++digits;
+
+        if (digits >= Imsi::LENGTH) {
+            break;
+        }
+
+        uint8_t digit2 = (byte >> 4) & 0x0F;
+        if (digit2 <= 9) {
+            value = value * 10 + digit2;
+            ++digits;
+        } else if (digit2 == 0x0F && i == length - 1) {
+            // Последний полубайт может быть заполнителем F
+            break;
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    if (digits != Imsi::LENGTH) {
+        return std::nullopt;
+    }
+    return Imsi::fromValue(value);
+}
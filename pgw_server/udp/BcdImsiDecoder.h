@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Imsi.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+/**
+ * @brief Декодер IMSI из BCD-формата UDP-запроса
+ *
+ * Формат пакета: 4 байта заголовка, затем 8 байт BCD, в каждом байте младший
+ * полубайт - очередная цифра, старший - следующая за ней. 15-я цифра лежит
+ * в младшем полубайте последнего байта, старший полубайт которого
+ * (обычно заполнитель F) не проверяется; байты после IMSI игнорируются.
+ *
+ * decode() проверяет и распаковывает все 8 байт как одно 64-битное слово
+ * (SWAR): проверка 15 цифр - одно сложение с маской, перевод в число -
+ * перестановка полубайтов, bswap и четыре умножения на попарно сложенных
+ * полях. Ветвлений по отдельным цифрам и выделений памяти нет.
+ * decodeScalar() - побайтовая эталонная реализация с той же семантикой,
+ * используется для сверки в тестах и в бенчмарках.
+ */
+class BcdImsiDecoder {
+public:
+    static constexpr size_t HEADER_SIZE = 4;                        // Размер заголовка перед IMSI
+    static constexpr size_t IMSI_BYTES = 8;                         // Размер IMSI в BCD
+    static constexpr size_t MIN_PACKET_SIZE = HEADER_SIZE + IMSI_BYTES; // Минимальный размер пакета с IMSI
+
+    BcdImsiDecoder() = delete;
+
+    /**
+     * @brief Декодирует IMSI словными операциями (SWAR)
+     * @param buffer Буфер пакета
+     * @param length Длина пакета
+     * @return IMSI или std::nullopt, если пакет короче MIN_PACKET_SIZE или цифра больше 9
+     */
+    [[nodiscard]] static std::optional<Imsi> decode(const char* buffer, size_t length) noexcept;
+
+    /**
+     * @brief Эталонное побайтовое декодирование IMSI
+     * @param buffer Буфер пакета
+     * @param length Длина пакета
+     * @return IMSI или std::nullopt (совпадает с decode() на любых входных данных)
+     */
+    [[nodiscard]] static std::optional<Imsi> decodeScalar(const char* buffer, size_t length) noexcept;
+};
@@ -1,4 +1,6 @@
 #include <UdpServer.h>
+#include <ServerMetrics.h>
+#include <BcdImsiDecoder.h>
 #include <utility>
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -9,12 +11,17 @@
 #include <stdexcept>
 #include <algorithm>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <cerrno>
+#include <functional>
 
 UdpServer::UdpServer(std::string  ip, uint16_t port,
                    std::shared_ptr<SessionManager> sessionManager,
-                   std::shared_ptr<Logger> logger)
+                   std::shared_ptr<Logger> logger,
+                   UdpServerOptions options)
     : _ip(std::move(ip)), _port(port),
+      _options(options),
+      _admission(std::make_unique<AdmissionController>(options.admission)),
       _sessionManager(std::move(sessionManager)),
       _logger(std::move(logger)) {
     
@@ -22,8 +29,22 @@ UdpServer::UdpServer(std::string  ip, uint16_t port,
     if (!_logger) throw std::invalid_argument("logger cannot be null");
     if (_port == 0) throw std::invalid_argument("port cannot be 0");
     if (_ip.empty()) throw std::invalid_argument("ip cannot be empty");
+    if (_options.workerCount == 0) throw std::invalid_argument("workerCount must be positive");
+    if (_options.batchSize == 0 || _options.batchSize > MAX_BATCH_SIZE) {
+        throw std::invalid_argument("batchSize must be in range 1.." + std::to_string(MAX_BATCH_SIZE));
+    }
+    
+    _logger->info("UDP server initialized on " + _ip + ":" + std::to_string(_port) +
+                  " with " + std::to_string(_options.workerCount) + " worker(s), batch size " +
+                  std::to_string(_options.batchSize) +
+                  (_options.edgeTriggered ? ", edge-triggered" : ", level-triggered") +
+                  (_options.responseMode == UdpResponseMode::BINARY ? ", binary responses" : ", text responses"));
     
-    _logger->info("UDP server initialized on " + _ip + ":" + std::to_string(_port));
+    if (_admission->isEnabled()) {
+        _logger->info("Admission control enabled: global " +
+                      std::to_string(_options.admission.globalPacketsPerSecond) + " pps, per source " +
+                      std::to_string(_options.admission.sourcePacketsPerSecond) + " pps (0 - unlimited)");
+    }
 }
 
 UdpServer::~UdpServer() {
@@ -36,54 +57,37 @@ bool UdpServer::start() {
         return false;
     }
     
-    // Создаем сокет
-    _socket = socket(AF_INET, SOCK_DGRAM, 0);
-    if (_socket < 0) {
-        _logger->error("Failed to create socket: " + std::string(strerror(errno)));
-        return false;
-    }
-    
-    // Настраиваем адрес сервера
-    struct sockaddr_in serverAddr{};
-    serverAddr.sin_family = AF_INET;
-    serverAddr.sin_port = htons(_port);
-    
-    // Преобразуем IP-адрес из строки в бинарный формат
-    if (inet_pton(AF_INET, _ip.c_str(), &serverAddr.sin_addr) <= 0) {
-        _logger->error("Invalid address: " + _ip + ", error: " + std::string(strerror(errno)));
-        close(_socket);
-        _socket = -1;
+    // Создаем eventfd для сигнала остановки, общий для всех рабочих потоков
+    _stopEventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (_stopEventFd < 0) {
+        _logger->error("Failed to create stop eventfd: " + std::string(strerror(errno)));
         return false;
     }
     
-    // Включаем повторное использование адреса
-    int reuse = 1;
-    if (setsockopt(_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
-        _logger->warn("Failed to set SO_REUSEADDR: " + std::string(strerror(errno)));
-    }
-    
-    // Привязываем сокет к адресу
-    if (bind(_socket, reinterpret_cast<struct sockaddr *>(&serverAddr), sizeof(serverAddr)) < 0) {
-        _logger->error("Bind failed for " + _ip + ":" + std::to_string(_port) + 
-                      ", error: " + std::string(strerror(errno)));
-        close(_socket);
-        _socket = -1;
-        return false;
-    }
-    
-    
-    // Настраиваем epoll
-    if (!setupEpollSocket()) {
-        close(_socket);
-        _socket = -1;
-        return false;
+    // Создаем сокеты и epoll для всех рабочих потоков до запуска потоков,
+    // чтобы ошибка привязки любого из них не оставляла сервер запущенным наполовину
+    for (size_t i = 0; i < _options.workerCount; ++i) {
+        auto worker = std::make_unique<Worker>();
+        worker->id = i;
+        if (_options.batchSize > 1) {
+            setupBatchBuffers(*worker);
+        }
+        _workers.push_back(std::move(worker));
+        
+        if (!setupWorkerSocket(*_workers.back()) || !setupEpollSocket(*_workers.back())) {
+            cleanupResources();
+            return false;
+        }
     }
     
-    // Запускаем серверный поток
+    // Запускаем рабочие потоки
     _running = true;
-    _serverThread = std::thread(&UdpServer::serverLoop, this);
+    for (auto& worker : _workers) {
+        worker->thread = std::thread(&UdpServer::serverLoop, this, std::ref(*worker));
+    }
     
-    _logger->info("UDP server started on " + _ip + ":" + std::to_string(_port));
+    _logger->info("UDP server started on " + _ip + ":" + std::to_string(_port) +
+                  " with " + std::to_string(_workers.size()) + " worker(s)");
     return true;
 }
 
@@ -94,8 +98,16 @@ void UdpServer::stop() {
     
     _running = false;
     
-    if (_serverThread.joinable()) {
-        _serverThread.join();
+    // Будим рабочие потоки, ожидающие в epoll_wait
+    uint64_t signal = 1;
+    if (write(_stopEventFd, &signal, sizeof(signal)) < 0) {
+        _logger->error("Failed to signal stop eventfd: " + std::string(strerror(errno)));
+    }
+    
+    for (auto& worker : _workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
     }
     
     cleanupResources();
@@ -107,14 +119,23 @@ bool UdpServer::isRunning() const {
     return _running;
 }
 
-void UdpServer::serverLoop() {
+void UdpServer::serverLoop(Worker& worker) {
     constexpr int MAX_EVENTS = 512; // для высоконагруженных систем 128-1024
+    const int idleTimeoutMs = static_cast<int>(ServerMetrics::FLUSH_INTERVAL.count());
     struct epoll_event events[MAX_EVENTS];
     char buffer[8 * 1024];
     
+    _logger->debug("UDP worker " + std::to_string(worker.id) + " started");
+    
     while (_running) {
-        // Ждем события с таймаутом 30 мс для высоконагруженных систем 10-50
-        int nfds = epoll_wait(_epollFd, events, MAX_EVENTS, 30);
+        // Остановка сигнализируется через eventfd; таймаут нужен только для того,
+        // чтобы простаивающий поток выгрузил накопленные задержки в метрики
+        int nfds = epoll_wait(worker.epollFd, events, MAX_EVENTS, idleTimeoutMs);
+        
+        if (nfds == 0) {
+            ServerMetrics::flushThreadLatency();
+            continue;
+        }
         
         if (nfds == -1) {
             if (errno == EINTR) {
@@ -127,196 +148,452 @@ void UdpServer::serverLoop() {
         }
         
         for (int i = 0; i < nfds; i++) {
-            if (events[i].data.fd == _socket) {
-                struct sockaddr_in clientAddr{};
-                socklen_t clientLen = sizeof(clientAddr);
-                
-                // Получаем данные от клиента
-                ssize_t bytesReceived = recvfrom(_socket, buffer, sizeof(buffer) - 1, 0,
-                                               reinterpret_cast<struct sockaddr *>(&clientAddr), &clientLen);
-                
-                if (bytesReceived < 0) {
-                    if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                        // Нет данных, продолжаем
-                        continue;
+            if (events[i].data.fd == _stopEventFd) {
+                // Сигнал остановки, eventfd не вычитываем, чтобы проснулись все рабочие потоки
+                continue;
+            }
+            
+            if (events[i].data.fd == worker.socket) {
+                if (_options.edgeTriggered) {
+                    // В режиме EPOLLET уведомление приходит один раз, читаем сокет до EAGAIN
+                    while (_running && receivePackets(worker, buffer, sizeof(buffer))) {
                     }
-                    
-                    _logger->error("Error receiving data: " + std::string(strerror(errno)));
-                    continue;
+                } else {
+                    receivePackets(worker, buffer, sizeof(buffer));
                 }
-                
-                if (bytesReceived == 0) {
-                    continue;
-                }
-                
-                // Обрабатываем полученный пакет
-                handleIncomingPacket(buffer, bytesReceived, clientAddr);
             }
         }
     }
+    
+    ServerMetrics::flushThreadLatency();
+    _logger->debug("UDP worker " + std::to_string(worker.id) + " stopped");
+}
+
+bool UdpServer::receivePackets(Worker& worker, char* buffer, size_t bufferSize) const {
+    if (_options.batchSize > 1) {
+        // Пакетный режим: recvmmsg/sendmmsg
+        return processBatch(worker);
+    }
+    
+    struct sockaddr_in clientAddr{};
+    socklen_t clientLen = sizeof(clientAddr);
+    
+    // Получаем данные от клиента; с MSG_TRUNC возвращается полная длина датаграммы
+    ssize_t bytesReceived = recvfrom(worker.socket, buffer, bufferSize - 1, MSG_TRUNC,
+                                   reinterpret_cast<struct sockaddr *>(&clientAddr), &clientLen);
+    
+    if (bytesReceived < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            // Нет данных
+            return false;
+        }
+        if (errno == EINTR) {
+            return true;
+        }
+        
+        // Ошибка одной датаграммы (ENOMEM, ICMP-ошибка) не опустошает сокет: в режиме EPOLLET
+        // остановка чтения оставила бы очередь без нового уведомления
+        _logger->error("Error receiving data: " + std::string(strerror(errno)));
+        return true;
+    }
+    
+    // Граница длины та же, что у слота пакетного режима: результат не зависит от udp_batch_size
+    if (static_cast<size_t>(bytesReceived) > BATCH_SLOT_SIZE) {
+        PGW_LOG_DEBUG(_logger, "Packet from {} dropped: datagram exceeds {} bytes",
+                      formatClientIp(clientAddr), BATCH_SLOT_SIZE);
+        return true;
+    }
+    
+    if (bytesReceived > 0) {
+        // Обрабатываем полученный пакет
+        handleIncomingPacket(worker.socket, buffer, bytesReceived, clientAddr);
+    }
+    
+    return true;
 }
 
-void UdpServer::handleIncomingPacket(const char* buffer, size_t length,
+void UdpServer::handleIncomingPacket(int socket, const char* buffer, size_t length,
                                    const struct sockaddr_in& clientAddr) const {
+    StageTimer timer;
+    auto code = processPacket(buffer, length, clientAddr);
+    if (code) {
+        // Этапы до ответа учтены таймером processPacket
+        timer.skip();
+        struct iovec vectors[MAX_RESPONSE_VECTORS];
+        size_t count = encodeResponse(*code, buffer, length, vectors);
+        sendResponse(socket, vectors, count, clientAddr);
+        timer.mark(LatencyStage::RESPONSE);
+        timer.finishRequest();
+    }
+}
+
+std::optional<ResponseCode> UdpServer::processPacket(const char* buffer, size_t length,
+                                                     const struct sockaddr_in& clientAddr) const {
+    StageTimer timer;
+    
+    // Контроль допуска до разбора пакета: отброшенный пакет не получает ответа,
+    // чтобы не тратить на флуд ни декодирование, ни исходящий трафик
+    auto admission = _admission->admit(clientAddr.sin_addr.s_addr);
+    timer.mark(LatencyStage::ADMISSION);
+    switch (admission) {
+        case AdmissionResult::DROPPED_SOURCE:
+            ServerMetrics::incAdmissionDroppedSource();
+            PGW_LOG_DEBUG(_logger, "Packet from {} dropped: source budget exceeded", formatClientIp(clientAddr));
+            return std::nullopt;
+        case AdmissionResult::DROPPED_GLOBAL:
+            ServerMetrics::incAdmissionDroppedGlobal();
+            PGW_LOG_DEBUG(_logger, "Packet from {} dropped: global budget exceeded", formatClientIp(clientAddr));
+            return std::nullopt;
+        default:
+            break;
+    }
+    
     try {
-        // Получаем IP-адрес клиента для логирования
-        char clientIp[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &(clientAddr.sin_addr), clientIp, INET_ADDRSTRLEN);
-        
         // Извлекаем IMSI из пакета
-        std::string imsi = extractImsiFromBcd(buffer, length);
+        auto imsi = extractImsiFromBcd(buffer, length);
+        timer.mark(LatencyStage::DECODE);
         
-        if (imsi.empty()) {
-            _logger->warn("Received packet with invalid IMSI format from " + std::string(clientIp));
-            sendResponse("rejected", clientAddr);
-            return;
+        if (!imsi) {
+            PGW_LOG_WARN(_logger, "Received packet with invalid IMSI format from {}", formatClientIp(clientAddr));
+            return ResponseCode::INVALID_REQUEST;
         }
         
-        _logger->info("Received request for IMSI: " + imsi + " from " + std::string(clientIp));
+        PGW_LOG_INFO(_logger, "Received request for IMSI: {} from {}", imsi->toString(), formatClientIp(clientAddr));
         
         // Создаем сессию через SessionManager
-        SessionResult result = _sessionManager->createSession(imsi);
+        SessionResult result = _sessionManager->createSession(*imsi);
+        timer.mark(LatencyStage::SESSION);
         
-        // Отправляем ответ клиенту
-        if (result == SessionResult::CREATED) {
-            sendResponse("created", clientAddr);
-                _logger->info("Session created for IMSI: " + imsi);
-        } else {
-                sendResponse("rejected", clientAddr);
-            _logger->info("Session rejected for IMSI: " + imsi + ", result: " + 
-                          (result == SessionResult::REJECTED ? "REJECTED" : "ERROR"));
+        // Формируем ответ клиенту
+        switch (result) {
+            case SessionResult::CREATED:
+                PGW_LOG_INFO(_logger, "Session created for IMSI: {}", imsi->toString());
+                return ResponseCode::CREATED;
+            case SessionResult::REFRESHED:
+                PGW_LOG_INFO(_logger, "Session refreshed for IMSI: {}", imsi->toString());
+                return ResponseCode::REFRESHED;
+            case SessionResult::REJECTED_BLACKLIST:
+                PGW_LOG_INFO(_logger, "Session rejected for IMSI: {}, result: BLACKLIST", imsi->toString());
+                return ResponseCode::REJECTED_BLACKLIST;
+            case SessionResult::REJECTED_RATE_LIMIT:
+                PGW_LOG_INFO(_logger, "Session rejected for IMSI: {}, result: RATE_LIMIT", imsi->toString());
+                return ResponseCode::REJECTED_RATE_LIMIT;
+            default:
+                PGW_LOG_INFO(_logger, "Session rejected for IMSI: {}, result: ERROR", imsi->toString());
+                return ResponseCode::ERROR;
         }
     } catch (const std::exception& e) {
-        _logger->error("Error handling packet: " + std::string(e.what()));
-        sendResponse("rejected", clientAddr);
+        PGW_LOG_ERROR(_logger, "Error handling packet: {}", e.what());
+        return ResponseCode::ERROR;
     }
 }
 
-std::string UdpServer::extractImsiFromBcd(const char* buffer, size_t length) const {
-    // Проверяем минимальную длину пакета
-    if (length < 8) {
-        _logger->warn("Packet too short for IMSI: " + std::to_string(length) + " bytes");
-        return "";
+size_t UdpServer::encodeResponse(ResponseCode code, const char* request, size_t length,
+                                 struct iovec* vectors) const {
+    // Заголовок запроса повторяется из приемного буфера, он жив до отправки ответа
+    const bool hasHeader = length >= RESPONSE_HEADER_SIZE;
+    vectors[0].iov_base = const_cast<char*>(hasHeader ? request : EMPTY_HEADER);
+    vectors[0].iov_len = RESPONSE_HEADER_SIZE;
+    
+    if (_options.responseMode == UdpResponseMode::TEXT) {
+        // Продленная сессия для текстового клиента неотличима от созданной
+        std::string_view text = code == ResponseCode::CREATED || code == ResponseCode::REFRESHED
+                                    ? RESPONSE_CREATED : RESPONSE_REJECTED;
+        
+        // Заголовок перед текстом - только для клиентов, нумерующих запросы
+        const bool correlated = hasHeader && static_cast<uint8_t>(request[0]) == HEADER_VERSION_CORRELATED;
+        auto& textVector = vectors[correlated ? 1 : 0];
+        textVector.iov_base = const_cast<char*>(text.data());
+        textVector.iov_len = text.size();
+        return correlated ? 2 : 1;
     }
     
-    // Пропускаем первые 4 байта заголовка
-    const size_t headerSize = 4;
+    vectors[1].iov_base = const_cast<char*>(&RESPONSE_CODES[static_cast<uint8_t>(code)]);
+    vectors[1].iov_len = 1;
+    return 2;
+}
+
+bool UdpServer::processBatch(Worker& worker) const {
+    const size_t batchSize = _options.batchSize;
     
-    // Декодируем IMSI из BCD формата
-    // BCD формат: каждый байт содержит две цифры кроме последнего
-    std::string imsi;
-    imsi.reserve(15); 
+    // Ядро перезаписывает длину адреса и флаги, поэтому восстанавливаем их перед каждым вызовом
+    for (size_t i = 0; i < batchSize; ++i) {
+        worker.recvMessages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        worker.recvMessages[i].msg_hdr.msg_flags = 0;
+        worker.recvMessages[i].msg_len = 0;
+    }
     
-    // Отладочный вывод для анализа байтов
-    std::string hexDump;
-    for (size_t i = 0; i < length; i++) {
-        char hex[8];
-        snprintf(hex, sizeof(hex), "%02x ", static_cast<unsigned char>(buffer[i]));
-        hexDump += hex;
+    // Забираем до batchSize датаграмм одним системным вызовом
+    int received = recvmmsg(worker.socket, worker.recvMessages.data(),
+                            static_cast<unsigned int>(batchSize), 0, nullptr);
+    
+    if (received < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return false;
+        }
+        // Как и в одиночном режиме, после ошибки сокет читается дальше до EAGAIN
+        if (errno != EINTR) {
+            _logger->error("Error receiving data batch: " + std::string(strerror(errno)));
+        }
+        return true;
     }
-    _logger->debug("Raw packet bytes: " + hexDump);
     
-    // Декодируем IMSI из BCD формата
-    for (size_t i = headerSize; i < length && imsi.length() < 15; i++) {
-        auto byte = static_cast<uint8_t>(buffer[i]);
+    // Все пакеты пачки получены одновременно, их полная задержка отсчитывается от recvmmsg
+    StageTimer timer;
+    
+    // Обрабатываем пакеты и собираем ответы для одного вызова sendmmsg
+    size_t replies = 0;
+    for (int i = 0; i < received; ++i) {
+        const auto& message = worker.recvMessages[i];
+        if (message.msg_len == 0) {
+            continue;
+        }
         
-        // Извлекаем младшую цифру (4 младших бита)
-        uint8_t digit1 = byte & 0x0F;
-        if (digit1 <= 9) {
-            imsi.push_back('0' + digit1);
-        } else {
-            _logger->warn("Invalid BCD digit in IMSI: " + std::to_string(digit1));
-            return "";
+        // Датаграмма длиннее слота обрезана ядром: ее хвост потерян, поэтому пакет отбрасывается без ответа
+        if (message.msg_hdr.msg_flags & MSG_TRUNC) {
+            PGW_LOG_DEBUG(_logger, "Packet from {} dropped: datagram exceeds {} bytes",
+                          formatClientIp(worker.clientAddrs[i]), BATCH_SLOT_SIZE);
+            continue;
         }
         
-        // Если уже набрали 15 цифр, выходим
-        if (imsi.length() >= 15) {
-            break;
+        const auto* request = static_cast<const char*>(message.msg_hdr.msg_iov->iov_base);
+        auto code = processPacket(request, message.msg_len, worker.clientAddrs[i]);
+        if (!code) {
+            continue;
         }
         
-        // Извлекаем старшую цифру (4 старших бита)
-        uint8_t digit2 = (byte >> 4) & 0x0F;
-        if (digit2 <= 9) {
-            imsi.push_back('0' + digit2);
-        } else if (digit2 == 0x0F && i == length - 1) {
-            // Последний полубайт может быть заполнителем F
+        auto* vectors = &worker.sendVectors[replies * MAX_RESPONSE_VECTORS];
+        size_t count = encodeResponse(*code, request, message.msg_len, vectors);
+        
+        auto& reply = worker.sendMessages[replies];
+        reply.msg_hdr = {};
+        reply.msg_hdr.msg_name = &worker.clientAddrs[i];
+        reply.msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        reply.msg_hdr.msg_iov = vectors;
+        reply.msg_hdr.msg_iovlen = count;
+        reply.msg_len = 0;
+        ++replies;
+    }
+    
+    // Отправляем все ответы пачкой, досылая остаток при частичной отправке
+    timer.skip();
+    size_t sent = 0;
+    while (sent < replies) {
+        int result = sendmmsg(worker.socket, worker.sendMessages.data() + sent,
+                              static_cast<unsigned int>(replies - sent), 0);
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            _logger->error("Error sending response batch: " + std::string(strerror(errno)) +
+                           ", dropped " + std::to_string(replies - sent) + " response(s)");
             break;
-        } else {
-            _logger->warn("Invalid BCD digit in IMSI: " + std::to_string(digit2));
-            return "";
         }
+        sent += static_cast<size_t>(result);
     }
     
-    // Проверяем, что IMSI имеет правильную длину (15 цифр)
-    if (imsi.length() != 15) {
-        _logger->warn("Invalid IMSI length: " + std::to_string(imsi.length()));
-        return "";
+    // Каждый отправленный ответ ждал всю пачку: учитываем его с длительностью sendmmsg
+    if (sent > 0) {
+        timer.mark(LatencyStage::RESPONSE, sent);
+        timer.finishRequest(sent);
     }
     
-    _logger->debug("Decoded IMSI from BCD: " + imsi);
+    PGW_LOG_DEBUG(_logger, "Processed batch of {} datagram(s), sent {} response(s)", received, sent);
+    return true;
+}
+
+std::optional<Imsi> UdpServer::extractImsiFromBcd(const char* buffer, size_t length) const {
+    // Проверяем минимальную длину пакета: заголовок и 8 байт BCD
+    if (length < BcdImsiDecoder::MIN_PACKET_SIZE) {
+        PGW_LOG_WARN(_logger, "Packet too short for IMSI: {} bytes", length);
+        return std::nullopt;
+    }
+    
+    // Отладочный вывод для анализа байтов (строится только при включенном DEBUG)
+    PGW_LOG_DEBUG(_logger, "Raw packet bytes: {}", formatHexDump(buffer, length));
+    
+    auto imsi = BcdImsiDecoder::decode(buffer, length);
+    if (!imsi) {
+        PGW_LOG_WARN(_logger, "Invalid BCD digit in IMSI: {}",
+                     formatHexDump(buffer + BcdImsiDecoder::HEADER_SIZE, BcdImsiDecoder::IMSI_BYTES));
+        return std::nullopt;
+    }
+    
+    PGW_LOG_DEBUG(_logger, "Decoded IMSI from BCD: {}", imsi->toString());
     return imsi;
 }
 
-void UdpServer::sendResponse(const std::string& response,
+std::string UdpServer::formatClientIp(const struct sockaddr_in& clientAddr) {
+    char clientIp[INET_ADDRSTRLEN];
+    inet_ntop(AF_INET, &(clientAddr.sin_addr), clientIp, INET_ADDRSTRLEN);
+    return clientIp;
+}
+
+std::string UdpServer::formatHexDump(const char* buffer, size_t length) {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+    
+    std::string hexDump;
+    hexDump.reserve(length * 3);
+    for (size_t i = 0; i < length; i++) {
+        auto byte = static_cast<unsigned char>(buffer[i]);
+        hexDump += HEX_DIGITS[byte >> 4];
+        hexDump += HEX_DIGITS[byte & 0x0F];
+        hexDump += ' ';
+    }
+    return hexDump;
+}
+
+void UdpServer::sendResponse(int socket, const struct iovec* vectors, size_t count,
                            const struct sockaddr_in& clientAddr) const {
-    ssize_t bytesSent = sendto(_socket, response.c_str(), response.length(), 0,
-                             reinterpret_cast<const struct sockaddr*>(&clientAddr), sizeof(clientAddr));
+    struct msghdr message{};
+    message.msg_name = const_cast<struct sockaddr_in*>(&clientAddr);
+    message.msg_namelen = sizeof(clientAddr);
+    message.msg_iov = const_cast<struct iovec*>(vectors);
+    message.msg_iovlen = count;
+    
+    ssize_t bytesSent = sendmsg(socket, &message, 0);
     
     if (bytesSent < 0) {
-        char clientIp[INET_ADDRSTRLEN];
-        inet_ntop(AF_INET, &(clientAddr.sin_addr), clientIp, INET_ADDRSTRLEN);
-        _logger->error("Error sending response to " + std::string(clientIp) + ": " + std::string(strerror(errno)));
+        PGW_LOG_ERROR(_logger, "Error sending response to {}: {}", formatClientIp(clientAddr), strerror(errno));
     } else {
-        _logger->debug("Sent response: " + response);
+        PGW_LOG_DEBUG(_logger, "Sent {}-byte response to {}", bytesSent, formatClientIp(clientAddr));
+    }
+}
+
+void UdpServer::setupBatchBuffers(Worker& worker) const {
+    const size_t batchSize = _options.batchSize;
+    
+    worker.recvBuffer.assign(batchSize * BATCH_SLOT_SIZE, 0);
+    worker.recvVectors.resize(batchSize);
+    worker.recvMessages.resize(batchSize);
+    worker.clientAddrs.resize(batchSize);
+    worker.sendVectors.resize(batchSize * MAX_RESPONSE_VECTORS);
+    worker.sendMessages.resize(batchSize);
+    
+    // Каждое сообщение пакета получает свой слот буфера и свой адрес отправителя
+    for (size_t i = 0; i < batchSize; ++i) {
+        worker.recvVectors[i].iov_base = worker.recvBuffer.data() + i * BATCH_SLOT_SIZE;
+        worker.recvVectors[i].iov_len = BATCH_SLOT_SIZE;
+        
+        auto& header = worker.recvMessages[i].msg_hdr;
+        header = {};
+        header.msg_name = &worker.clientAddrs[i];
+        header.msg_namelen = sizeof(struct sockaddr_in);
+        header.msg_iov = &worker.recvVectors[i];
+        header.msg_iovlen = 1;
+    }
+}
+
+bool UdpServer::setupWorkerSocket(Worker& worker) const {
+    // Создаем сокет
+    worker.socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (worker.socket < 0) {
+        _logger->error("Failed to create socket: " + std::string(strerror(errno)));
+        return false;
+    }
+    
+    // Настраиваем адрес сервера
+    struct sockaddr_in serverAddr{};
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_port = htons(_port);
+    
+    // Преобразуем IP-адрес из строки в бинарный формат
+    if (inet_pton(AF_INET, _ip.c_str(), &serverAddr.sin_addr) <= 0) {
+        _logger->error("Invalid address: " + _ip + ", error: " + std::string(strerror(errno)));
+        return false;
+    }
+    
+    // Включаем повторное использование адреса
+    int reuse = 1;
+    if (setsockopt(worker.socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse)) < 0) {
+        _logger->warn("Failed to set SO_REUSEADDR: " + std::string(strerror(errno)));
+    }
+    
+    // Несколько рабочих потоков разделяют один порт через SO_REUSEPORT,
+    // ядро балансирует датаграммы между сокетами по хешу адресов
+    if (_options.workerCount > 1 &&
+        setsockopt(worker.socket, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0) {
+        _logger->error("Failed to set SO_REUSEPORT: " + std::string(strerror(errno)));
+        return false;
+    }
+    
+    // Привязываем сокет к адресу
+    if (bind(worker.socket, reinterpret_cast<struct sockaddr *>(&serverAddr), sizeof(serverAddr)) < 0) {
+        _logger->error("Bind failed for " + _ip + ":" + std::to_string(_port) + 
+                      ", error: " + std::string(strerror(errno)));
+        return false;
     }
+    
+    return true;
 }
 
-bool UdpServer::setupEpollSocket() {
+bool UdpServer::setupEpollSocket(Worker& worker) const {
     // Делаем сокет неблокирующим
-    int flags = fcntl(_socket, F_GETFL, 0);
+    int flags = fcntl(worker.socket, F_GETFL, 0);
     if (flags == -1) {
         _logger->error("Failed to get socket flags: " + std::string(strerror(errno)));
         return false;
     }
     
-    if (fcntl(_socket, F_SETFL, flags | O_NONBLOCK) == -1) {
+    if (fcntl(worker.socket, F_SETFL, flags | O_NONBLOCK) == -1) {
         _logger->error("Failed to set non-blocking mode: " + std::string(strerror(errno)));
         return false;
     }
     
     // Создаем epoll инстанс
-    _epollFd = epoll_create1(0);
-    if (_epollFd == -1) {
+    worker.epollFd = epoll_create1(0);
+    if (worker.epollFd == -1) {
         _logger->error("Failed to create epoll instance: " + std::string(strerror(errno)));
         return false;
     }
     
-    // Добавляем сокет в epoll
+    // Добавляем сокет в epoll (в режиме EPOLLET сокет вычитывается до EAGAIN)
     struct epoll_event ev{};
     ev.events = EPOLLIN;
-    ev.data.fd = _socket;
+    if (_options.edgeTriggered) {
+        ev.events |= EPOLLET;
+    }
+    ev.data.fd = worker.socket;
     
-    if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, _socket, &ev) == -1) {
+    if (epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, worker.socket, &ev) == -1) {
         _logger->error("Failed to add socket to epoll: " + std::string(strerror(errno)));
-        close(_epollFd);
-        _epollFd = -1;
         return false;
     }
     
-    _logger->debug("Socket configured for epoll");
+    // Добавляем eventfd остановки (level-triggered: один сигнал будит все рабочие потоки)
+    struct epoll_event stopEv{};
+    stopEv.events = EPOLLIN;
+    stopEv.data.fd = _stopEventFd;
+    
+    if (epoll_ctl(worker.epollFd, EPOLL_CTL_ADD, _stopEventFd, &stopEv) == -1) {
+        _logger->error("Failed to add stop eventfd to epoll: " + std::string(strerror(errno)));
+        return false;
+    }
+    
+    _logger->debug("Socket configured for epoll (worker " + std::to_string(worker.id) + ")");
     return true;
 }
 
 void UdpServer::cleanupResources() {
-    // Закрываем epoll
-    if (_epollFd >= 0) {
-        close(_epollFd);
-        _epollFd = -1;
+    for (auto& worker : _workers) {
+        // Закрываем epoll
+        if (worker->epollFd >= 0) {
+            close(worker->epollFd);
+            worker->epollFd = -1;
+        }
+        
+        // Закрываем сокет
+        if (worker->socket >= 0) {
+            close(worker->socket);
+            worker->socket = -1;
+        }
     }
     
-    // Закрываем сокет
-    if (_socket >= 0) {
-        close(_socket);
-        _socket = -1;
+    _workers.clear();
+    
+    // Закрываем eventfd остановки
+    if (_stopEventFd >= 0) {
+        close(_stopEventFd);
+        _stopEventFd = -1;
     }
-} 
\ No newline at end of file
+}
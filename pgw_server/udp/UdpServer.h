@@ -1,12 +1,50 @@
 #pragma once
 
 #include <SessionManager.h>
+#include <AdmissionController.h>
 #include <Logger.h>
+#include <Imsi.h>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <vector>
+#include <optional>
 #include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+/**
+ * @brief Формат ответа UDP-сервера
+ */
+enum class UdpResponseMode {
+    TEXT,       // Строка "created" или "rejected" (совместим с pgw_client); для заголовка версии 2 - после заголовка запроса
+    BINARY      // 4 байта заголовка запроса и 1 байт кода результата ResponseCode
+};
+
+/**
+ * @brief Код результата в бинарном ответе
+ */
+enum class ResponseCode : uint8_t {
+    CREATED = 0,                // Создана новая сессия
+    REFRESHED = 1,              // Сессия уже существовала, срок действия продлен
+    REJECTED_BLACKLIST = 2,     // Отклонено: IMSI в черном списке
+    REJECTED_RATE_LIMIT = 3,    // Отклонено: превышено ограничение скорости
+    ERROR = 4,                  // Внутренняя ошибка сервера
+    INVALID_REQUEST = 5         // Пакет не содержит корректного IMSI
+};
+
+/**
+ * @brief Параметры работы UDP-сервера
+ */
+struct UdpServerOptions {
+    size_t workerCount = 1;  // Количество рабочих потоков, у каждого свой сокет (SO_REUSEPORT) и epoll
+    size_t batchSize = 1;    // Количество датаграмм на один recvmmsg/sendmmsg (1 - recvfrom/sendto на каждый пакет)
+    bool edgeTriggered = false; // Режим EPOLLET: на каждое пробуждение сокет вычитывается до EAGAIN
+    AdmissionOptions admission; // Ранний допуск пакетов по общему бюджету и бюджету источника
+    UdpResponseMode responseMode = UdpResponseMode::TEXT; // Формат ответов
+};
 
 /**
  * @brief UDP-сервер для обработки запросов клиентов
@@ -14,7 +52,24 @@
  * Предоставляет UDP интерфейс для взаимодействия с клиентами Mini-PGW.
  * Отвечает за прием UDP-запросов на создание сессий абонентов,
  * их обработку и отправку ответов клиентам.
- * Использует epoll для обработки запросов.
+ * Использует epoll для обработки запросов. При workerCount > 1 каждый рабочий
+ * поток открывает собственный сокет с SO_REUSEPORT на том же адресе,
+ * и ядро распределяет датаграммы между потоками.
+ * При batchSize > 1 датаграммы читаются пачками через recvmmsg,
+ * а ответы на всю пачку отправляются одним вызовом sendmmsg.
+ * Остановка сигнализируется через eventfd; таймаут epoll_wait нужен только
+ * простаивающим потокам, чтобы выгрузить накопленные гистограммы задержек.
+ * Длительность этапов (допуск, декодирование, сессия, ответ) и полная задержка
+ * запроса учитываются в ServerMetrics через StageTimer; в пакетном режиме
+ * полная задержка отсчитывается от recvmmsg пачки до завершения sendmmsg.
+ * До декодирования IMSI пакет проходит контроль допуска; отброшенные
+ * пакеты остаются без ответа и учитываются в метриках.
+ * Ответы не формируются на каждый запрос: текстовый ответ ссылается на статическую
+ * строку, а бинарный собирается из двух iovec - заголовка запроса в приемном
+ * буфере (идентификатор корреляции) и статического байта кода результата.
+ * Заголовок версии 2 (первый байт 0x02) несет в остальных трех байтах номер
+ * запроса клиента; такой заголовок повторяется и перед текстовым ответом, чтобы
+ * клиент с несколькими запросами в полете мог сопоставить ответы.
  */
 class UdpServer {
 public:
@@ -24,11 +79,13 @@ public:
      * @param port Порт для прослушивания
      * @param sessionManager Указатель на менеджер сессий
      * @param logger Указатель на логгер
+     * @param options Параметры работы сервера
      */
     UdpServer(std::string  ip,
               uint16_t port,
               std::shared_ptr<SessionManager> sessionManager,
-              std::shared_ptr<Logger> logger);
+              std::shared_ptr<Logger> logger,
+              UdpServerOptions options = {});
     
     /**
      * @brief Деструктор, останавливает сервер
@@ -58,54 +115,156 @@ public:
      */
     [[nodiscard]] bool isRunning() const;
 
+    static constexpr size_t MAX_BATCH_SIZE = 1024;  // Ограничение ядра на vlen (UIO_MAXIOV)
+    static constexpr size_t BATCH_SLOT_SIZE = 2048; // Максимальная длина датаграммы и размер слота пакетного режима (длиннее - отбрасываются)
+    static constexpr size_t RESPONSE_HEADER_SIZE = 4;  // Размер заголовка запроса, повторяемого в бинарном ответе
+    static constexpr size_t BINARY_RESPONSE_SIZE = RESPONSE_HEADER_SIZE + 1; // Размер бинарного ответа
+    static constexpr uint8_t HEADER_VERSION_CORRELATED = 0x02; // Версия заголовка с номером запроса в байтах 1-3
+
 private:
+    static constexpr size_t MAX_RESPONSE_VECTORS = 2; // Максимум iovec на один ответ
+    static constexpr std::string_view RESPONSE_CREATED = "created";
+    static constexpr std::string_view RESPONSE_REJECTED = "rejected";
+    static constexpr char RESPONSE_CODES[] = {0, 1, 2, 3, 4, 5}; // Статические байты кодов ResponseCode
+    static constexpr char EMPTY_HEADER[RESPONSE_HEADER_SIZE] = {}; // Заголовок ответа на пакет короче заголовка
+
     /**
-     * @brief Основной цикл сервера
+     * @brief Рабочий поток сервера со своим сокетом и epoll
      */
-    void serverLoop();
+    struct Worker {
+        size_t id = 0;          // Номер рабочего потока
+        int socket = -1;        // Дескриптор сокета
+        int epollFd = -1;       // Дескриптор epoll
+        std::thread thread;     // Поток обработки
+        
+        // Буферы пакетного режима (выделяются один раз при запуске)
+        std::vector<char> recvBuffer;                 // Слоты под входящие датаграммы
+        std::vector<struct iovec> recvVectors;        // iovec для входящих датаграмм
+        std::vector<struct mmsghdr> recvMessages;     // Заголовки recvmmsg
+        std::vector<struct sockaddr_in> clientAddrs;  // Адреса отправителей
+        std::vector<struct iovec> sendVectors;        // iovec для ответов (MAX_RESPONSE_VECTORS на ответ)
+        std::vector<struct mmsghdr> sendMessages;     // Заголовки sendmmsg
+    };
+
+    /**
+     * @brief Основной цикл рабочего потока
+     * @param worker Рабочий поток
+     */
+    void serverLoop(Worker& worker);
+    
+    /**
+     * @brief Читает и обрабатывает очередную порцию датаграмм (одну или пачку)
+     * @param worker Рабочий поток
+     * @param buffer Буфер для одиночного режима
+     * @param bufferSize Размер буфера
+     * @return false только при EAGAIN/EWOULDBLOCK (сокет пуст), иначе true: после записанной в лог ошибки чтение продолжается
+     */
+    bool receivePackets(Worker& worker, char* buffer, size_t bufferSize) const;
     
     /**
      * @brief Обрабатывает входящий UDP-пакет
+     * @param socket Сокет, на который пришел пакет
      * @param buffer Буфер с данными
      * @param length Длина данных
      * @param clientAddr Адрес клиента
      */
-    void handleIncomingPacket(const char* buffer, size_t length,
+    void handleIncomingPacket(int socket, const char* buffer, size_t length,
                              const struct sockaddr_in& clientAddr) const;
     
+    /**
+     * @brief Обрабатывает запрос и возвращает результат для ответа клиенту
+     * @param buffer Буфер с данными
+     * @param length Длина данных
+     * @param clientAddr Адрес клиента
+     * @return Код результата или std::nullopt, если пакет отброшен без ответа
+     */
+    [[nodiscard]] std::optional<ResponseCode> processPacket(const char* buffer, size_t length,
+                                                            const struct sockaddr_in& clientAddr) const;
+    
+    /**
+     * @brief Заполняет iovec ответа из статических буферов без копирования
+     * @param code Код результата
+     * @param request Буфер запроса (из него берется повторяемый заголовок)
+     * @param length Длина запроса
+     * @param vectors Массив из MAX_RESPONSE_VECTORS элементов для заполнения
+     * @return Количество заполненных iovec
+     */
+    size_t encodeResponse(ResponseCode code, const char* request, size_t length, struct iovec* vectors) const;
+    
+    /**
+     * @brief Читает пачку датаграмм через recvmmsg, обрабатывает и отвечает через sendmmsg
+     * @param worker Рабочий поток
+     * @return false только при EAGAIN/EWOULDBLOCK (сокет пуст), иначе true: после записанной в лог ошибки чтение продолжается
+     */
+    bool processBatch(Worker& worker) const;
+    
     /**
      * @brief Извлекает IMSI из BCD-формата
+     * 
+     * Декодирование выполняет BcdImsiDecoder словными операциями без выделений памяти.
      * @param buffer Буфер с данными
      * @param length Длина данных
-     * @return IMSI в виде строки или пустая строка в случае ошибки
+     * @return IMSI или std::nullopt в случае ошибки
      */
-    [[nodiscard]] std::string extractImsiFromBcd(const char* buffer, size_t length) const;
+    [[nodiscard]] std::optional<Imsi> extractImsiFromBcd(const char* buffer, size_t length) const;
     
     /**
      * @brief Отправляет ответ клиенту
-     * @param response Ответ для отправки
+     * @param socket Сокет для отправки
+     * @param vectors Части ответа
+     * @param count Количество частей
      * @param clientAddr Адрес клиента
      */
-    void sendResponse(const std::string& response,
+    void sendResponse(int socket, const struct iovec* vectors, size_t count,
                      const struct sockaddr_in& clientAddr) const;
     
+    /**
+     * @brief Возвращает IP-адрес клиента строкой (только для логирования)
+     * @param clientAddr Адрес клиента
+     * @return IP-адрес в точечной нотации
+     */
+    [[nodiscard]] static std::string formatClientIp(const struct sockaddr_in& clientAddr);
+    
+    /**
+     * @brief Возвращает шестнадцатеричный дамп пакета (только для логирования)
+     * @param buffer Буфер с данными
+     * @param length Длина данных
+     * @return Байты в виде "xx xx ..."
+     */
+    [[nodiscard]] static std::string formatHexDump(const char* buffer, size_t length);
+    
+    /**
+     * @brief Выделяет буферы пакетного режима для рабочего потока
+     * @param worker Рабочий поток
+     */
+    void setupBatchBuffers(Worker& worker) const;
+    
+    /**
+     * @brief Создает и привязывает сокет рабочего потока
+     * @param worker Рабочий поток
+     * @return true если сокет создан и привязан, иначе false
+     */
+    bool setupWorkerSocket(Worker& worker) const;
+    
     /**
      * @brief Настраивает неблокирующий сокет и epoll
+     * @param worker Рабочий поток
      * @return true если настройка успешна, иначе false
      */
-    bool setupEpollSocket();
+    bool setupEpollSocket(Worker& worker) const;
     
     /**
-     * @brief Закрывает сокет и освобождает ресурсы epoll
+     * @brief Закрывает сокеты и освобождает ресурсы epoll всех рабочих потоков
      */
     void cleanupResources();
 
     std::string _ip;                // IP-адрес для прослушивания
     uint16_t _port;                 // Порт для прослушивания
-    int _socket = -1;               // Дескриптор сокета
-    int _epollFd = -1;              // Дескриптор epoll
+    UdpServerOptions _options;      // Параметры работы сервера
     std::atomic<bool> _running{false}; // Флаг работы сервера
-    std::thread _serverThread;      // Поток сервера
+    int _stopEventFd = -1;          // eventfd для сигнала остановки рабочим потокам
+    std::vector<std::unique_ptr<Worker>> _workers; // Рабочие потоки
+    std::unique_ptr<AdmissionController> _admission; // Контроль допуска пакетов
 
     std::shared_ptr<SessionManager> _sessionManager; // Менеджер сессий
     std::shared_ptr<Logger> _logger;                 // Логгер
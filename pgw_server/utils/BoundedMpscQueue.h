@@ -0,0 +1,133 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * @brief Ограниченная lock-free очередь с несколькими производителями и одним потребителем
+ * 
+ * Кольцевой буфер с порядковым номером в каждой ячейке (схема Д. Вьюкова):
+ * производители резервируют позицию одним CAS по _tail, потребитель читает
+ * без атомарных RMW-операций. Емкость округляется вверх до степени двойки.
+ * 
+ * @tparam T Тип элемента (должен быть перемещаемым и конструируемым по умолчанию)
+ */
+template<typename T>
+class BoundedMpscQueue {
+public:
+    /**
+     * @brief Создает очередь
+     * @param capacity Минимальная емкость очереди
+     * @throws std::invalid_argument если capacity равна 0
+     */
+    explicit BoundedMpscQueue(size_t capacity)
+        : _capacity(roundUpToPowerOfTwo(capacity)),
+          _mask(_capacity - 1),
+          _cells(std::make_unique<Cell[]>(_capacity))
+    {
+        for (size_t i = 0; i < _capacity; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~BoundedMpscQueue() = default;
+
+    // Запрещаем копирование и перемещение
+    BoundedMpscQueue(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue& operator=(const BoundedMpscQueue&) = delete;
+    BoundedMpscQueue(BoundedMpscQueue&&) = delete;
+    BoundedMpscQueue& operator=(BoundedMpscQueue&&) = delete;
+
+    /**
+     * @brief Добавляет элемент в очередь (потокобезопасно для нескольких производителей)
+     * @param value Элемент для добавления (перемещается только при успехе)
+     * @return true если элемент добавлен, false если очередь заполнена
+     */
+    bool tryPush(T& value) {
+        size_t pos = _tail.load(std::memory_order_relaxed);
+        
+        while (true) {
+            Cell& cell = _cells[pos & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+            
+            if (diff == 0) {
+                // Ячейка свободна: пытаемся зарезервировать позицию
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // Ячейка еще не прочитана потребителем: очередь заполнена
+                return false;
+            } else {
+                // Позицию занял другой производитель
+                pos = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Извлекает элемент из очереди (только из одного потока-потребителя)
+     * @return Элемент или std::nullopt, если очередь пуста
+     */
+    std::optional<T> tryPop() {
+        Cell& cell = _cells[_head & _mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        
+        if (sequence != _head + 1) {
+            return std::nullopt;
+        }
+        
+        std::optional<T> value(std::move(cell.value));
+        cell.sequence.store(_head + _capacity, std::memory_order_release);
+        ++_head;
+        return value;
+    }
+
+    /**
+     * @brief Возвращает емкость очереди
+     * @return Емкость (степень двойки)
+     */
+    [[nodiscard]] size_t capacity() const noexcept {
+        return _capacity;
+    }
+
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64; // Размер кеш-линии для разделения горячих полей
+
+    /**
+     * @brief Ячейка кольцевого буфера
+     */
+    struct Cell {
+        std::atomic<size_t> sequence{0}; // Порядковый номер ячейки
+        T value{};                       // Хранимый элемент
+    };
+
+    /**
+     * @brief Округляет значение вверх до степени двойки
+     * @param value Исходное значение
+     * @return Ближайшая степень двойки, не меньшая value
+     * @throws std::invalid_argument если value равно 0
+     */
+    static size_t roundUpToPowerOfTwo(size_t value) {
+        if (value == 0) throw std::invalid_argument("capacity must be positive");
+        
+        size_t result = 1;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    const size_t _capacity;                                     // Емкость очереди
+    const size_t _mask;                                         // Маска индекса
+    std::unique_ptr<Cell[]> _cells;                             // Кольцевой буфер
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> _tail{0};      // Следующая позиция записи (производители)
+    alignas(CACHE_LINE_SIZE) size_t _head = 0;                  // Следующая позиция чтения (потребитель)
+};
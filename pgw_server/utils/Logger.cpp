@@ -2,11 +2,37 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/async.h>
+#include <ServerMetrics.h>
 #include <iostream>
+#include <stdexcept>
 
-Logger::Logger(const std::string& logFile, LogLevel level)
-    : _logFile(logFile), _logLevel(level), _logToFile(!logFile.empty()), _isHealthy(true) {
+Logger::Logger(const std::string& logFile, LogLevel level, const LoggerOptions& options)
+    : _logFile(logFile), _logLevel(level), _logToFile(!logFile.empty()), _isHealthy(true), _options(options) {
+    if (_options.async && _options.queueSize == 0) {
+        throw std::invalid_argument("Logger queue size must be positive");
+    }
+    
     try {
+        // В асинхронном режиме запись в sink'и выполняет отдельный поток
+        if (_options.async) {
+            _threadPool = std::make_shared<spdlog::details::thread_pool>(_options.queueSize, 1);
+        }
+        
+        // Создает синхронный или асинхронный логгер над заданными sink'ами
+        auto makeLogger = [this](const std::string& name, std::vector<spdlog::sink_ptr> sinks)
+            -> std::shared_ptr<spdlog::logger> {
+            if (!_threadPool) {
+                return std::make_shared<spdlog::logger>(name, sinks.begin(), sinks.end());
+            }
+            
+            // DROP_NEW реализуется в admitMessage, поэтому очередь spdlog в этом режиме блокирующая
+            auto policy = _options.overflowPolicy == LogOverflowPolicy::DROP_OLDEST
+                ? spdlog::async_overflow_policy::overrun_oldest
+                : spdlog::async_overflow_policy::block;
+            return std::make_shared<spdlog::async_logger>(name, sinks.begin(), sinks.end(), _threadPool, policy);
+        };
+        
         // Настраиваем логирование в консоль
         auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
         
@@ -16,47 +42,23 @@ Logger::Logger(const std::string& logFile, LogLevel level)
                 auto file_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(_logFile, true);
                 
                 // Создаем логгер с двумя sink'ами - консоль и файл
-                std::vector<spdlog::sink_ptr> sinks {console_sink, file_sink};
-                auto logger = std::make_shared<spdlog::logger>("pgw_logger", sinks.begin(), sinks.end());
-                
                 // Устанавливаем этот логгер как логгер по умолчанию
-                spdlog::set_default_logger(logger);
+                spdlog::set_default_logger(makeLogger("pgw_logger", {console_sink, file_sink}));
             } catch (const spdlog::spdlog_ex& ex) {
                 std::cerr << "Logger initialization failed: " << ex.what() << std::endl;
                 _isHealthy = false;
                 _logToFile = false;
                 
                 // Если не удалось создать файловый логгер, используем только консольный
-                spdlog::set_default_logger(std::make_shared<spdlog::logger>("pgw_console_logger", console_sink));
+                spdlog::set_default_logger(makeLogger("pgw_console_logger", {console_sink}));
             }
         } else {
             // Если файл не указан, используем только консольный логгер
-            spdlog::set_default_logger(std::make_shared<spdlog::logger>("pgw_console_logger", console_sink));
+            spdlog::set_default_logger(makeLogger("pgw_console_logger", {console_sink}));
         }
         
         // Устанавливаем уровень логирования
-        spdlog::level::level_enum spdlog_level;
-        switch (_logLevel) {
-            case LogLevel::LOG_DEBUG:
-                spdlog_level = spdlog::level::debug;
-                break;
-            case LogLevel::INFO:
-                spdlog_level = spdlog::level::info;
-                break;
-            case LogLevel::WARN:
-                spdlog_level = spdlog::level::warn;
-                break;
-            case LogLevel::ERROR:
-                spdlog_level = spdlog::level::err;
-                break;
-            case LogLevel::CRITICAL:
-                spdlog_level = spdlog::level::critical;
-                break;
-            default:
-                spdlog_level = spdlog::level::info; // По умолчанию INFO
-                break;
-        }
-        spdlog::set_level(spdlog_level);
+        spdlog::set_level(toSpdlogLevel(_logLevel));
         
         // Устанавливаем формат сообщений
         spdlog::set_pattern("%Y-%m-%d %H:%M:%S.%e [%l] [%t] %v");
@@ -66,6 +68,10 @@ Logger::Logger(const std::string& logFile, LogLevel level)
         if (_logToFile) {
             spdlog::info("Logging to file: {}", _logFile);
         }
+        if (_threadPool) {
+            spdlog::info("Async logging enabled (queue: {}, overflow policy: {})", _options.queueSize,
+                         overflowPolicyToString(_options.overflowPolicy));
+        }
     } catch (const std::exception& e) {
         std::cerr << "Logger initialization failed: " << e.what() << std::endl;
         _isHealthy = false;
@@ -78,6 +84,10 @@ Logger::~Logger() {
             spdlog::info("Logger shutting down");
             spdlog::shutdown();
         }
+        
+        // Дожидаемся записи оставшихся в очереди сообщений и выгружаем счетчик потерь
+        _threadPool.reset();
+        syncDroppedMetrics();
     } catch (...) {
         // Игнорируем исключения в деструкторе
     }
@@ -87,36 +97,12 @@ void Logger::setLogLevel(LogLevel level) {
     std::lock_guard<std::mutex> lock(_mutex);
     _logLevel = level;
     
-    // Исправляем преобразование уровней
-    spdlog::level::level_enum spdlog_level;
-    switch (level) {
-        case LogLevel::LOG_DEBUG:
-            spdlog_level = spdlog::level::debug;
-            break;
-        case LogLevel::INFO:
-            spdlog_level = spdlog::level::info;
-            break;
-        case LogLevel::WARN:
-            spdlog_level = spdlog::level::warn;
-            break;
-        case LogLevel::ERROR:
-            spdlog_level = spdlog::level::err;
-            break;
-        case LogLevel::CRITICAL:
-            spdlog_level = spdlog::level::critical;
-            break;
-        default:
-            spdlog_level = spdlog::level::info;
-            break;
-    }
-    
-    spdlog::set_level(spdlog_level);
+    spdlog::set_level(toSpdlogLevel(level));
     spdlog::info("Log level changed to: {}", levelToString(level));
 }
 
 LogLevel Logger::getLogLevel() const {
-    std::lock_guard<std::mutex> lock(_mutex);
-    return _logLevel;
+    return _logLevel.load(std::memory_order_relaxed);
 }
 
 void Logger::debug(const std::string& message) {
@@ -140,7 +126,7 @@ void Logger::critical(const std::string& message) {
 }
 
 void Logger::log(LogLevel level, const std::string& message) {
-    if (!_isHealthy) {
+    if (!_isHealthy || !isEnabled(level) || !admitMessage()) {
         return;
     }
     
@@ -186,12 +172,71 @@ void Logger::flush() {
         if (logger) {
             logger->flush();
         }
+        syncDroppedMetrics();
     } catch (const std::exception& e) {
         std::cerr << "Flush error: " << e.what() << std::endl;
         _isHealthy = false;
     }
 }
 
+uint64_t Logger::getDroppedCount() const {
+    if (!_threadPool) {
+        return 0;
+    }
+    return _threadPool->overrun_counter() + _droppedNew.load(std::memory_order_relaxed);
+}
+
+bool Logger::admitMessage() {
+    if (!_threadPool) {
+        return true;
+    }
+    
+    // spdlog 1.12 не поддерживает отбрасывание новых сообщений, поэтому проверяем очередь сами
+    if (_options.overflowPolicy == LogOverflowPolicy::DROP_NEW &&
+        _threadPool->queue_size() >= _options.queueSize) {
+        // Пока очередь переполнена, принятых сообщений нет: выгружаем потери по счетчику отброшенных
+        if (_droppedNew.fetch_add(1, std::memory_order_relaxed) % METRICS_SYNC_INTERVAL == 0) {
+            syncDroppedMetrics();
+        }
+        return false;
+    }
+    
+    if (_messageCounter.fetch_add(1, std::memory_order_relaxed) % METRICS_SYNC_INTERVAL == 0) {
+        syncDroppedMetrics();
+    }
+    return true;
+}
+
+void Logger::syncDroppedMetrics() {
+    uint64_t total = getDroppedCount();
+    uint64_t reported = _reportedDropped.load(std::memory_order_relaxed);
+    
+    // Выгружает прирост ровно один раз, даже если синхронизацию запустили несколько потоков
+    while (total > reported) {
+        if (_reportedDropped.compare_exchange_weak(reported, total, std::memory_order_relaxed)) {
+            ServerMetrics::incLogDropped(total - reported);
+            break;
+        }
+    }
+}
+
+spdlog::level::level_enum Logger::toSpdlogLevel(LogLevel level) {
+    switch (level) {
+        case LogLevel::LOG_DEBUG:
+            return spdlog::level::debug;
+        case LogLevel::INFO:
+            return spdlog::level::info;
+        case LogLevel::WARN:
+            return spdlog::level::warn;
+        case LogLevel::ERROR:
+            return spdlog::level::err;
+        case LogLevel::CRITICAL:
+            return spdlog::level::critical;
+        default:
+            return spdlog::level::info; // По умолчанию INFO
+    }
+}
+
 std::string Logger::levelToString(LogLevel level) {
     switch (level) {
         case LogLevel::LOG_DEBUG:
@@ -223,4 +268,27 @@ LogLevel Logger::stringToLevel(const std::string& levelStr) {
     } else {
         return LogLevel::INFO;
     }
-} 
\ No newline at end of file
+} 
+
+LogOverflowPolicy Logger::stringToOverflowPolicy(const std::string& policyStr) {
+    if (policyStr == "drop_oldest") {
+        return LogOverflowPolicy::DROP_OLDEST;
+    } else if (policyStr == "drop_new") {
+        return LogOverflowPolicy::DROP_NEW;
+    } else {
+        return LogOverflowPolicy::BLOCK;
+    }
+}
+
+std::string Logger::overflowPolicyToString(LogOverflowPolicy policy) {
+    switch (policy) {
+        case LogOverflowPolicy::BLOCK:
+            return "block";
+        case LogOverflowPolicy::DROP_OLDEST:
+            return "drop_oldest";
+        case LogOverflowPolicy::DROP_NEW:
+            return "drop_new";
+        default:
+            return "unknown";
+    }
+}
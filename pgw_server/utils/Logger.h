@@ -1,8 +1,18 @@
 #pragma once
 
+#include <spdlog/spdlog.h>
 #include <string>
 #include <fstream>
 #include <mutex>
+#include <atomic>
+#include <utility>
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+
+namespace spdlog::details {
+class thread_pool;
+}
 
 /**
  * @brief Уровни логирования
@@ -15,6 +25,59 @@ enum class LogLevel {
     CRITICAL = 4
 };
 
+/**
+ * @brief Политика при переполнении очереди асинхронного логгера
+ */
+enum class LogOverflowPolicy {
+    BLOCK,          // Ожидать освобождения места в очереди
+    DROP_OLDEST,    // Вытеснять самое старое сообщение в очереди
+    DROP_NEW        // Отбрасывать новое сообщение (граница нестрогая, см. Logger::admitMessage)
+};
+
+/**
+ * @brief Параметры логгера
+ */
+struct LoggerOptions {
+    bool async = false;                                         // Запись в отдельном потоке через ограниченную очередь
+    size_t queueSize = 8192;                                    // Емкость очереди сообщений (асинхронный режим)
+    LogOverflowPolicy overflowPolicy = LogOverflowPolicy::BLOCK; // Поведение при заполненной очереди
+};
+
+/**
+ * @brief Минимальный уровень логирования, компилируемый в бинарник
+ *
+ * Вызовы PGW_LOG_* с уровнем ниже этого значения удаляются на этапе
+ * компиляции вместе с вычислением аргументов. Значение соответствует
+ * LogLevel (0 - DEBUG, 1 - INFO, ...).
+ */
+#ifndef PGW_LOG_MIN_LEVEL
+#define PGW_LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * @brief Логирует форматированное сообщение, если уровень включен
+ *
+ * Аргументы вычисляются только если уровень не отсечен ни на этапе
+ * компиляции (PGW_LOG_MIN_LEVEL), ни текущим уровнем логгера.
+ * @param logger Указатель на логгер (может быть nullptr)
+ * @param level Уровень логирования
+ * @param ... Строка формата spdlog/fmt и аргументы
+ */
+#define PGW_LOG(logger, level, ...)                                          \
+    do {                                                                     \
+        if constexpr (static_cast<int>(level) >= PGW_LOG_MIN_LEVEL) {        \
+            if ((logger) && (logger)->isEnabled(level)) {                    \
+                (logger)->logf(level, __VA_ARGS__);                          \
+            }                                                                \
+        }                                                                    \
+    } while (false)
+
+#define PGW_LOG_DEBUG(logger, ...) PGW_LOG(logger, LogLevel::LOG_DEBUG, __VA_ARGS__)
+#define PGW_LOG_INFO(logger, ...) PGW_LOG(logger, LogLevel::INFO, __VA_ARGS__)
+#define PGW_LOG_WARN(logger, ...) PGW_LOG(logger, LogLevel::WARN, __VA_ARGS__)
+#define PGW_LOG_ERROR(logger, ...) PGW_LOG(logger, LogLevel::ERROR, __VA_ARGS__)
+#define PGW_LOG_CRITICAL(logger, ...) PGW_LOG(logger, LogLevel::CRITICAL, __VA_ARGS__)
+
 /**
  * @brief Класс для логирования сообщений
  * 
@@ -27,9 +90,12 @@ public:
      * @brief Создает новый логгер
      * @param logFile Путь к файлу логов (пустая строка для логирования только в консоль)
      * @param level Уровень логирования
+     * @param options Параметры асинхронной записи
+     * @throws std::invalid_argument если в асинхронном режиме queueSize равен 0
      */
     explicit Logger(const std::string& logFile = "", 
-                   LogLevel level = LogLevel::INFO);
+                   LogLevel level = LogLevel::INFO,
+                   const LoggerOptions& options = {});
     
     /**
      * @brief Деструктор, закрывает логгер
@@ -54,6 +120,15 @@ public:
      */
     [[nodiscard]] LogLevel getLogLevel() const;
     
+    /**
+     * @brief Проверяет, будет ли записано сообщение указанного уровня
+     * @param level Уровень логирования
+     * @return true если уровень не ниже текущего, иначе false
+     */
+    [[nodiscard]] bool isEnabled(LogLevel level) const noexcept {
+        return level >= _logLevel.load(std::memory_order_relaxed);
+    }
+    
     /**
      * @brief Логирует отладочное сообщение (уровень DEBUG)
      * @param message Сообщение для логирования
@@ -91,6 +166,30 @@ public:
      */
     void log(LogLevel level, const std::string& message);
     
+    /**
+     * @brief Логирует сообщение по строке формата
+     * 
+     * Сообщение форматируется только если уровень включен.
+     * Для горячих путей используйте макросы PGW_LOG_*, которые
+     * не вычисляют аргументы при отключенном уровне.
+     * @param level Уровень логирования
+     * @param format Строка формата spdlog/fmt
+     * @param args Аргументы форматирования
+     */
+    template<typename... Args>
+    void logf(LogLevel level, spdlog::format_string_t<Args...> format, Args&&... args) {
+        if (!_isHealthy || !isEnabled(level) || !admitMessage()) {
+            return;
+        }
+        
+        try {
+            spdlog::log(toSpdlogLevel(level), format, std::forward<Args>(args)...);
+        } catch (const std::exception& e) {
+            std::cerr << "Logging error: " << e.what() << std::endl;
+            _isHealthy = false;
+        }
+    }
+    
     /**
      * @brief Проверяет работоспособность логгера
      * @return true если логгер работоспособен, иначе false
@@ -99,9 +198,16 @@ public:
     
     /**
      * @brief Принудительно записывает буферизованные сообщения
+     * @note В асинхронном режиме сброс выполняется потоком записи позже
      */
     void flush();
     
+    /**
+     * @brief Возвращает количество сообщений, потерянных из-за переполнения очереди
+     * @return Количество вытесненных и отброшенных сообщений (0 в синхронном режиме)
+     */
+    [[nodiscard]] uint64_t getDroppedCount() const;
+    
     /**
      * @brief Преобразует строковое представление уровня логирования в enum LogLevel
      * @param levelStr Строковое представление уровня логирования
@@ -115,12 +221,62 @@ public:
      * @return Строковое представление уровня логирования
      */
     static std::string levelToString(LogLevel level);
+    
+    /**
+     * @brief Преобразует строковое представление политики переполнения в LogOverflowPolicy
+     * @param policyStr "block", "drop_oldest" или "drop_new"
+     * @return Соответствующее значение или LogOverflowPolicy::BLOCK, если строка не распознана
+     */
+    static LogOverflowPolicy stringToOverflowPolicy(const std::string& policyStr);
+    
+    /**
+     * @brief Преобразует LogOverflowPolicy в строковое представление
+     * @param policy Политика переполнения
+     * @return "block", "drop_oldest" или "drop_new"
+     */
+    static std::string overflowPolicyToString(LogOverflowPolicy policy);
 
 private:
+    static constexpr uint64_t METRICS_SYNC_INTERVAL = 1024; // Сообщений между выгрузками счетчика потерь в метрики
+
+    /**
+     * @brief Решает, ставить ли сообщение в очередь асинхронного логгера
+     * 
+     * Реализует политику DROP_NEW и периодически выгружает счетчик
+     * потерь в ServerMetrics: каждые METRICS_SYNC_INTERVAL принятых сообщений
+     * и каждые METRICS_SYNC_INTERVAL отброшенных, начиная с первого, поэтому
+     * метрика растет и пока очередь переполнена. В синхронном режиме всегда возвращает true.
+     * 
+     * Граница DROP_NEW нестрогая: размер очереди проверяется до постановки
+     * сообщения, и несколько потоков могут одновременно застать последнее
+     * свободное место. Очередь spdlog под этой политикой блокирующая, поэтому
+     * опоздавший производитель кратко ждет записи, а не теряет сообщение.
+     * @return true если сообщение нужно записать, иначе false
+     */
+    bool admitMessage();
+    
+    /**
+     * @brief Выгружает прирост счетчика потерь в ServerMetrics
+     */
+    void syncDroppedMetrics();
+
+    /**
+     * @brief Преобразует LogLevel в уровень spdlog
+     * @param level Уровень логирования
+     * @return Соответствующий уровень spdlog
+     */
+    static spdlog::level::level_enum toSpdlogLevel(LogLevel level);
+
     std::string _logFile;           // Путь к файлу логов
-    LogLevel _logLevel;             // Текущий уровень логирования
+    std::atomic<LogLevel> _logLevel;  // Текущий уровень логирования (читается без мьютекса)
     mutable std::mutex _mutex;      // Мьютекс для потокобезопасности
     std::ofstream _file;            // Файловый поток (не используется с spdlog)
     bool _logToFile = false;        // Флаг логирования в файл
     bool _isHealthy = true;         // Флаг работоспособности логгера
+    
+    LoggerOptions _options;                                 // Параметры асинхронной записи
+    std::shared_ptr<spdlog::details::thread_pool> _threadPool; // Поток записи и очередь (nullptr в синхронном режиме)
+    std::atomic<uint64_t> _droppedNew{0};                   // Сообщения, отброшенные по политике DROP_NEW
+    std::atomic<uint64_t> _reportedDropped{0};              // Потери, уже выгруженные в ServerMetrics
+    std::atomic<uint64_t> _messageCounter{0};               // Счетчик сообщений для периодической выгрузки
 };
\ No newline at end of file
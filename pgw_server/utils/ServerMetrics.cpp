@@ -1,12 +1,91 @@
 #include <ServerMetrics.h>
 #include <prometheus/exposer.h>
+#include <algorithm>
+#include <vector>
 
 using namespace prometheus;
 
+namespace {
+
+// Границы корзин задержек: от 1 мкс до 1 с
+constexpr std::array<uint64_t, 19> BUCKET_BOUNDS_NS = {
+    1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 500000,
+    1000000, 2500000, 5000000, 10000000, 25000000, 50000000,
+    100000000, 250000000, 500000000, 1000000000
+};
+constexpr size_t BUCKET_COUNT = BUCKET_BOUNDS_NS.size() + 1;    // Последняя корзина - +Inf
+
+constexpr std::array<const char*, static_cast<size_t>(LatencyStage::COUNT)> STAGE_NAMES = {
+    "admission", "decode", "session", "response", "blacklist", "rate_limit", "session_store", "cdr"
+};
+
+Histogram::BucketBoundaries latencyBuckets() {
+    Histogram::BucketBoundaries bounds;
+    bounds.reserve(BUCKET_BOUNDS_NS.size());
+    for (auto ns : BUCKET_BOUNDS_NS) {
+        bounds.push_back(static_cast<double>(ns) / 1e9);
+    }
+    return bounds;
+}
+
+} // namespace
+
+/**
+ * @brief Задержки, накопленные одним потоком с прошлой выгрузки
+ */
+struct ServerMetrics::LatencyAccumulator {
+    std::array<std::array<uint64_t, BUCKET_COUNT>, LATENCY_SERIES> buckets{};  // Наблюдения по корзинам
+    std::array<uint64_t, LATENCY_SERIES> sumNs{};                               // Сумма длительностей, нс
+    uint32_t pending = 0;                                                       // Наблюдений с прошлой выгрузки
+    std::chrono::steady_clock::time_point lastFlush = std::chrono::steady_clock::now();
+    
+    ~LatencyAccumulator() {
+        flush();
+    }
+    
+    void add(size_t series, std::chrono::nanoseconds duration, uint64_t count) {
+        auto ns = static_cast<uint64_t>(std::max<int64_t>(duration.count(), 0));
+        // Корзина le: первая граница не меньше значения
+        auto bucket = static_cast<size_t>(
+            std::lower_bound(BUCKET_BOUNDS_NS.begin(), BUCKET_BOUNDS_NS.end(), ns) - BUCKET_BOUNDS_NS.begin());
+        buckets[series][bucket] += count;
+        sumNs[series] += ns * count;
+        if (++pending >= FLUSH_OBSERVATIONS) {
+            flush();
+        }
+    }
+    
+    void flush() {
+        if (pending == 0) {
+            return;
+        }
+        std::vector<double> increments(BUCKET_COUNT);
+        for (size_t series = 0; series < LATENCY_SERIES; ++series) {
+            if (std::all_of(buckets[series].begin(), buckets[series].end(), [](uint64_t n) { return n == 0; })) {
+                continue;
+            }
+            std::transform(buckets[series].begin(), buckets[series].end(), increments.begin(),
+                           [](uint64_t n) { return static_cast<double>(n); });
+            latency_histograms_[series]->ObserveMultiple(increments, static_cast<double>(sumNs[series]) / 1e9);
+            buckets[series].fill(0);
+            sumNs[series] = 0;
+        }
+        pending = 0;
+        lastFlush = std::chrono::steady_clock::now();
+    }
+};
+
 // Инициализация статических переменных
 std::shared_ptr<Registry> ServerMetrics::registry_;
 Counter* ServerMetrics::processed_requests_counter_ = nullptr;
 Counter* ServerMetrics::rejected_requests_counter_ = nullptr;
+Counter* ServerMetrics::cdr_dropped_counter_ = nullptr;
+Counter* ServerMetrics::cdr_backpressure_counter_ = nullptr;
+Counter* ServerMetrics::log_dropped_counter_ = nullptr;
+Counter* ServerMetrics::admission_dropped_source_counter_ = nullptr;
+Counter* ServerMetrics::admission_dropped_global_counter_ = nullptr;
+std::array<Histogram*, ServerMetrics::LATENCY_SERIES> ServerMetrics::latency_histograms_{};
+std::atomic<bool> ServerMetrics::latency_enabled_{false};
 
 void ServerMetrics::init(int port) {
     // HTTP endpoint для Prometheus
@@ -27,6 +106,51 @@ void ServerMetrics::init(int port) {
         .Register(*registry_);
     rejected_requests_counter_ = &rejected_requests_family.Add({});
 
+    // Счетчик CDR, отброшенных из-за заполненной очереди
+    auto& cdr_dropped_family = BuildCounter()
+        .Name("pgw_cdr_dropped_total")
+        .Help("Total number of CDR records dropped because the write queue was full")
+        .Register(*registry_);
+    cdr_dropped_counter_ = &cdr_dropped_family.Add({});
+
+    // Счетчик ожиданий места в очереди CDR
+    auto& cdr_backpressure_family = BuildCounter()
+        .Name("pgw_cdr_backpressure_total")
+        .Help("Total number of times a CDR producer found the write queue full")
+        .Register(*registry_);
+    cdr_backpressure_counter_ = &cdr_backpressure_family.Add({});
+
+    // Счетчик сообщений лога, потерянных при переполнении очереди
+    auto& log_dropped_family = BuildCounter()
+        .Name("pgw_log_dropped_total")
+        .Help("Total number of log messages dropped because the async log queue was full")
+        .Register(*registry_);
+    log_dropped_counter_ = &log_dropped_family.Add({});
+
+    // Счетчик пакетов, отброшенных контролем допуска, с причиной в метке
+    auto& admission_dropped_family = BuildCounter()
+        .Name("pgw_admission_dropped_total")
+        .Help("Total number of packets dropped by admission control before decoding")
+        .Register(*registry_);
+    admission_dropped_source_counter_ = &admission_dropped_family.Add({{"reason", "source"}});
+    admission_dropped_global_counter_ = &admission_dropped_family.Add({{"reason", "global"}});
+
+    // Гистограммы задержек: полная обработка запроса и этапы с именем в метке
+    auto& request_duration_family = BuildHistogram()
+        .Name("pgw_request_duration_seconds")
+        .Help("Time from receiving a request to sending its response")
+        .Register(*registry_);
+    latency_histograms_[REQUEST_SERIES] = &request_duration_family.Add({}, latencyBuckets());
+
+    auto& stage_duration_family = BuildHistogram()
+        .Name("pgw_request_stage_duration_seconds")
+        .Help("Time spent in each request processing stage")
+        .Register(*registry_);
+    for (size_t stage = 0; stage < STAGE_COUNT; ++stage) {
+        latency_histograms_[stage] = &stage_duration_family.Add({{"stage", STAGE_NAMES[stage]}}, latencyBuckets());
+    }
+    latency_enabled_.store(true, std::memory_order_release);
+
     // Регистрация коллектора для Prometheus
     exposer.RegisterCollectable(registry_);
 }
@@ -41,4 +165,82 @@ void ServerMetrics::incRejectedRequests() {
     if (rejected_requests_counter_) {
         rejected_requests_counter_->Increment();
     }
-}
\ No newline at end of file
+}
+
+void ServerMetrics::incCdrDropped() {
+    if (cdr_dropped_counter_) {
+        cdr_dropped_counter_->Increment();
+    }
+}
+
+void ServerMetrics::incCdrBackpressure() {
+    if (cdr_backpressure_counter_) {
+        cdr_backpressure_counter_->Increment();
+    }
+}
+
+void ServerMetrics::incLogDropped(uint64_t count) {
+    if (log_dropped_counter_) {
+        log_dropped_counter_->Increment(static_cast<double>(count));
+    }
+}
+
+uint64_t ServerMetrics::getLogDropped() {
+    return log_dropped_counter_ ? static_cast<uint64_t>(log_dropped_counter_->Value()) : 0;
+}
+
+void ServerMetrics::incAdmissionDroppedSource() {
+    if (admission_dropped_source_counter_) {
+        admission_dropped_source_counter_->Increment();
+    }
+}
+
+void ServerMetrics::incAdmissionDroppedGlobal() {
+    if (admission_dropped_global_counter_) {
+        admission_dropped_global_counter_->Increment();
+    }
+}
+
+ServerMetrics::LatencyAccumulator& ServerMetrics::threadAccumulator() {
+    thread_local LatencyAccumulator accumulator;
+    return accumulator;
+}
+
+void ServerMetrics::observeStageLatency(LatencyStage stage, std::chrono::nanoseconds duration, uint64_t count) {
+    if (latencyEnabled()) {
+        threadAccumulator().add(static_cast<size_t>(stage), duration, count);
+    }
+}
+
+void ServerMetrics::observeRequestLatency(std::chrono::steady_clock::time_point start,
+                                          std::chrono::steady_clock::time_point end, uint64_t count) {
+    if (!latencyEnabled()) {
+        return;
+    }
+    auto& accumulator = threadAccumulator();
+    accumulator.add(REQUEST_SERIES, end - start, count);
+    // Время выгрузки проверяется по уже прочитанным часам, без лишнего обращения к ним
+    if (end - accumulator.lastFlush >= FLUSH_INTERVAL) {
+        accumulator.flush();
+    }
+}
+
+prometheus::ClientMetric::Histogram ServerMetrics::getStageLatency(LatencyStage stage) {
+    if (!latencyEnabled()) {
+        return {};
+    }
+    return latency_histograms_[static_cast<size_t>(stage)]->Collect().histogram;
+}
+
+prometheus::ClientMetric::Histogram ServerMetrics::getRequestLatency() {
+    if (!latencyEnabled()) {
+        return {};
+    }
+    return latency_histograms_[REQUEST_SERIES]->Collect().histogram;
+}
+
+void ServerMetrics::flushThreadLatency() {
+    if (latencyEnabled()) {
+        threadAccumulator().flush();
+    }
+}
@@ -1,7 +1,30 @@
 #pragma once
 #include <memory>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <prometheus/registry.h>
 #include <prometheus/counter.h>
+#include <prometheus/histogram.h>
+
+/**
+ * @brief Этапы обработки запроса, задержка которых измеряется гистограммами
+ *
+ * Первые четыре этапа последовательно делят путь пакета в UdpServer,
+ * остальные - вложенные этапы SessionManager::createSession.
+ */
+enum class LatencyStage : size_t {
+    ADMISSION,      // Контроль допуска
+    DECODE,         // Разбор пакета и декодирование IMSI
+    SESSION,        // SessionManager::createSession целиком
+    RESPONSE,       // Кодирование и отправка ответа
+    BLACKLIST,      // Проверка черного списка
+    RATE_LIMIT,     // Ограничитель скорости
+    SESSION_STORE,  // Создание или продление сессии в хранилище
+    CDR,            // Запись CDR
+    COUNT
+};
 
 class ServerMetrics {
 public:
@@ -11,10 +34,156 @@ public:
     static void incProcessedRequests();
     static void incRejectedRequests();
     
+    // Счетчики асинхронной записи CDR
+    static void incCdrDropped();
+    static void incCdrBackpressure();
+    
+    // Счетчик сообщений лога, потерянных при переполнении асинхронной очереди
+    static void incLogDropped(uint64_t count = 1);
+    
+    /**
+     * @brief Возвращает значение счетчика потерянных сообщений лога
+     * @return Значение pgw_log_dropped_total (0 до init())
+     */
+    static uint64_t getLogDropped();
+    
+    // Счетчики пакетов, отброшенных контролем допуска до декодирования
+    static void incAdmissionDroppedSource();
+    static void incAdmissionDroppedGlobal();
+    
+    /**
+     * @brief Проверяет, зарегистрированы ли гистограммы задержек
+     *
+     * До init() измерение задержек отключено, и StageTimer не читает часы.
+     */
+    static bool latencyEnabled() { return latency_enabled_.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Учитывает длительность этапа обработки
+     *
+     * Наблюдение накапливается в счетчиках текущего потока и выгружается
+     * в Prometheus пачкой, поэтому потоки не конкурируют за мьютекс гистограммы.
+     * @param stage Этап
+     * @param duration Длительность
+     * @param count Число запросов с такой длительностью (пачка recvmmsg/sendmmsg)
+     */
+    static void observeStageLatency(LatencyStage stage, std::chrono::nanoseconds duration, uint64_t count = 1);
+    
+    /**
+     * @brief Учитывает полную задержку обработки запроса
+     *
+     * Выгружает накопленное потоком, если с прошлой выгрузки прошло больше FLUSH_INTERVAL.
+     * @param start Момент получения запроса
+     * @param end Момент отправки ответа
+     * @param count Число запросов с такой задержкой
+     */
+    static void observeRequestLatency(std::chrono::steady_clock::time_point start,
+                                      std::chrono::steady_clock::time_point end, uint64_t count = 1);
+    
+    /**
+     * @brief Выгружает в Prometheus задержки, накопленные текущим потоком
+     *
+     * Вызывается простаивающими потоками; при завершении потока выгрузка выполняется автоматически.
+     */
+    static void flushThreadLatency();
+    
+    /**
+     * @brief Возвращает выгруженное состояние гистограммы задержки этапа
+     * @param stage Этап
+     * @return Число наблюдений, сумма и накопленные счетчики корзин (пусто до init())
+     */
+    static prometheus::ClientMetric::Histogram getStageLatency(LatencyStage stage);
+    
+    /**
+     * @brief Возвращает выгруженное состояние гистограммы полной задержки запроса
+     * @return Число наблюдений, сумма и накопленные счетчики корзин (пусто до init())
+     */
+    static prometheus::ClientMetric::Histogram getRequestLatency();
+    
+    static constexpr uint32_t FLUSH_OBSERVATIONS = 4096;                        // Наблюдений потока до выгрузки
+    static constexpr std::chrono::milliseconds FLUSH_INTERVAL{1000};            // Максимальная задержка выгрузки
+    
 private:
+    struct LatencyAccumulator;
+    
+    /**
+     * @brief Возвращает накопитель задержек текущего потока
+     */
+    static LatencyAccumulator& threadAccumulator();
+    
+    static constexpr size_t STAGE_COUNT = static_cast<size_t>(LatencyStage::COUNT);
+    static constexpr size_t REQUEST_SERIES = STAGE_COUNT;                       // Индекс полной задержки запроса
+    static constexpr size_t LATENCY_SERIES = STAGE_COUNT + 1;
+    
+
     static std::shared_ptr<prometheus::Registry> registry_;
     
     // Счетчики
     static prometheus::Counter* processed_requests_counter_;
     static prometheus::Counter* rejected_requests_counter_;
+    static prometheus::Counter* cdr_dropped_counter_;
+    static prometheus::Counter* cdr_backpressure_counter_;
+    static prometheus::Counter* log_dropped_counter_;
+    static prometheus::Counter* admission_dropped_source_counter_;
+    static prometheus::Counter* admission_dropped_global_counter_;
+    
+    // Гистограммы задержек: этапы по индексу LatencyStage, затем полная задержка
+    static std::array<prometheus::Histogram*, LATENCY_SERIES> latency_histograms_;
+    static std::atomic<bool> latency_enabled_;
+};
+
+/**
+ * @brief Измеряет последовательные этапы обработки запроса
+ *
+ * Каждая отметка учитывает время от предыдущей отметки (или создания) как
+ * длительность этапа. Если метрики не инициализированы, часы не читаются.
+ */
+class StageTimer {
+public:
+    using Clock = std::chrono::steady_clock;
+    
+    StageTimer() : _enabled(ServerMetrics::latencyEnabled()) {
+        if (_enabled) {
+            _start = _mark = Clock::now();
+        }
+    }
+    
+    /**
+     * @brief Завершает этап
+     * @param stage Этап, длившийся с предыдущей отметки
+     * @param count Число запросов, прошедших этап вместе
+     */
+    void mark(LatencyStage stage, uint64_t count = 1) {
+        if (_enabled) {
+            auto now = Clock::now();
+            ServerMetrics::observeStageLatency(stage, now - _mark, count);
+            _mark = now;
+        }
+    }
+    
+    /**
+     * @brief Начинает следующий этап без учета прошедшего времени
+     *
+     * Используется, когда прошедшие этапы измерены вложенным таймером.
+     */
+    void skip() {
+        if (_enabled) {
+            _mark = Clock::now();
+        }
+    }
+    
+    /**
+     * @brief Учитывает полную задержку запроса от создания таймера до последней отметки
+     * @param count Число запросов, обработанных вместе
+     */
+    void finishRequest(uint64_t count = 1) const {
+        if (_enabled) {
+            ServerMetrics::observeRequestLatency(_start, _mark, count);
+        }
+    }
+    
+private:
+    bool _enabled;                  // Метрики инициализированы
+    Clock::time_point _start;       // Создание таймера
+    Clock::time_point _mark;        // Последняя отметка
 };
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include <TimestampFormatter.h>
+#include <ctime>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+/**
+ * @brief Записывает число фиксированной ширины с ведущими нулями
+ * @param out Буфер
+ * @param value Неотрицательное значение
+ * @param width Количество цифр
+ */
+void writeDigits(char* out, uint32_t value, size_t width) {
+    for (size_t i = width; i > 0; --i) {
+        out[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+} // namespace
+
+TimestampFormatter::TimestampFormatter(TimestampPrecision precision)
+    : _precision(precision),
+      _cachedSecond(std::numeric_limits<int64_t>::min()),
+      _prefix{} {
+}
+
+size_t TimestampFormatter::format(std::chrono::system_clock::time_point time, char* out) {
+    auto sinceEpoch = time.time_since_epoch();
+    auto seconds = std::chrono::floor<std::chrono::seconds>(sinceEpoch);
+
+    if (seconds.count() != _cachedSecond) {
+        updatePrefix(seconds.count());
+    }
+
+    std::memcpy(out, _prefix, PREFIX_LENGTH);
+
+    auto fraction = std::chrono::duration_cast<std::chrono::microseconds>(sinceEpoch - seconds).count();
+    switch (_precision) {
+        case TimestampPrecision::MILLISECONDS:
+            out[PREFIX_LENGTH] = '.';
+            writeDigits(out + PREFIX_LENGTH + 1, static_cast<uint32_t>(fraction / 1000), 3);
+            break;
+        case TimestampPrecision::MICROSECONDS:
+            out[PREFIX_LENGTH] = '.';
+            writeDigits(out + PREFIX_LENGTH + 1, static_cast<uint32_t>(fraction), 6);
+            break;
+        default:
+            break;
+    }
+
+    return lengthFor(_precision);
+}
+
+void TimestampFormatter::append(std::chrono::system_clock::time_point time, std::string& out) {
+    char buffer[MAX_LENGTH];
+    size_t length = format(time, buffer);
+    out.append(buffer, length);
+}
+
+std::string TimestampFormatter::toString(std::chrono::system_clock::time_point time) {
+    char buffer[MAX_LENGTH];
+    size_t length = format(time, buffer);
+    return {buffer, length};
+}
+
+TimestampPrecision TimestampFormatter::getPrecision() const {
+    return _precision;
+}
+
+void TimestampFormatter::updatePrefix(int64_t seconds) {
+    auto timeT = static_cast<std::time_t>(seconds);
+    std::tm localTime{};
+    localtime_r(&timeT, &localTime);
+
+    // YYYY-MM-DD HH:MM:SS
+    writeDigits(_prefix, static_cast<uint32_t>(localTime.tm_year + 1900), 4);
+    _prefix[4] = '-';
+    writeDigits(_prefix + 5, static_cast<uint32_t>(localTime.tm_mon + 1), 2);
+    _prefix[7] = '-';
+    writeDigits(_prefix + 8, static_cast<uint32_t>(localTime.tm_mday), 2);
+    _prefix[10] = ' ';
+    writeDigits(_prefix + 11, static_cast<uint32_t>(localTime.tm_hour), 2);
+    _prefix[13] = ':';
+    writeDigits(_prefix + 14, static_cast<uint32_t>(localTime.tm_min), 2);
+    _prefix[16] = ':';
+    writeDigits(_prefix + 17, static_cast<uint32_t>(localTime.tm_sec), 2);
+
+    _cachedSecond = seconds;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Точность дробной части временной метки
+ */
+enum class TimestampPrecision {
+    SECONDS,        // YYYY-MM-DD HH:MM:SS
+    MILLISECONDS,   // YYYY-MM-DD HH:MM:SS.mmm
+    MICROSECONDS    // YYYY-MM-DD HH:MM:SS.uuuuuu
+};
+
+/**
+ * @brief Форматирует локальное время в формате YYYY-MM-DD HH:MM:SS[.fff[fff]]
+ *
+ * Префикс с датой и временем до секунд кэшируется и пересчитывается
+ * через localtime_r только при смене секунды. Запись идет напрямую
+ * в буфер вызывающего без промежуточных строк и потоков.
+ *
+ * @note Экземпляр не потокобезопасен: каждый поток или владелец под
+ *       мьютексом должен использовать собственный экземпляр.
+ */
+class TimestampFormatter {
+public:
+    static constexpr size_t PREFIX_LENGTH = 19;                 // Длина "YYYY-MM-DD HH:MM:SS"
+    static constexpr size_t MAX_LENGTH = PREFIX_LENGTH + 7;     // Длина с микросекундами
+
+    /**
+     * @brief Создает форматтер
+     * @param precision Точность дробной части
+     */
+    explicit TimestampFormatter(TimestampPrecision precision = TimestampPrecision::SECONDS);
+
+    /**
+     * @brief Записывает временную метку в буфер
+     * @param time Время
+     * @param out Буфер размером не меньше MAX_LENGTH (без завершающего нуля)
+     * @return Количество записанных символов
+     */
+    size_t format(std::chrono::system_clock::time_point time, char* out);
+
+    /**
+     * @brief Дописывает временную метку в конец строки
+     * @param time Время
+     * @param out Строка-приемник
+     */
+    void append(std::chrono::system_clock::time_point time, std::string& out);
+
+    /**
+     * @brief Возвращает временную метку строкой
+     * @param time Время
+     * @return Строка с временем
+     */
+    [[nodiscard]] std::string toString(std::chrono::system_clock::time_point time);
+
+    /**
+     * @brief Возвращает точность дробной части
+     * @return Точность
+     */
+    [[nodiscard]] TimestampPrecision getPrecision() const;
+
+    /**
+     * @brief Возвращает длину метки для заданной точности
+     * @param precision Точность
+     * @return Количество символов
+     */
+    [[nodiscard]] static constexpr size_t lengthFor(TimestampPrecision precision) {
+        switch (precision) {
+            case TimestampPrecision::MILLISECONDS:
+                return PREFIX_LENGTH + 4;
+            case TimestampPrecision::MICROSECONDS:
+                return PREFIX_LENGTH + 7;
+            default:
+                return PREFIX_LENGTH;
+        }
+    }
+
+private:
+    /**
+     * @brief Пересчитывает кэшированный префикс для новой секунды
+     * @param seconds Секунды с начала эпохи
+     */
+    void updatePrefix(int64_t seconds);
+
+    TimestampPrecision _precision;                      // Точность дробной части
+    int64_t _cachedSecond;                              // Секунда, для которой построен префикс
+    char _prefix[PREFIX_LENGTH];                        // Кэшированный префикс "YYYY-MM-DD HH:MM:SS"
+};